@@ -0,0 +1,77 @@
+# SPDX-License-Identifier: MIT
+#
+# Generate a C source containing the rootfs public key in pre-parsed form
+#
+# cominit_generate_rootfs_key(<pem> <output>)
+#
+# Reads the RSA public key in PEM format from <pem> and configures rootfskey.c.in to <output>. The generated source
+# holds the raw big-endian modulus and public exponent of the key as well as the SHA-256 digest of its DER encoding,
+# so cominit neither needs to read nor to parse a keyfile at boot. Requires the openssl command line tool on the build
+# host. CMake is re-run automatically if <pem> changes.
+
+function(cominit_generate_rootfs_key PEM OUTPUT)
+  find_program(OPENSSL_EXECUTABLE NAMES openssl)
+  if(NOT OPENSSL_EXECUTABLE)
+    message(FATAL_ERROR "The openssl command line tool is needed to embed the rootfs public key.")
+  endif()
+
+  if(NOT EXISTS "${PEM}")
+    message(FATAL_ERROR "Rootfs public key '${PEM}' does not exist.")
+  endif()
+  set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS "${PEM}")
+
+  execute_process(
+    COMMAND "${OPENSSL_EXECUTABLE}" rsa -pubin -in "${PEM}" -noout -text
+    RESULT_VARIABLE exit_code
+    OUTPUT_VARIABLE key_text
+    ERROR_VARIABLE key_error
+  )
+  if(NOT exit_code EQUAL 0)
+    message(FATAL_ERROR "Could not read RSA public key from '${PEM}': ${key_error}")
+  endif()
+
+  execute_process(
+    COMMAND "${OPENSSL_EXECUTABLE}" rsa -pubin -in "${PEM}" -noout -modulus
+    RESULT_VARIABLE exit_code
+    OUTPUT_VARIABLE modulus
+    OUTPUT_STRIP_TRAILING_WHITESPACE
+  )
+  if(NOT exit_code EQUAL 0 OR NOT modulus MATCHES "^Modulus=([0-9A-Fa-f]+)$")
+    message(FATAL_ERROR "Could not extract modulus from '${PEM}'.")
+  endif()
+  set(modulus_hex "${CMAKE_MATCH_1}")
+
+  if(NOT key_text MATCHES "Exponent: [0-9]+ \\(0x([0-9A-Fa-f]+)\\)")
+    message(FATAL_ERROR "Could not extract public exponent from '${PEM}'.")
+  endif()
+  set(exponent_hex "${CMAKE_MATCH_1}")
+
+  set(der_file "${CMAKE_CURRENT_BINARY_DIR}/rootfs_key_pub.der")
+  execute_process(
+    COMMAND "${OPENSSL_EXECUTABLE}" pkey -pubin -in "${PEM}" -outform DER -out "${der_file}"
+    RESULT_VARIABLE exit_code
+  )
+  if(NOT exit_code EQUAL 0)
+    message(FATAL_ERROR "Could not convert '${PEM}' to DER.")
+  endif()
+  file(SHA256 "${der_file}" digest_hex)
+  file(REMOVE "${der_file}")
+
+  foreach(var modulus_hex exponent_hex digest_hex)
+    string(LENGTH "${${var}}" len)
+    math(EXPR odd "${len} % 2")
+    if(odd)
+      set(${var} "0${${var}}")
+    endif()
+    string(REGEX REPLACE "([0-9A-Fa-f][0-9A-Fa-f])" "0x\\1, " ${var} "${${var}}")
+    string(REGEX REPLACE ", $" "" ${var} "${${var}}")
+    string(TOLOWER "${${var}}" ${var})
+  endforeach()
+
+  set(COMINIT_ROOTFS_KEY_PEM "${PEM}")
+  set(COMINIT_ROOTFS_KEY_MODULUS "${modulus_hex}")
+  set(COMINIT_ROOTFS_KEY_EXPONENT "${exponent_hex}")
+  set(COMINIT_ROOTFS_KEY_DER_DIGEST "${digest_hex}")
+  configure_file("${PROJECT_SOURCE_DIR}/src/rootfskey.c.in" "${OUTPUT}" @ONLY)
+  message("embedding rootfs public key ${PEM}")
+endfunction()
@@ -8,6 +8,25 @@
 
 #include "meta.h"
 
+/**
+ * Structure holding a GUID in the mixed-endian binary form used on disk by GPT.
+ */
+typedef struct {
+    uint8_t bytes[16];  ///< The first three fields little-endian, the last two big-endian.
+} cominitGuid_t;
+
+/**
+ * Creates a cominitGuid_t at compile time from the five fields of the textual GUID form.
+ *
+ * The GUID `aaaaaaaa-bbbb-cccc-dddd-eeeeeeeeeeee` is written as
+ * `COMINIT_GUID(0xaaaaaaaa, 0xbbbb, 0xcccc, 0xdddd, 0xeeeeeeeeeeeeULL)`.
+ */
+#define COMINIT_GUID(a, b, c, d, e)                                                                                \
+    ((const cominitGuid_t){{(uint8_t)(a), (uint8_t)((a) >> 8), (uint8_t)((a) >> 16), (uint8_t)((a) >> 24),      \
+                            (uint8_t)(b), (uint8_t)((b) >> 8), (uint8_t)(c), (uint8_t)((c) >> 8),                \
+                            (uint8_t)((d) >> 8), (uint8_t)(d), (uint8_t)((e) >> 40), (uint8_t)((e) >> 32),       \
+                            (uint8_t)((e) >> 24), (uint8_t)((e) >> 16), (uint8_t)((e) >> 8), (uint8_t)(e)}})
+
 /**
  * Structure holding the GPT as defined by the UEFI specification.
  */
@@ -33,20 +52,67 @@ typedef struct {
  */
 typedef struct {
     char diskName[COMINIT_ROOTFS_DEV_PATH_MAX];  ///< Device node path of the whole disk
-    int blockSize;                               ///< Logical block size in bytes.
+    int blockSize;                               ///< Logical block size in bytes, 0 if not yet known.
+    uint64_t diskSize;                           ///< Size of the whole disk in bytes, 0 if not yet known.
     cominitGPTHeader_t hdr;                      ///< Parsed GPT header structure for this disk.
+    uint8_t *entries;                            ///< Cached partition entries array, NULL if not yet loaded.
 } cominitGPTDisk_t;
 
-#define COMINIT_ROOTFS_GUID_TYPE "b921b045-1df0-41c3-af44-4c6f280d3fae"          ///< THE GUID of the rootfs.
-#define COMINIT_SECURE_STORAGE_GUID_TYPE "CA7D7CCB-63ED-4C53-861C-1742536059CC"  ///< THE GUID of the secure storage.
+/** Number of UTF-16 code units of the partition name in a GPT partition entry. **/
+#define GPT_ENTRY_NAME_LENGTH 36
+/** Size (in Bytes) of a buffer holding any GPT partition name as null-terminated UTF-8. **/
+#define GPT_ENTRY_LABEL_SIZE_MAX (GPT_ENTRY_NAME_LENGTH * 3 + 1)
+
+/**
+ * Structure holding a partition entry of the GPT as defined by the UEFI specification.
+ *
+ * Entries may be larger than this structure, see cominitGPTHeader_t::partitionEntrySize.
+ */
+typedef struct {
+    cominitGuid_t typeGuid;                   ///< Partition type GUID, all zero if the entry is unused.
+    cominitGuid_t uniqueGuid;                 ///< Unique partition GUID (PARTUUID).
+    uint64_t firstLba;                        ///< First LBA of the partition.
+    uint64_t lastLba;                         ///< Last LBA of the partition (inclusive).
+    uint64_t attributes;                      ///< Attribute flags.
+    uint8_t name[GPT_ENTRY_NAME_LENGTH * 2];  ///< Partition name (PARTLABEL) in UTF-16LE, null-padded.
+} __attribute__((packed)) cominitGPTEntry_t;
+
+/**
+ * Enumeration of the properties a partition can be identified by.
+ */
+typedef enum {
+    COMINIT_GPT_MATCH_TYPE = 0,   ///< The partition type GUID.
+    COMINIT_GPT_MATCH_PARTUUID,   ///< The unique partition GUID.
+    COMINIT_GPT_MATCH_PARTLABEL,  ///< The partition name.
+} cominitGPTMatchE_t;
+
+/**
+ * Structure describing one partition to look for with cominitAutomountFindPartitionsOnDisk().
+ */
+typedef struct {
+    cominitGPTMatchE_t match;   ///< The property the partition is identified by.
+    const cominitGuid_t *guid;  ///< The type or unique partition GUID to look for, depending on match.
+    const char *label;          ///< The UTF-8 partition name to look for if match is COMINIT_GPT_MATCH_PARTLABEL.
+    char *partitionName;        ///< Buffer that receives the device node of the partition.
+    size_t partitionNameSize;   ///< The size of the buffer.
+    bool found;                 ///< Set to true if a matching partition has been found.
+} cominitGPTLookup_t;
+
+/** THE GUID of the rootfs (b921b045-1df0-41c3-af44-4c6f280d3fae). **/
+#define COMINIT_ROOTFS_GUID_TYPE COMINIT_GUID(0xb921b045, 0x1df0, 0x41c3, 0xaf44, 0x4c6f280d3faeULL)
+/** THE GUID of the secure storage (CA7D7CCB-63ED-4C53-861C-1742536059CC). **/
+#define COMINIT_SECURE_STORAGE_GUID_TYPE COMINIT_GUID(0xca7d7ccb, 0x63ed, 0x4c53, 0x861c, 0x1742536059ccULL)
 #define GPT_HEADER_DEFAULT_ENTRY_SIZE \
     128  ///< The default entry size within a GPT header as defined in UEFI specification.
+#define GPT_ENTRIES_SIZE_MAX \
+    (1024 * 1024)  ///< Upper bound for the size of a partition entries array (the UEFI default is 16 KiB).
 /**
  * Find a partition of a given type GUID.
  *
  * This function searches for a partition whose type GUID matches @p guidType.
  *
- * All block devices under /dev are scanned until a matching partition is found.
+ * All whole disks listed in /sys/class/block are scanned until a matching partition is found. If sysfs is not
+ * available, the block device nodes under /dev are scanned instead.
  *
  * When a matching partition is found, the corresponding device node
  * is written to @p partitionName. In addition, @p gptDisk is updated to describe
@@ -54,6 +120,8 @@ typedef struct {
  * This allows cominitAutomountFindPartitionOnDisk() to be called with the same
  * @p gptDisk to search for additional partitions of other GUID types without
  *  re-scaning all block devices under /dev.
+ * The partition entries array of the disk is cached in @p gptDisk and needs to be
+ * released with cominitAutomountFreeDisk() once no longer needed.
  *
  * @param[out] gptDisk   Pointer to a cominitGPTDisk_t struct. On success, it will
  *                       contain the GPT disk where the partition was found.
@@ -63,13 +131,32 @@ typedef struct {
  *
  * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
  */
-int cominitAutomountFindPartition(cominitGPTDisk_t *gptDisk, const char *guidType, char *partitionName,
+int cominitAutomountFindPartition(cominitGPTDisk_t *gptDisk, const cominitGuid_t *guidType, char *partitionName,
                                   size_t partitionNameSize);
 
+/**
+ * Find a partition identified by any of the properties in cominitGPTMatchE_t.
+ *
+ * Scans the block devices like cominitAutomountFindPartition() but matches the partition entries against @p lookup.
+ * On success the device node of the partition is written to the buffer of @p lookup, its found flag is set and
+ * @p gptDisk is updated to describe the disk the partition resides on.
+ *
+ * @param[out] gptDisk      Pointer to a cominitGPTDisk_t struct. On success, it will contain the GPT disk where the
+ *                          partition was found.
+ * @param[in,out] lookup    The partition to look for.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitAutomountFindPartitionByLookup(cominitGPTDisk_t *gptDisk, cominitGPTLookup_t *lookup);
+
 /**
  * Tries to find the GUID type inside the GPT header on a given not empty disk @p gptDisk.
  * If found the partition device is copied to @p partitionName.
  *
+ * The partition entries array is read from disk with a single read on first use and cached in @p gptDisk, so
+ * subsequent lookups on the same disk do not access the device again. The cache needs to be released with
+ * cominitAutomountFreeDisk().
+ *
  * @param[in] gptDisk       Pointer to a cominitGPTDisk_t struct containing a valid disk with GPT header.
  * @param[in] guidType      The GUID type that should be looked for in the GPT header.
  * @param[out] partitionName    Pointer to a buffer that receives device node of the partition.
@@ -77,5 +164,81 @@ int cominitAutomountFindPartition(cominitGPTDisk_t *gptDisk, const char *guidTyp
  *
  * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
  */
-int cominitAutomountFindPartitionOnDisk(cominitGPTDisk_t *gptDisk, const char *guidType, char *partitionName,
+int cominitAutomountFindPartitionOnDisk(cominitGPTDisk_t *gptDisk, const cominitGuid_t *guidType, char *partitionName,
                                         size_t partitionNameSize);
+
+/**
+ * Looks for several partitions on a given not empty disk @p gptDisk in a single pass over its partition entries.
+ *
+ * For every element of @p lookups the device node of the first partition matching it is copied to its buffer and its
+ * found flag is set. Entries are read and cached as described for cominitAutomountFindPartitionOnDisk().
+ *
+ * @param[in] gptDisk       Pointer to a cominitGPTDisk_t struct containing a valid disk with GPT header.
+ * @param[in,out] lookups   Array of partitions to look for.
+ * @param[in] lookupCount   The number of elements in @p lookups.
+ *
+ * @return  EXIT_SUCCESS if all partitions have been found, EXIT_FAILURE otherwise
+ */
+int cominitAutomountFindPartitionsOnDisk(cominitGPTDisk_t *gptDisk, cominitGPTLookup_t *lookups, size_t lookupCount);
+
+/**
+ * Looks for a partition on a single given block device.
+ *
+ * Meant for disks known in advance, e.g. from cominitAutomountGetBootDisk(), so a scan of all block devices is not
+ * needed. On success the device node of the partition is written to the buffer of @p lookup and @p gptDisk is updated
+ * to describe @p device.
+ *
+ * @param[out] gptDisk      Pointer to a cominitGPTDisk_t struct. On success, it will contain the GPT of @p device.
+ * @param[in] device        The device node of the whole disk to probe.
+ * @param[in,out] lookup    The partition to look for.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitAutomountFindPartitionOnDevice(cominitGPTDisk_t *gptDisk, const char *device, cominitGPTLookup_t *lookup);
+
+/**
+ * Determines the disk the boot loader was started from.
+ *
+ * Boot loaders implementing the Boot Loader Interface (e.g. systemd-boot) store the unique partition GUID of the ESP
+ * they were loaded from in the LoaderDevicePartUUID EFI variable. The partition is looked up in sysfs to get its disk.
+ * Needs efivarfs mounted on /sys/firmware/efi/efivars.
+ *
+ * @param[out] device       Buffer that receives the device node of the whole disk.
+ * @param[in] deviceSize    The size of the buffer.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE if the boot disk is unknown
+ */
+int cominitAutomountGetBootDisk(char *device, size_t deviceSize);
+
+/**
+ * Parses a GUID in its textual form `aaaaaaaa-bbbb-cccc-dddd-eeeeeeeeeeee` (case-insensitive).
+ *
+ * @param[out] guid     Pointer that receives the GUID in the binary form used on disk.
+ * @param[in] str       The null-terminated string to parse.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitAutomountParseGuid(cominitGuid_t *guid, const char *str);
+
+/**
+ * Parses a partition specification as used with `root=` on the Kernel command line.
+ *
+ * Supported are `PARTUUID=<unique partition GUID>` and `PARTLABEL=<partition name>`. For a partition name, the
+ * lookup points into @p spec, so it needs to stay valid as long as @p lookup is used.
+ *
+ * @param[out] lookup   Pointer to a cominitGPTLookup_t struct whose match, guid and label are set up.
+ * @param[out] guid     Pointer that receives the unique partition GUID, lookup->guid points to it.
+ * @param[in] spec      The specification to parse.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE if @p spec is not a valid partition specification
+ */
+int cominitAutomountParsePartitionSpec(cominitGPTLookup_t *lookup, cominitGuid_t *guid, const char *spec);
+
+/**
+ * Releases the partition entries cached in @p gptDisk.
+ *
+ * Safe to call on a disk without cached entries or multiple times.
+ *
+ * @param[in,out] gptDisk   Pointer to a cominitGPTDisk_t struct, may be NULL.
+ */
+void cominitAutomountFreeDisk(cominitGPTDisk_t *gptDisk);
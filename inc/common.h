@@ -7,6 +7,9 @@
 #define __COMMON_H__
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
 
 #ifdef COMINIT_USE_TPM
 #include <tss2/tss2_esys.h>
@@ -25,10 +28,17 @@ typedef struct cominitCliArgs {
     unsigned long pcrSeal[TPM2_PT_PCR_COUNT];        ///< The list of registers in the SHA-256 bank used for sealing.
     char devNodeBlob[COMINIT_ROOTFS_DEV_PATH_MAX];   ///< Holds the blob device node.
     char devNodeCrypt[COMINIT_ROOTFS_DEV_PATH_MAX];  ///< Holds the crypt device node.
+    char tcti[COMINIT_ROOTFS_DEV_PATH_MAX];          ///< Holds the TCTI configuration, empty for the default.
 #endif
     bool enableSelinux;                               ///< Flag to check whether selinux is enabled.
     bool enableEnforceMode;                           ///< Flag to set selinux enforce mode.
+    bool verityCheck;                                 ///< Flag to pre-check the dm-verity hash tree before mounting.
+    unsigned long verityCheckLevels;                  ///< Number of hash tree levels the pre-check fully verifies.
     char devNodeRootFs[COMINIT_ROOTFS_DEV_PATH_MAX];  ///< Holds the Rootfs device node.
+    char rootPartSpec[COMINIT_ROOTFS_DEV_PATH_MAX];   ///< Holds a PARTUUID= or PARTLABEL= spec of the Rootfs.
+    char devNodeDisk[COMINIT_ROOTFS_DEV_PATH_MAX];    ///< Holds the device node of the disk to look at first.
+    unsigned long rootWaitMillis;                     ///< Maximum time in milliseconds to wait for the rootfs.
+    unsigned long rootDelayMillis;                    ///< Maximum interval in milliseconds between tries.
     cominitLogLevelE_t visibleLogLevel;               ///< The visible log level.
 } cominitCliArgs_t;
 
@@ -66,4 +76,48 @@ typedef struct cominitCliArgs {
  */
 int cominitCommonGetPartSize(uint64_t *partSize, int fd);
 
+/**
+ * Convert a series of Bytes to a hexadecimal string representation.
+ *
+ * Will read \a n Bytes from src and write \f$ 2n+1 \f$ (including the null-Byte) characters to dest. Hexadecimal digits
+ * `[a-f]` will be written in lower-case. Uses a lookup table instead of stdio, so it is suitable for key material.
+ *
+ * @param dest  The output string, needs to have space for at least \f$ 2n+1 \f$ characters.
+ * @param src   The array of bytes to convert.
+ * @param n     The amount of Bytes in src to convert.
+ *
+ * @return  0 on success, -1 otherwise
+ */
+int cominitCommonBytesToHex(char *dest, const uint8_t *src, size_t n);
+
+/**
+ * Convert a hexadecimal string representation to a series of Bytes.
+ *
+ * Upper- and lower-case digits are accepted. The string does not need to be null-terminated.
+ *
+ * @param dest     The output buffer.
+ * @param destLen  The size of \a dest in Bytes.
+ * @param hex      The hexadecimal string.
+ * @param hexLen   The amount of characters in \a hex to convert, must be even.
+ *
+ * @return  The amount of Bytes written to \a dest on success, -1 if \a hex contains a non-hexadecimal character, has
+ *          an odd length or does not fit into \a dest
+ */
+ssize_t cominitCommonHexToBytes(uint8_t *dest, size_t destLen, const char *hex, size_t hexLen);
+
+/**
+ * Parse the options for waiting for the rootfs from an argument of argv.
+ *
+ * Handles `cominit.rootwait=<ms>` setting cominitCliArgs_t::rootWaitMillis and `cominit.rootdelay=<ms>` setting
+ * cominitCliArgs_t::rootDelayMillis, which must not be 0. The Kernel's own `rootwait` and `rootdelay` parameters are
+ * deliberately not accepted as they are never passed on to init and have different units.
+ *
+ * @param argCtx  The structure that receives the parsed option.
+ * @param arg     An element of the argument vector.
+ *
+ * @return  1 if \a arg has been parsed, 0 if \a arg is none of the options, -1 if its value is invalid, in which case
+ *          \a argCtx is left unchanged
+ */
+int cominitCommonParseRootWaitArg(cominitCliArgs_t *argCtx, const char *arg);
+
 #endif /* __COMMON_H__ */
@@ -0,0 +1,26 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file crc32.h
+ * @brief Header related to computing CRC32 checksums.
+ */
+#ifndef __CRC32_H__
+#define __CRC32_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Computes the CRC32 (ISO-HDLC, as used by GPT, zlib and Ethernet) of a buffer.
+ *
+ * The checksum can be computed over several buffers by passing the result of the previous call as @p crc. Uses the
+ * CRC32 instructions on ARMv8 if available at compile time and a slicing-by-8 table lookup otherwise.
+ *
+ * @param crc   The CRC32 of the preceding data, 0 for the first buffer.
+ * @param buf   The data to compute the checksum over.
+ * @param len   The size of @p buf in Bytes.
+ *
+ * @return  The CRC32 of all data passed so far
+ */
+uint32_t cominitCrc32(uint32_t crc, const void *buf, size_t len);
+
+#endif /* __CRC32_H__ */
@@ -14,16 +14,84 @@
 #define SHA256_LEN 32  ///< size of SHA256 digest.
 
 /**
- * Verify data according to a signature and a public key.
+ * Name to pass instead of a keyfile to use the public key compiled in via `-DROOTFS_KEY_EMBED=<pem>`.
+ *
+ * The built-in key is set up from its raw RSA parameters without any filesystem access and comes with a precomputed
+ * DER digest. If cominit has been built without an embedded key, operations on this name fail.
+ */
+#define COMINIT_CRYPTO_EMBEDDED_KEY "embedded:rootfs_key_pub"
+
+/** Maximum size (in Bytes) of a DER encoded ECDSA P-256 signature. **/
+#define COMINIT_CRYPTO_ECDSA_P256_SIG_MAX 72
+
+/**
+ * Signature algorithms supported by cominitCryptoVerifySignatureAlg(). All of them use SHA-256 as hash function.
+ */
+typedef enum {
+    COMINIT_CRYPTO_SIGALG_RSA_PSS = 0,  ///< RSASSA-PSS, the signature is as long as the RSA key.
+    COMINIT_CRYPTO_SIGALG_ECDSA_P256,   ///< ECDSA on curve P-256 (secp256r1), the signature is DER encoded.
+} cominitCryptoSigAlgE_t;
+
+/**
+ * Verify data according to a signature and a public key using the given signature algorithm.
  *
  * Uses libmbedcrypto to load the public key from a PEM file, compute the sha256 value of \a data, and verify with
- * \a signature using the RSASSA-PSS algorithm. The signature has to have been generated using sha256+RSASSA-PSS as
- * well.
+ * \a signature. The type of the key must match \a sigAlg. The parsed key is cached, see cominitCryptoReleaseKey().
+ *
+ * @param data       The data to verify.
+ * @param dataLen    The amount of Bytes in \a data.
+ * @param signature  Signature of \a data made using the private part of \a keyfile.
+ * @param sigLen     The amount of Bytes available in \a signature. Bytes behind the end of a DER encoded ECDSA
+ *                   signature or behind the key length for RSASSA-PSS are ignored.
+ * @param sigAlg     The signature algorithm used to create \a signature.
+ * @param keyfile    The path to the public key PEM-file or #COMINIT_CRYPTO_EMBEDDED_KEY.
+ *
+ * @return  0 on verification success, -1 otherwise
+ */
+int cominitCryptoVerifySignatureAlg(const uint8_t *data, size_t dataLen, const uint8_t *signature, size_t sigLen,
+                                    cominitCryptoSigAlgE_t sigAlg, const char *keyfile);
+
+/**
+ * Verify a SHA-256 digest according to a signature and a public key using the given signature algorithm.
+ *
+ * Same as cominitCryptoVerifySignatureAlg() but with the digest of the signed data already computed, e.g. by
+ * cominitCryptoComputeSHA256() on another thread.
+ *
+ * @param dataHash   The SHA-256 digest of the signed data, #SHA256_LEN Bytes.
+ * @param signature  Signature of the data made using the private part of \a keyfile.
+ * @param sigLen     The amount of Bytes available in \a signature, see cominitCryptoVerifySignatureAlg().
+ * @param sigAlg     The signature algorithm used to create \a signature.
+ * @param keyfile    The path to the public key PEM-file or #COMINIT_CRYPTO_EMBEDDED_KEY.
+ *
+ * @return  0 on verification success, -1 otherwise
+ */
+int cominitCryptoVerifyDigestAlg(const uint8_t *dataHash, const uint8_t *signature, size_t sigLen,
+                                 cominitCryptoSigAlgE_t sigAlg, const char *keyfile);
+
+/**
+ * Compute the SHA-256 digest of data.
+ *
+ * Uses cominitSha256() and thereby the SHA-256 instructions of the CPU if available. Unlike the signature verification
+ * functions, which share the cached key, this function may be called from several threads concurrently.
+ *
+ * @param data     The data to hash.
+ * @param dataLen  The amount of Bytes in \a data.
+ * @param digest   Buffer receiving the digest, must hold at least #SHA256_LEN Bytes.
+ *
+ * @return  0 on success, -1 otherwise
+ */
+int cominitCryptoComputeSHA256(const uint8_t *data, size_t dataLen, uint8_t *digest);
+
+/**
+ * Verify data according to a signature and a public key.
+ *
+ * Same as cominitCryptoVerifySignatureAlg() using #COMINIT_CRYPTO_SIGALG_RSA_PSS with a signature as long as the RSA
+ * key. The signature has to have been generated using sha256+RSASSA-PSS.
  *
  * @param data       The data to verify.
  * @param dataLen   The amount of Bytes in \a data.
  * @param signature  sha256/RSASSA-PSS signature of \a data made using \a keyfile.
- * @param keyfile    The path to the public key PEM-file.
+ * @param keyfile    The path to the public key PEM-file or #COMINIT_CRYPTO_EMBEDDED_KEY.
  *
  * @return  0 on verification success, -1 otherwise
  */
@@ -32,7 +100,10 @@ int cominitCryptoVerifySignature(const uint8_t *data, size_t dataLen, const uint
 /**
  * Create a digest by hashing (SHA-256) the public key from a PEM file.
  *
- * @param keyfile   The path to the public key PEM-file.
+ * Shares the parsed key with cominitCryptoVerifySignature(), so the key is only parsed once if both are used with the
+ * same file. The digest is cached as well.
+ *
+ * @param keyfile   The path to the public key PEM-file or #COMINIT_CRYPTO_EMBEDDED_KEY.
  * @param digest    Pointer to an allocated buffer capable of holding the bytes given by \a digestLen.
  * @param digestLen The length of the digest.
  *
@@ -40,6 +111,13 @@ int cominitCryptoVerifySignature(const uint8_t *data, size_t dataLen, const uint
  */
 int cominitCreateSHA256DigestfromKeyfile(const char *keyfile, unsigned char *digest, size_t digestLen);
 
+/**
+ * Release the public key cached by cominitCryptoVerifySignature() and cominitCreateSHA256DigestfromKeyfile().
+ *
+ * Should be called once the key is no longer needed. Calling it without a cached key is a no-op.
+ */
+void cominitCryptoReleaseKey(void);
+
 int cominitCryptoCreatePassphrase(unsigned char *passphrase, size_t passphraseSize);
 
 #endif /* __CRYPTO_H__ */
@@ -10,11 +10,29 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#ifdef COMINIT_ROOTFS_KEY_EMBEDDED
+#include "crypto.h"
+
+/** The public key to verify the rootfs partition metadata has been compiled in. **/
+#define COMINIT_ROOTFS_KEY_LOCATION COMINIT_CRYPTO_EMBEDDED_KEY
+#else
 /** The location of the public key to verify the rootfs partition metadata. **/
 #define COMINIT_ROOTFS_KEY_LOCATION "/etc/rootfs_key_pub.pem"
+#endif
 
 /** Version of the partition metadata. This is incremented if parsing changes.  **/
-#define COMINIT_PART_META_DATA_VERSION "1"
+#define COMINIT_PART_META_DATA_VERSION "2"
+/** Version of the partition metadata without signature algorithm field, always signed using RSASSA-PSS. **/
+#define COMINIT_PART_META_DATA_VERSION_V1 "1"
+/**
+ * Version of the binary partition metadata, stored in its first Byte. As the ASCII versions start with a digit, both
+ * formats can be told apart by the first Byte.
+ */
+#define COMINIT_PART_META_DATA_VERSION_BIN 3
+/** Signature algorithm field value for sha256/RSASSA-PSS signatures. **/
+#define COMINIT_PART_META_SIG_ALG_RSA_PSS "rsa-pss"
+/** Signature algorithm field value for DER encoded sha256/ECDSA signatures using curve P-256. **/
+#define COMINIT_PART_META_SIG_ALG_ECDSA_P256 "ecdsa-p256"
 
 /** Maximum size of the device mapper tables. **/
 #define COMINIT_DM_TABLE_SIZE_MAX 1024
@@ -23,11 +41,51 @@
 /** Maximum length of the filesystem type identifier. **/
 #define COMINIT_FSTYPE_STR_MAX_LEN 32
 
+/** Maximum number of partitions cominitLoadVerifyMetadataBatch() can handle in one call. **/
+#define COMINIT_META_BATCH_MAX 8
+
 /** Size (in Bytes) of the metadata region at the end of the rootfs patition. **/
 #define COMINIT_PART_META_DATA_SIZE 4096
-/** Size (in Bytes) of the signature within the metadata region **/
+/** Alignment (in Bytes) of the buffer the metadata region is read into, suitable for O_DIRECT on any block device. **/
+#define COMINIT_PART_META_DATA_ALIGN 4096
+/** Maximum size (in Bytes) of an RSASSA-PSS signature within the metadata region (RSA-4096). **/
 #define COMINIT_PART_META_SIG_LENGTH 512
 
+/** Size (in Bytes) of the binary metadata header: version, signature algorithm and length (le16) of the records. **/
+#define COMINIT_PART_META_BIN_HEADER_SIZE 4
+/** Size (in Bytes) of the header of a binary metadata record: type (le16) and length (le16) of the value. **/
+#define COMINIT_PART_META_BIN_RECORD_HEADER_SIZE 4
+/** Signature algorithm Byte of binary metadata for sha256/RSASSA-PSS signatures. **/
+#define COMINIT_PART_META_BIN_SIG_ALG_RSA_PSS 0
+/** Signature algorithm Byte of binary metadata for DER encoded sha256/ECDSA signatures using curve P-256. **/
+#define COMINIT_PART_META_BIN_SIG_ALG_ECDSA_P256 1
+/** Size (in Bytes) of the value of a #COMINIT_META_REC_VERITY_PARAMS record. **/
+#define COMINIT_PART_META_BIN_VERITY_PARAMS_SIZE 28
+/** Size (in Bytes) of the value of a #COMINIT_META_REC_INTEGRITY_PARAMS record. **/
+#define COMINIT_PART_META_BIN_INTEGRITY_PARAMS_SIZE 12
+
+/**
+ * Types of the records of binary metadata. All integers are little-endian, strings are not null-terminated.
+ */
+typedef enum {
+    COMINIT_META_REC_FSTYPE = 1,        ///< Filesystem type string.
+    COMINIT_META_REC_MODE,              ///< 1 Byte, 1 for read-only or 0 for read-write.
+    COMINIT_META_REC_CRYPT,             ///< 1 Byte, bitmask of #COMINIT_CRYPTOPT_VERITY etc.
+    COMINIT_META_REC_VERITY_PARAMS,     ///< u32 version, u32 data_block_size, u32 hash_block_size, u64 num_data_blocks,
+                                        ///< u64 hash_start_block.
+    COMINIT_META_REC_VERITY_ALG,        ///< dm-verity hash algorithm string.
+    COMINIT_META_REC_VERITY_DIGEST,     ///< dm-verity root digest, binary.
+    COMINIT_META_REC_VERITY_SALT,       ///< dm-verity salt, binary, optional.
+    COMINIT_META_REC_VERITY_OPT,        ///< Optional dm-verity argument string, may be repeated.
+    COMINIT_META_REC_INTEGRITY_PARAMS,  ///< u64 num_data_blocks, u32 data_block_size.
+    COMINIT_META_REC_INTEGRITY_OPT,     ///< Additional dm-integrity argument string, may be repeated.
+    COMINIT_META_REC_INTEGRITY_KEY,     ///< Additional dm-integrity argument using a key from the Kernel keyring,
+                                        ///< may be repeated: u8 option (0 `internal_hash`, 1 `journal_crypt`,
+                                        ///< 2 `journal_mac`), u8 length of the algorithm, algorithm string and key
+                                        ///< description string.
+    COMINIT_META_REC_COUNT              ///< Number of record types, not a valid type.
+} cominitMetaRecordE_t;
+
 /** Bitmask specifiying which dm-crypt/verity/integrity features to use, if any. **/
 typedef int8_t cominitCryptOpt_t;
 /** No dm-integrity/verity/crypt **/
@@ -59,6 +117,8 @@ typedef struct cominitRfsMetaData_t {
     char dmTableVerint[COMINIT_DM_TABLE_SIZE_MAX];  ///< Space to hold device mapper table for dm-verity or
                                                     ///< dm-integrity.
     char dmTableCrypt[COMINIT_DM_TABLE_SIZE_MAX];   ///< Space to hold device mapper table for dm-crypt
+    int deviceFd;                                   ///< Read-only file descriptor of the partition kept open by
+                                                    ///< cominitLoadVerifyMetadata() for later stages, -1 if closed.
 } cominitRfsMetaData_t;
 
 /**
@@ -66,26 +126,69 @@ typedef struct cominitRfsMetaData_t {
  *
  * Expects a valid metadata region at the end of partition \a meta->devicePath. For details on how this region must
  * look, see README.md (the doxygen main page). All other fields of \a meta will be filled according to the found
- * metadata if signature verification (using the RSASSA-PSS implementation of libmbedcrypto) succeeds.
+ * metadata if signature verification (using the RSASSA-PSS or ECDSA implementation of libmbedcrypto, as given by the
+ * metadata version and signature algorithm field) succeeds.
+ *
+ * The metadata region is read with a single pread() bypassing the page cache (O_DIRECT) if the device supports it. On
+ * success, the partition stays open as cominitRfsMetaData_t::deviceFd, so later stages can read from it without
+ * opening it again. It needs to be closed using cominitReleaseMetadata().
  *
  * @param meta      The metadata structure to fill. Field \a .devicePath needs to contain the rootfs device path.
- * @param keyfile   Path to the RSA public key for signature verification in PEM-format.
+ * @param keyfile   Path to the RSA or EC public key for signature verification in PEM-format.
  *
  * @return  0 on success, -1 otherwise
  */
 int cominitLoadVerifyMetadata(cominitRfsMetaData_t *meta, const char *keyfile);
 /**
- * Convert a series of Bytes to a hexadecimal string representation.
+ * Loads and verifies the metadata of several partitions.
+ *
+ * Same as cominitLoadVerifyMetadata() for each element of \a metas. The metadata regions are read and hashed on one
+ * thread per partition, so I/O on different devices overlaps. The signatures are then verified one after another
+ * using the same key. All partitions are processed even if one of them fails. The partitions stay open only if the
+ * metadata of all of them is valid.
+ *
+ * @param metas    Array of metadata structures to fill. Field \a .devicePath of each element needs to contain the
+ *                 device path of the partition.
+ * @param count    The number of elements in \a metas, at most #COMINIT_META_BATCH_MAX.
+ * @param keyfile  Path to the RSA or EC public key for signature verification in PEM-format.
+ *
+ * @return  0 if the metadata of all partitions has been verified and parsed, -1 otherwise
+ */
+int cominitLoadVerifyMetadataBatch(cominitRfsMetaData_t *metas, size_t count, const char *keyfile);
+/**
+ * Closes the partition kept open by cominitLoadVerifyMetadata() or cominitLoadVerifyMetadataBatch().
+ *
+ * Does nothing if cominitRfsMetaData_t::deviceFd is already closed.
+ *
+ * @param meta  The metadata structure filled by cominitLoadVerifyMetadata().
+ */
+void cominitReleaseMetadata(cominitRfsMetaData_t *meta);
+/**
+ * Parse a metadata string.
+ *
+ * Given a null-terminated metadata string formatted as defined in README.md, fill the fields of \a meta accordingly.
+ * The positions of all fields are recorded in a single pass and the string is neither copied nor modified, so it may
+ * point directly into the verified metadata buffer.
+ *
+ * @param meta     The metadata structure to fill.
+ * @param metaStr  The metadata string to parse.
+ *
+ * @return  0 on success, -1 otherwise
+ */
+int cominitParseMetadata(cominitRfsMetaData_t *meta, const char *metaStr);
+/**
+ * Parse binary metadata.
  *
- * Will read \a n Bytes from src and write \f$ 2n+1 \f$ (including the null-Byte) characters to dest. Hexadecimal digits
- * `[a-f]` wil be written in lower-case.
+ * Given the data block of binary metadata (version #COMINIT_PART_META_DATA_VERSION_BIN, see README.md), fill the fields
+ * of \a meta accordingly. The records are read in place, numbers are taken from fixed-width fields and no memory is
+ * allocated.
  *
- * @param dest  The output string, needs to have space for at least \f$ 2n+1 \f$ characters.
- * @param src   The array of bytes to convert.
- * @param n     The amount of Bytes in src t convert.
+ * @param meta  The metadata structure to fill.
+ * @param data  The data block starting with the binary metadata header.
+ * @param len   The size of the data block in Bytes, including the header.
  *
  * @return  0 on success, -1 otherwise
  */
-int cominitBytesToHex(char *dest, const uint8_t *src, size_t n);
+int cominitParseMetadataBin(cominitRfsMetaData_t *meta, const uint8_t *data, size_t len);
 
 #endif /* __META_H__ */
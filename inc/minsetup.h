@@ -14,8 +14,9 @@
  * Setup a minimal environment.
  *
  * Sets up a minimal environment to do what we need to do in initramfs. Currently this is limited to mounting a devtmpfs
- * on /dev but may include further steps in the future as needed. If a devtmpfs is already mounted to `/dev`, this will
- * do nothing.
+ * on /dev, procfs on /proc and sysfs on /sys but may include further steps in the future as needed. On EFI systems,
+ * efivarfs is mounted read-only on /sys/firmware/efi/efivars in addition, a failure to do so is not fatal. File systems
+ * that are already mounted are skipped.
  *
  * @return 0 on success, -1 on error
  */
@@ -34,7 +35,7 @@ int cominitSetupSysSelinuxfiles(void);
  * Cleanup initramfs environment.
  *
  * Meant to clean the environment (mounts, temporary files) before changing the root directory to rootfs and exec-ing
- * into rootfs init. For now, it will perform a 'lazy' unmount of /dev using MNT_DETACH.
+ * into rootfs init. For now, it will perform a 'lazy' unmount of /dev and /sys using MNT_DETACH.
  *
  * @return 0 on success, -1 on error
  */
@@ -71,4 +72,15 @@ int cominitSetupRootfs(cominitRfsMetaData_t *rfsMeta);
  */
 int cominitSwitchIntoRootfs(void);
 
+/**
+ * Mount a tmpfs on /run of the rootfs with the same options as systemd.
+ *
+ * Meant to be called after cominitSwitchIntoRootfs() so files handed over to rootfs init (like the timing report) can
+ * be written even if the rootfs is read-only. systemd keeps an already mounted /run including its size limits, so the
+ * files stay visible. Nothing is done if /run is already a mount point.
+ *
+ * @return 0 on success, -1 on error
+ */
+int cominitSetupRunfs(void);
+
 #endif /* __MINSETUP_H__ */
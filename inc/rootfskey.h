@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file rootfskey.h
+ * @brief Header declaring the built-in rootfs public key.
+ *
+ * The definitions are generated via CMake in rootfskey.c.in if cominit is configured with `-DROOTFS_KEY_EMBED=<pem>`.
+ */
+#ifndef __ROOTFSKEY_H__
+#define __ROOTFSKEY_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "crypto.h"
+
+/** Big-endian modulus N of the built-in RSA public key. **/
+extern const uint8_t cominitRootfsKeyModulus[];
+/** Size (in Bytes) of #cominitRootfsKeyModulus. **/
+extern const size_t cominitRootfsKeyModulusLen;
+/** Big-endian public exponent E of the built-in RSA public key. **/
+extern const uint8_t cominitRootfsKeyExponent[];
+/** Size (in Bytes) of #cominitRootfsKeyExponent. **/
+extern const size_t cominitRootfsKeyExponentLen;
+/** SHA-256 digest of the DER encoded built-in public key, as returned by cominitCreateSHA256DigestfromKeyfile(). **/
+extern const uint8_t cominitRootfsKeyDerDigest[SHA256_LEN];
+
+#endif /* __ROOTFSKEY_H__ */
@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file sha256.h
+ * @brief Header related to computing SHA-256 digests.
+ */
+#ifndef __SHA256_H__
+#define __SHA256_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** Size (in Bytes) of a SHA-256 digest. **/
+#define COMINIT_SHA256_DIGEST_LEN 32
+/** Size (in Bytes) of a SHA-256 input block. **/
+#define COMINIT_SHA256_BLOCK_SIZE 64
+
+/**
+ * Structure holding the state of an incremental SHA-256 computation.
+ */
+typedef struct {
+    uint32_t state[8];                          ///< The intermediate hash value.
+    uint64_t length;                            ///< The amount of Bytes hashed so far.
+    uint8_t buffer[COMINIT_SHA256_BLOCK_SIZE];  ///< Input not yet forming a complete block.
+    size_t bufferLen;                           ///< The amount of Bytes in buffer.
+} cominitSha256Context_t;
+
+/**
+ * Starts an incremental SHA-256 computation.
+ *
+ * On first use, the fastest implementation supported by the CPU is selected: the SHA-256 instructions of x86 (SHA-NI,
+ * detected via cpuid) or ARMv8 (Cryptographic Extension, detected via getauxval(), only if the target architecture
+ * enables them at compile time) or a portable C implementation. All functions may be called concurrently from
+ * several threads on different contexts.
+ *
+ * @param ctx  The context to initialize.
+ */
+void cominitSha256Init(cominitSha256Context_t *ctx);
+
+/**
+ * Adds data to an incremental SHA-256 computation.
+ *
+ * @param ctx   The context started with cominitSha256Init().
+ * @param data  The data to hash.
+ * @param len   The size of @p data in Bytes.
+ */
+void cominitSha256Update(cominitSha256Context_t *ctx, const void *data, size_t len);
+
+/**
+ * Finishes an incremental SHA-256 computation.
+ *
+ * @param ctx     The context started with cominitSha256Init(). Needs to be initialized again to be reused.
+ * @param digest  Buffer receiving the digest, must hold #COMINIT_SHA256_DIGEST_LEN Bytes.
+ */
+void cominitSha256Final(cominitSha256Context_t *ctx, uint8_t *digest);
+
+/**
+ * Computes the SHA-256 digest of a buffer in one go.
+ *
+ * @param data    The data to hash.
+ * @param len     The size of @p data in Bytes.
+ * @param digest  Buffer receiving the digest, must hold #COMINIT_SHA256_DIGEST_LEN Bytes.
+ */
+void cominitSha256(const void *data, size_t len, uint8_t *digest);
+
+/**
+ * Gets the name of the SHA-256 implementation in use.
+ *
+ * @return  "x86-sha-ni", "armv8-ce" or "portable"
+ */
+const char *cominitSha256GetBackend(void);
+
+#endif /* __SHA256_H__ */
@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file timing.h
+ * @brief Header related to measuring the duration of the boot phases of cominit.
+ */
+#ifndef __TIMING_H__
+#define __TIMING_H__
+
+/** Path (below the rootfs) the timing report is written to before exec-ing into rootfs init. **/
+#define COMINIT_TIMING_REPORT_PATH "/run/cominit/timing.json"
+
+/**
+ * The phases of cominit that are timed.
+ */
+typedef enum {
+    COMINIT_TIMING_SETUP_SYSFILES = 0,  ///< Mounting /dev, /proc and /sys.
+    COMINIT_TIMING_DISCOVER_ROOTFS,     ///< Finding the rootfs partition including waiting for it to appear.
+    COMINIT_TIMING_VERIFY_METADATA,     ///< Loading and verifying the rootfs metadata.
+    COMINIT_TIMING_VERITY_CHECK,        ///< Pre-checking the dm-verity hash tree, if enabled.
+    COMINIT_TIMING_TPM_INIT,            ///< Initializing and self-testing the TPM, runs in the background.
+    COMINIT_TIMING_TPM_SELFTEST,        ///< Self-testing the TPM, part of #COMINIT_TIMING_TPM_INIT.
+    COMINIT_TIMING_TPM,                 ///< Setting up the TPM and the secure storage.
+    COMINIT_TIMING_DM_SETUP,            ///< Setting up the device mapper target of the rootfs.
+    COMINIT_TIMING_MOUNT_ROOTFS,        ///< Mounting the rootfs at /newroot.
+    COMINIT_TIMING_LOAD_SELINUX,        ///< Loading the SELinux policies.
+    COMINIT_TIMING_CLEANUP_SYSFILES,    ///< Unmounting /dev, /sys and selinuxfs.
+    COMINIT_TIMING_CLEANUP_INITRAMFS,   ///< Deleting the contents of the initramfs.
+    COMINIT_TIMING_SWITCH_ROOT,         ///< Moving the rootfs mount to / and changing root into it.
+    COMINIT_TIMING_PHASE_COUNT          ///< Number of phases, not a phase itself.
+} cominitTimingPhaseE_t;
+
+/**
+ * Values recorded alongside the phases to put their duration into context.
+ */
+typedef enum {
+    COMINIT_TIMING_ROOT_WAIT = 0,  ///< The deadline for finding the rootfs in milliseconds.
+    COMINIT_TIMING_ROOT_DELAY,     ///< The maximum interval between tries to find the rootfs in milliseconds.
+    COMINIT_TIMING_ROOT_TRIES,     ///< The number of tries needed to find the rootfs or until giving up.
+    COMINIT_TIMING_VALUE_COUNT     ///< Number of values, not a value itself.
+} cominitTimingValueE_t;
+
+/**
+ * Records the start of cominit.
+ *
+ * Should be called as early as possible, the time passed since the start of cominit is included in the report.
+ */
+void cominitTimingInit(void);
+
+/**
+ * Records the start of a phase.
+ *
+ * @param phase  The phase that starts.
+ */
+void cominitTimingStart(cominitTimingPhaseE_t phase);
+
+/**
+ * Records the end of a phase.
+ *
+ * Phases that have been started but not stopped, e.g. because of an error, are left out of the report.
+ *
+ * @param phase  The phase that ends.
+ */
+void cominitTimingStop(cominitTimingPhaseE_t phase);
+
+/**
+ * Records a value to be included in the report.
+ *
+ * Values that have not been set are left out of the report.
+ *
+ * @param value  The value to set.
+ * @param n      The number to record for @p value.
+ */
+void cominitTimingSetValue(cominitTimingValueE_t value, unsigned long n);
+
+/**
+ * Writes a summary of all timed phases as JSON.
+ *
+ * Timestamps are given in microseconds of CLOCK_BOOTTIME, i.e. relative to the start of the Kernel, so they can be
+ * related to the timestamps of the Kernel log and of the init system. The format is
+ *
+ * ```
+ * {"clock":"boottime","unit":"us","start":<us>,"end":<us>,
+ *  "phases":[{"name":"<phase>","start":<us>,"duration":<us>},...],
+ *  "values":{"<value>":<n>,...}}
+ * ```
+ *
+ * where `start` is the time cominitTimingInit() has been called and `end` the time of writing the report. `values`
+ * holds the numbers set with cominitTimingSetValue(). Missing parent directories of @p path are created.
+ *
+ * @param path  The file to write the report to.
+ *
+ * @return  0 on success, -1 otherwise
+ */
+int cominitTimingWriteReport(const char *path);
+
+#endif /* __TIMING_H__ */
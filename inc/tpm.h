@@ -7,15 +7,32 @@
 #define __TPM_H__
 
 #include <linux/dm-ioctl.h>
+#include <pthread.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <tss2/tss2_esys.h>
+#ifdef COMINIT_TPM_TCTI_DIRECT
+#include <tss2/tss2_tcti_device.h>
+#else
 #include <tss2/tss2_tctildr.h>
+#endif
 
 #include "common.h"
 
+#define COMINIT_TPM_DEVICE "/dev/tpm0"
+#define COMINIT_TPM_DEVICE_RM "/dev/tpmrm0"
+#define COMINIT_TPM_TCTI_DEVICE_PREFIX "device:"
+
 #define COMINIT_TPM_MNT_PT "/tpm"
 #define COMINIT_TPM_BLOB_LOCATION "sealed.blob"
 
+#define COMINIT_TPM_BLOB_MAGIC "CMNTBLOB"  ///< Magic at the start of a raw blob.
+#define COMINIT_TPM_BLOB_MAGIC_SIZE 8       ///< Size of #COMINIT_TPM_BLOB_MAGIC without the terminating NUL.
+#define COMINIT_TPM_BLOB_HEADER_SIZE 16     ///< Size of the raw blob header: magic, payload length and CRC32.
+#define COMINIT_TPM_BLOB_SIZE_MAX 4096      ///< Maximum size of a raw blob, read from the partition at once.
+#define COMINIT_TPM_EXT4_MAGIC_OFFSET 1080  ///< Offset of the magic of an ext4 superblock from the partition start.
+#define COMINIT_TPM_EXT4_MAGIC 0xEF53u      ///< Magic of an ext4 superblock.
+
 #define COMINIT_TPM_SECURE_STORAGE_NAME "secureStorage"
 #define COMINIT_TPM_SECURE_STORAGE_KEY_NAME COMINIT_TPM_SECURE_STORAGE_NAME
 #define COMINIT_TPM_SECURE_STORAGE_MNT "/newroot/mnt"
@@ -23,14 +40,31 @@
 
 #define POLICY_FAILURE_RC 0x0000099d  ///< return code on policy failure.
 
+#define COMINIT_TPM_SRK_HANDLE 0x81000001u         ///< Persistent handle of the SRK (TCG Provisioning Guidance).
+#define COMINIT_TPM_SRK_HANDLE_LEGACY 0x81000000u  ///< Persistent handle of the SRK of earlier cominit versions.
+
 /**
  * Structure holding Tpm Context that is acquired during RT.
  */
 typedef struct cominitTpmContext {
     ESYS_CONTEXT *esysCtx;       ///< The Pointer to the ESYS context handle returned by Esys_Initialize().
-    TSS2_TCTI_CONTEXT *tctiCtx;  ///< The Pointer to the TCTI context handle returned by Tss2_TctiLdr_Initialize().
+    TSS2_TCTI_CONTEXT *tctiCtx;  ///< The Pointer to the TCTI context handle, see cominitInitTpm().
 } cominitTpmContext_t;
 
+/**
+ * Structure holding the state of a TPM initialization running in the background.
+ *
+ * Needs to be zero-initialized before cominitTpmInitStart() is called.
+ */
+typedef struct cominitTpmInit {
+    cominitTpmContext_t tpmCtx;  ///< The TPM context, valid after cominitTpmInitJoin() returned EXIT_SUCCESS.
+    const char *tcti;            ///< The TCTI configuration passed to cominitInitTpm().
+    pthread_t thread;            ///< The worker thread running cominitInitTpm().
+    bool started;                ///< true if cominitTpmInitStart() has been called.
+    bool threadStarted;          ///< true if the worker thread has been started and not yet joined.
+    int result;                  ///< The return value of cominitInitTpm(), valid once it finished.
+} cominitTpmInit_t;
+
 /**
  * Result codes for a TPM seal/unseal operation.
  */
@@ -95,6 +129,21 @@ int cominitTpmParsePcrIndex(cominitCliArgs_t *argCtx, const char *argValue);
  */
 int cominitTpmParsePcrIndexes(cominitCliArgs_t *argCtx, const char *argValue);
 
+/**
+ * Parses the TCTI configuration from argv that overrides the default TPM device.
+ *
+ * The configuration uses the syntax of the TCTI loader, e.g. `device:/dev/tpm1` or `swtpm:host=localhost,port=2321`.
+ * If cominit is built with `TPM_TCTI_DIRECT`, only the device TCTI is available and a plain device node is accepted as
+ * well.
+ *
+ * Called by cominit if its uses TPM.
+ *
+ * @param argCtx   Pointer to the structure that receives the parsed options.
+ * @param argValue  The parsed value of the argument found in the provided argument vector.
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitTpmParseTcti(cominitCliArgs_t *argCtx, const char *argValue);
+
 /**
  * Releases shared run‑time resources that the TPM module
  * acquires during execution.
@@ -115,14 +164,65 @@ int cominitDeleteTpm(cominitTpmContext_t *tpmCtx);
  */
 int cominitTpmExtendPCR(cominitTpmContext_t *tpmCtx, const char *keyfile, unsigned long pcrIndex);
 
+/**
+ * Checks if a persistent storage root key (SRK) may be used to seal or unseal a key.
+ *
+ * The SRK needs to be a restricted decryption key of the given type that is fixed to the TPM and its parent, whose
+ * sensitive data has been generated by the TPM and that protects its children with AES-128-CFB.
+ *
+ * @param ectx      The Pointer to the initialized ESYS_CONTEXT handle.
+ * @param srkHandle The handle of the SRK as returned by Esys_TR_FromTPMPublic().
+ * @param type      The type the SRK needs to have, TPM2_ALG_ECC or TPM2_ALG_RSA.
+ * @return  EXIT_SUCCESS if the SRK may be used, EXIT_FAILURE otherwise
+ */
+int cominitTpmCheckSrk(ESYS_CONTEXT *ectx, ESYS_TR srkHandle, TPMI_ALG_PUBLIC type);
+
 /**
  * Acquires shared run‑time resources that the TPM module
  * needs during execution.
  *
+ * By default, the in-kernel resource manager #COMINIT_TPM_DEVICE_RM is used if present, #COMINIT_TPM_DEVICE otherwise.
+ * If cominit is built with `TPM_TCTI_DIRECT`, the device TCTI is initialized directly instead of through the dlopen()
+ * based TCTI loader.
+ *
  * @param tpmCtx   The TPM context.
+ * @param tcti     The TCTI configuration as parsed by cominitTpmParseTcti(), NULL or empty for the default.
  * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
  */
-int cominitInitTpm(cominitTpmContext_t *tpmCtx);
+int cominitInitTpm(cominitTpmContext_t *tpmCtx, const char *tcti);
+
+/**
+ * Starts cominitInitTpm() including the TPM self-test in a worker thread.
+ *
+ * The self-test of a discrete TPM may take hundreds of milliseconds, so it is run while cominit discovers and verifies
+ * the rootfs. If no thread can be created, cominitInitTpm() is run synchronously instead.
+ *
+ * @param init  The zero-initialized state of the initialization.
+ * @param tcti  The TCTI configuration passed to cominitInitTpm(), must stay valid until the initialization finished.
+ */
+void cominitTpmInitStart(cominitTpmInit_t *init, const char *tcti);
+
+/**
+ * Waits for a TPM initialization started by cominitTpmInitStart() to finish.
+ *
+ * If the initialization has not been started, cominitInitTpm() is run synchronously. If the attempt in the background
+ * did not succeed, e.g. because the TPM driver had not created its device node yet, cominitInitTpm() is retried
+ * synchronously once.
+ *
+ * @param init  The state of the initialization.
+ * @return  EXIT_SUCCESS if cominitTpmInit_t::tpmCtx is ready to use, EXIT_FAILURE otherwise
+ */
+int cominitTpmInitJoin(cominitTpmInit_t *init);
+
+/**
+ * Waits for a TPM initialization started by cominitTpmInitStart() to finish and releases the TPM context if the
+ * initialization succeeded.
+ *
+ * Does nothing if the initialization has not been started. A failed initialization is not retried.
+ *
+ * @param init  The state of the initialization.
+ */
+void cominitTpmInitRelease(cominitTpmInit_t *init);
 
 /**
  * Checks if option Extension of PCR is enabled.
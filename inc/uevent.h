@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file uevent.h
+ * @brief Header related to listening for Kernel uevents.
+ */
+#ifndef __UEVENT_H__
+#define __UEVENT_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/** Size (in Bytes) of the buffer a single uevent message is received into. **/
+#define COMINIT_UEVENT_MSG_SIZE_MAX 8192
+/** Size (in Bytes) of the socket receive buffer, large enough to hold the uevents of a coldplugged disk. **/
+#define COMINIT_UEVENT_RCVBUF_SIZE (256 * 1024)
+
+/**
+ * Opens a netlink socket subscribed to the uevents the Kernel broadcasts.
+ *
+ * Events emitted after this call are queued on the socket until read by cominitUeventWaitForBlockDevice(), so the
+ * socket should be opened before the first attempt to find a device to avoid missing its uevent.
+ *
+ * @return  The file descriptor of the socket on success, -1 otherwise
+ */
+int cominitUeventOpen(void);
+
+/**
+ * Closes a socket opened by cominitUeventOpen().
+ *
+ * @param fd  The file descriptor of the socket. A value of -1 is ignored.
+ */
+void cominitUeventClose(int fd);
+
+/**
+ * Waits until the Kernel announces a new block device or until the timeout expires.
+ *
+ * All uevents queued on the socket are consumed. Returns as soon as at least one of them announces the addition of a
+ * block device (whole disk or partition). If the socket buffer overflowed, events may have been lost and the function
+ * also returns 1 so the caller rescans the available devices.
+ *
+ * @param fd             The file descriptor returned by cominitUeventOpen().
+ * @param timeoutMillis  The maximum time to wait in milliseconds.
+ *
+ * @return  1 if a block device has been added, 0 on timeout, -1 on error
+ */
+int cominitUeventWaitForBlockDevice(int fd, unsigned long timeoutMillis);
+
+/**
+ * Checks if a raw Kernel uevent message announces the addition of a block device.
+ *
+ * A message consists of a `<action>@<devpath>` header followed by null-terminated `KEY=value` pairs. Messages sent by
+ * udev (starting with `libudev`) are ignored.
+ *
+ * @param msg  The message as received from the netlink socket.
+ * @param len  The length of \a msg in Bytes.
+ *
+ * @return  true if \a msg is an `add` event of the `block` subsystem, false otherwise
+ */
+bool cominitUeventIsBlockDeviceAdd(const char *msg, size_t len);
+
+#endif /* __UEVENT_H__ */
@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file verity.h
+ * @brief Header related to checking a dm-verity hash tree before setting up the device mapper.
+ */
+#ifndef __VERITY_H__
+#define __VERITY_H__
+
+#include "meta.h"
+
+/** Default number of hash tree levels (counted from the root) verified completely by cominitVerityPreCheck(). **/
+#define COMINIT_VERITY_CHECK_LEVELS_DEFAULT 2uL
+/** Size (in Bytes) of the area at the start of the filesystem holding its superblock, checked by the pre-check. **/
+#define COMINIT_VERITY_CHECK_SUPERBLOCK_AREA 4096uL
+
+/**
+ * Checks the dm-verity hash tree of the rootfs before the device mapper target is set up.
+ *
+ * Without this check, a corrupted image is only noticed when the filesystem is read after mounting, possibly late
+ * during userspace startup. The check reads the hash tree from cominitRfsMetaData_t::deviceFd (or opens
+ * \a meta->devicePath if it is closed) and uses the root digest and salt of the verified metadata to
+ *  - completely verify the upper \a levels levels of the hash tree, starting from the root, and
+ *  - verify the data blocks within the first #COMINIT_VERITY_CHECK_SUPERBLOCK_AREA Bytes of the filesystem (containing
+ *    the superblock of ext4 and squashfs) and the hash blocks on their paths up to the root.
+ *
+ * Only the `sha256` hash algorithm is supported, the check is skipped for other algorithms.
+ *
+ * @param meta    The metadata loaded by cominitLoadVerifyMetadata(). Must use #COMINIT_CRYPTOPT_VERITY, the device
+ *                mapper must not have been set up yet.
+ * @param levels  The number of hash tree levels to verify completely. Levels below are only verified on the paths of
+ *                the superblock blocks.
+ *
+ * @return  0 if the checked parts of the image match the root digest or the check was skipped, -1 otherwise
+ */
+int cominitVerityPreCheck(const cominitRfsMetaData_t *meta, unsigned long levels);
+
+#endif /* __VERITY_H__ */
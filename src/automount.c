@@ -9,21 +9,93 @@
 
 #include <ctype.h>
 #include <dirent.h>
-#include <endian.h>
 #include <fcntl.h>
 #include <inttypes.h>
+#include <limits.h>
 #include <linux/fs.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/ioctl.h>
 #include <sys/stat.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "common.h"
+#include "crc32.h"
 #include "meta.h"
 #include "output.h"
 
+/** Maximum number of block devices probed for a GPT in one scan. **/
+#define COMINIT_AUTOMOUNT_CANDIDATES_MAX 64
+/** Maximum number of threads probing block devices at once. **/
+#define COMINIT_AUTOMOUNT_PROBE_THREADS_MAX 8
+/** Maximum number of block devices probed at once, one per probe thread and one on the scanning thread. **/
+#define COMINIT_AUTOMOUNT_PROBE_BUSY_MAX (COMINIT_AUTOMOUNT_PROBE_THREADS_MAX + 1)
+/** Time (in milliseconds) after which a scan starts no further probes and leaves the ones running behind. **/
+#define COMINIT_AUTOMOUNT_PROBE_TIMEOUT_MILLIS 1000
+/** Sysfs directory listing all block devices (whole disks and partitions). **/
+#define COMINIT_AUTOMOUNT_SYSFS_BLOCK "/sys/class/block"
+/** EFI variable set by systemd-boot and compatible boot loaders holding the unique partition GUID of the ESP. **/
+#define COMINIT_AUTOMOUNT_EFIVAR_LOADER_PARTUUID \
+    "/sys/firmware/efi/efivars/LoaderDevicePartUUID-4a67b082-0a4c-41cf-b6c7-440b29bb8c4f"
+/** Length of a GUID in its textual form. **/
+#define COMINIT_AUTOMOUNT_GUID_STRING_LENGTH 36
+/** Unit (in Bytes) of the `size` attribute of a block device in sysfs, independent of its logical block size. **/
+#define COMINIT_AUTOMOUNT_SYSFS_SECTOR_SIZE 512uLL
+
+/**
+ * Structure describing a block device that is a candidate for holding a GPT.
+ */
+typedef struct {
+    char device[COMINIT_ROOTFS_DEV_PATH_MAX];  ///< Device node of the block device.
+    int blockSize;                             ///< Logical block size in bytes, 0 if unknown.
+    uint64_t size;                             ///< Size of the block device in bytes, 0 if unknown.
+} cominitAutomountCandidate_t;
+
+/**
+ * Result of reading a GPT header from disk.
+ */
+typedef enum {
+    COMINIT_AUTOMOUNT_HEADER_VALID = 0,  ///< A GPT header with matching checksum has been read.
+    COMINIT_AUTOMOUNT_HEADER_ABSENT,     ///< The device could not be read or holds no GPT signature.
+    COMINIT_AUTOMOUNT_HEADER_CORRUPT,    ///< A GPT signature has been found, but the header is damaged.
+} cominitAutomountHeaderE_t;
+
+/**
+ * Structure holding the state of a parallel scan shared between the scanning thread and its probe threads.
+ */
+typedef struct {
+    pthread_mutex_t lock;                             ///< Protects the members changed after the scan started.
+    pthread_cond_t done;                              ///< Signaled whenever a probe finishes.
+    size_t refs;                                      ///< Number of threads using the scan, the last one frees it.
+    struct timespec until;                            ///< No devices are probed after this time (CLOCK_MONOTONIC).
+    size_t count;                                     ///< Number of devices in candidates.
+    size_t next;                                      ///< Index of the next device to probe.
+    size_t running;                                   ///< Number of probes currently running.
+    bool stop;                                        ///< Set when no further devices shall be probed.
+    bool found;                                       ///< Set by the first probe that found the partition.
+    cominitGPTMatchE_t match;                         ///< The property the partition is identified by.
+    cominitGuid_t guid;                               ///< The type or unique partition GUID to look for.
+    char label[GPT_ENTRY_LABEL_SIZE_MAX];             ///< The partition name to look for.
+    cominitGPTDisk_t disk;                            ///< The disk the partition was found on.
+    char partitionName[COMINIT_ROOTFS_DEV_PATH_MAX];  ///< Device node of the partition found.
+    cominitAutomountCandidate_t candidates[COMINIT_AUTOMOUNT_CANDIDATES_MAX];  ///< Devices to probe.
+} cominitAutomountProbe_t;
+
+/**
+ * Structure holding the probe threads and the block devices being probed across all scans.
+ */
+typedef struct {
+    pthread_mutex_t lock;  ///< Protects threads and busy.
+    size_t threads;        ///< Number of probe threads alive, including the ones left behind by scans that timed out.
+    char busy[COMINIT_AUTOMOUNT_PROBE_BUSY_MAX][COMINIT_ROOTFS_DEV_PATH_MAX];  ///< Devices being probed, "" if unused.
+} cominitAutomountProbeState_t;
+
+/** The probe threads and the block devices being probed across all scans. **/
+static cominitAutomountProbeState_t cominitAutomountProbeState = {.lock = PTHREAD_MUTEX_INITIALIZER};
+
 /**
  * Gets the block size of a block device with ioctl().
  *
@@ -66,9 +138,166 @@ static bool cominitAutomountIsBlacklistedName(const char *name) {
     return false;
 }
 
+/**
+ * Reads the whole partition entries array of a disk with a single pread() and caches it in @p gptDisk.
+ *
+ * The array is only accepted if it matches the checksum in the GPT header.
+ *
+ * @param fd            The open file descriptor of the disk.
+ * @param gptDisk       The pointer to a cominitGPTDisk_t struct with a valid GPT header that receives the entries.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitAutomountLoadEntries(int fd, cominitGPTDisk_t *gptDisk) {
+    int result = EXIT_FAILURE;
+    cominitGPTHeader_t *hdr = &(gptDisk->hdr);
+    uint64_t diskSize = gptDisk->diskSize;
+
+    if (diskSize == 0 && cominitCommonGetPartSize(&diskSize, fd) == -1) {
+        cominitErrPrint("Could not get size of disk %s.", gptDisk->diskName);
+    } else if (diskSize == 0) {
+        cominitErrPrint("Disk %s is empty.", gptDisk->diskName);
+    } else if (hdr->partitionEntrySize < GPT_HEADER_DEFAULT_ENTRY_SIZE || hdr->partitionEntrySize > diskSize) {
+        cominitErrPrint("Entry size of gpt header invalid.");
+    } else if (gptDisk->blockSize <= 0) {
+        cominitErrPrint("Block size of disk %s invalid.", gptDisk->diskName);
+    } else if (hdr->partitionEntryCount == 0) {
+        cominitErrPrint("GPT header of disk %s describes no partition entries.", gptDisk->diskName);
+    } else {
+        uint64_t tableSize = (uint64_t)hdr->partitionEntryCount * hdr->partitionEntrySize;
+        uint64_t tableOffset = hdr->partitionEntriesLba * (uint64_t)gptDisk->blockSize;
+        if (tableSize > GPT_ENTRIES_SIZE_MAX || tableSize > diskSize ||
+            hdr->partitionEntriesLba > diskSize / (uint64_t)gptDisk->blockSize || tableOffset > diskSize - tableSize) {
+            cominitErrPrint("Partition entries array of disk %s out of bounds.", gptDisk->diskName);
+        } else {
+            uint8_t *entries = malloc(tableSize);
+            if (!entries) {
+                cominitErrnoPrint("Allocation of entry buffer failed");
+            } else {
+                ssize_t bytesRead = pread(fd, entries, tableSize, (off_t)tableOffset);
+                if (bytesRead != (ssize_t)tableSize) {
+                    cominitErrnoPrint("Could only read %zd bytes from partition entries array of %" PRIu64
+                                      " byte size.",
+                                      bytesRead, tableSize);
+                    free(entries);
+                } else if (cominitCrc32(0, entries, tableSize) != hdr->partitionEntriesCrc32) {
+                    cominitErrPrint("Checksum of partition entries array of disk %s does not match.",
+                                    gptDisk->diskName);
+                    free(entries);
+                } else {
+                    gptDisk->entries = entries;
+                    gptDisk->diskSize = diskSize;
+                    result = EXIT_SUCCESS;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Reads the GPT header at a given LBA and validates it.
+ *
+ * A header is valid if its CRC32 matches and it describes its own location. A header larger than
+ * cominitGPTHeader_t (allowed up to the block size) is checksummed including the additional Bytes.
+ *
+ * @param fd        The open file descriptor of the disk.
+ * @param gptDisk   The pointer to a cominitGPTDisk_t struct with a valid block size that receives the header.
+ * @param lba       The LBA to read the header from.
+ *
+ * @return  The result of the validation as described in cominitAutomountHeaderE_t
+ */
+static cominitAutomountHeaderE_t cominitAutomountReadHeader(int fd, cominitGPTDisk_t *gptDisk, uint64_t lba) {
+    cominitGPTHeader_t *hdr = &(gptDisk->hdr);
+    off_t offset = (off_t)(lba * (uint64_t)gptDisk->blockSize);
+
+    if (pread(fd, hdr, sizeof(*hdr), offset) != (ssize_t)sizeof(*hdr)) {
+        cominitErrnoPrint("Could not read from device %s.", gptDisk->diskName);
+        return COMINIT_AUTOMOUNT_HEADER_ABSENT;
+    }
+    if (memcmp(hdr->signature, "EFI PART", sizeof(hdr->signature)) != 0) {
+        return COMINIT_AUTOMOUNT_HEADER_ABSENT;
+    }
+    if (hdr->headerSize < sizeof(*hdr) || hdr->headerSize > (uint32_t)gptDisk->blockSize) {
+        cominitErrPrint("GPT header at LBA %" PRIu64 " of disk %s has an invalid size.", lba, gptDisk->diskName);
+        return COMINIT_AUTOMOUNT_HEADER_CORRUPT;
+    }
+
+    cominitGPTHeader_t unsealed = *hdr;
+    unsealed.headerCrc32 = 0;
+    uint32_t crc = cominitCrc32(0, &unsealed, sizeof(unsealed));
+    if (hdr->headerSize > sizeof(*hdr)) {
+        size_t extraSize = hdr->headerSize - sizeof(*hdr);
+        uint8_t *extra = malloc(extraSize);
+        if (extra == NULL) {
+            cominitErrnoPrint("Allocation of GPT header buffer failed");
+            return COMINIT_AUTOMOUNT_HEADER_ABSENT;
+        }
+        ssize_t bytesRead = pread(fd, extra, extraSize, offset + (off_t)sizeof(*hdr));
+        crc = cominitCrc32(crc, extra, extraSize);
+        free(extra);
+        if (bytesRead != (ssize_t)extraSize) {
+            cominitErrnoPrint("Could not read from device %s.", gptDisk->diskName);
+            return COMINIT_AUTOMOUNT_HEADER_ABSENT;
+        }
+    }
+    if (crc != hdr->headerCrc32) {
+        cominitErrPrint("Checksum of GPT header at LBA %" PRIu64 " of disk %s does not match.", lba,
+                        gptDisk->diskName);
+        return COMINIT_AUTOMOUNT_HEADER_CORRUPT;
+    }
+    if (hdr->currentLba != lba) {
+        cominitErrPrint("GPT header at LBA %" PRIu64 " of disk %s claims to be at LBA %" PRIu64 ".", lba,
+                        gptDisk->diskName, hdr->currentLba);
+        return COMINIT_AUTOMOUNT_HEADER_CORRUPT;
+    }
+
+    return COMINIT_AUTOMOUNT_HEADER_VALID;
+}
+
+/**
+ * Reads the backup GPT from the last LBA of a disk whose primary GPT is damaged.
+ *
+ * @param fd        The open file descriptor of the disk.
+ * @param gptDisk   The pointer to a cominitGPTDisk_t struct with a valid block size that receives the backup GPT.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitAutomountLoadBackupGpt(int fd, cominitGPTDisk_t *gptDisk) {
+    uint64_t diskSize = gptDisk->diskSize;
+
+    if (diskSize == 0 && cominitCommonGetPartSize(&diskSize, fd) == -1) {
+        cominitErrPrint("Could not get size of disk %s.", gptDisk->diskName);
+        return EXIT_FAILURE;
+    }
+    uint64_t blockCount = diskSize / (uint64_t)gptDisk->blockSize;
+    if (blockCount < 3) {
+        cominitErrPrint("Disk %s is too small to hold a backup GPT.", gptDisk->diskName);
+        return EXIT_FAILURE;
+    }
+    gptDisk->diskSize = diskSize;
+
+    if (cominitAutomountReadHeader(fd, gptDisk, blockCount - 1) != COMINIT_AUTOMOUNT_HEADER_VALID ||
+        cominitAutomountLoadEntries(fd, gptDisk) == EXIT_FAILURE) {
+        cominitErrPrint("No valid backup GPT found on disk %s.", gptDisk->diskName);
+        return EXIT_FAILURE;
+    }
+    cominitInfoPrint("Using backup GPT of disk %s.", gptDisk->diskName);
+
+    return EXIT_SUCCESS;
+}
+
 /**
  * Tries to find a valid GPT header on a given block device.
  *
+ * Header and partition entries array are validated against their CRC32. If the primary GPT is damaged, the backup GPT
+ * at the end of the disk is used instead. A disk without the GPT signature in its primary header is not considered
+ * to be partitioned with GPT, so leftovers of an old table at the end of a repartitioned disk are ignored.
+ *
+ * On success the partition entries array is cached in @p gptDisk as well, so the disk is only opened once. A block size
+ * already set in @p gptDisk (e.g. read from sysfs) is used as is instead of being queried from the device.
+ *
  * @param blockDevice   The block device to probe.
  * @param gptDisk       The pointer to a cominitGPTDisk_t struct that receives the disk information.
  *
@@ -81,20 +310,22 @@ static int cominitAutomountFindGpt(const char *blockDevice, cominitGPTDisk_t *gp
     if (fd < 0) {
         cominitErrnoPrint("could not open disk %s.", blockDevice);
     } else {
-        if (cominitAutomountGetBlockSize(fd, &gptDisk->blockSize) == EXIT_FAILURE) {
+        if (gptDisk->blockSize <= 0 && cominitAutomountGetBlockSize(fd, &gptDisk->blockSize) == EXIT_FAILURE) {
             cominitErrPrint("Could not get block size of disk %s.", blockDevice);
         } else {
             cominitDebugPrint("blockSize: %ld", gptDisk->blockSize);
-            cominitGPTHeader_t *hdr = &(gptDisk->hdr);
-            if (pread(fd, hdr, sizeof(*hdr), gptDisk->blockSize) != (ssize_t)sizeof(*hdr)) {
-                cominitErrnoPrint("Could not read from device %s.", blockDevice);
+            memcpy(gptDisk->diskName, blockDevice, sizeof(gptDisk->diskName));
+            cominitAutomountHeaderE_t primary = cominitAutomountReadHeader(fd, gptDisk, 1);
+            if (primary == COMINIT_AUTOMOUNT_HEADER_ABSENT) {
+                cominitDebugPrint("No GPT signature found in disk %s.", blockDevice);
             } else {
-                if (memcmp(hdr->signature, "EFI PART", sizeof(hdr->signature)) != 0) {
-                    cominitDebugPrint("No GPT signature found in disk %s.", blockDevice);
-                } else {
-                    cominitDebugPrint("Disk %s contains GPT signature.", blockDevice);
-                    memcpy(gptDisk->diskName, blockDevice, sizeof(gptDisk->diskName));
-                    result = EXIT_SUCCESS;
+                cominitDebugPrint("Disk %s contains GPT signature.", blockDevice);
+                if (primary == COMINIT_AUTOMOUNT_HEADER_VALID) {
+                    result = cominitAutomountLoadEntries(fd, gptDisk);
+                }
+                if (result == EXIT_FAILURE) {
+                    cominitErrPrint("Primary GPT of disk %s is damaged, trying backup GPT.", blockDevice);
+                    result = cominitAutomountLoadBackupGpt(fd, gptDisk);
                 }
             }
         }
@@ -104,23 +335,6 @@ static int cominitAutomountFindGpt(const char *blockDevice, cominitGPTDisk_t *gp
     return result;
 }
 
-/**
- * Reads the raw 16-byte GUID field and formats it into the
- * canonical text form
- *
- * @param[in] rawGuid   Pointer to a 16-byte buffer containing the raw GUID data.
- * @param[out] guid     Pointer to a buffer of at least 37 bytes, where the
- *                      resulting null-terminated string will be written.
- *
- */
-static void cominitAutomountFormatGuid(const uint8_t rawGuid[16], char guid[37]) {
-    uint32_t a = le32toh(*(const uint32_t *)(rawGuid + 0));
-    uint16_t b = le16toh(*(const uint16_t *)(rawGuid + 4));
-    uint16_t c = le16toh(*(const uint16_t *)(rawGuid + 6));
-    snprintf(guid, 37, "%08x-%04x-%04x-%02x%02x-%02x%02x%02x%02x%02x%02x", a, b, c, rawGuid[8], rawGuid[9], rawGuid[10],
-             rawGuid[11], rawGuid[12], rawGuid[13], rawGuid[14], rawGuid[15]);
-}
-
 /**
  * Builds the partition device node from index in the partition table.
  *
@@ -153,122 +367,873 @@ static int cominitAutomountBuildPartitionNode(const char *diskName, unsigned idx
 }
 
 /**
- * Tries to find the GUID type inside the GPT header on a given not empty disk @p gptDisk.
- * If found the partition device is copied to @p partitionName.
+ * Converts the UTF-16LE partition name of a GPT partition entry to UTF-8.
  *
- * @param[in] gptDisk       Pointer to a cominitGPTDisk_t struct containing a valid disk with GPT header.
- * @param[in] guidType      The GUID type that should be looked for in the GPT header.
- * @param[out] partitionName    Pointer to a buffer that receives device node of the partition.
- * @param[in] partitionNameSize The size of the buffer.
+ * Unpaired surrogates are replaced by U+FFFD.
  *
- * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ * @param entry     The partition entry.
+ * @param label     Buffer of #GPT_ENTRY_LABEL_SIZE_MAX Bytes that receives the null-terminated name.
  */
-int cominitAutomountFindPartitionOnDisk(cominitGPTDisk_t *gptDisk, const char *guidType, char *partitionName,
-                                        size_t partitionNameSize) {
-    int result = EXIT_FAILURE;
+static void cominitAutomountEntryLabel(const cominitGPTEntry_t *entry, char *label) {
+    size_t pos = 0;
 
-    if (gptDisk == NULL || gptDisk->diskName[0] == '\0' || guidType == NULL || partitionName == NULL ||
-        partitionNameSize == 0) {
+    for (size_t i = 0; i < GPT_ENTRY_NAME_LENGTH; i++) {
+        uint32_t c = entry->name[2 * i] | (uint32_t)entry->name[2 * i + 1] << 8;
+        if (c == 0) {
+            break;
+        }
+        if (c >= 0xd800 && c < 0xdc00 && i + 1 < GPT_ENTRY_NAME_LENGTH) {
+            uint32_t low = entry->name[2 * i + 2] | (uint32_t)entry->name[2 * i + 3] << 8;
+            if (low >= 0xdc00 && low < 0xe000) {
+                c = 0x10000 + ((c - 0xd800) << 10) + (low - 0xdc00);
+                i++;
+            }
+        }
+        if (c >= 0xd800 && c < 0xe000) {
+            c = 0xfffd;
+        }
+
+        if (c < 0x80) {
+            label[pos++] = (char)c;
+        } else if (c < 0x800) {
+            label[pos++] = (char)(0xc0 | c >> 6);
+            label[pos++] = (char)(0x80 | (c & 0x3f));
+        } else if (c < 0x10000) {
+            label[pos++] = (char)(0xe0 | c >> 12);
+            label[pos++] = (char)(0x80 | (c >> 6 & 0x3f));
+            label[pos++] = (char)(0x80 | (c & 0x3f));
+        } else {
+            label[pos++] = (char)(0xf0 | c >> 18);
+            label[pos++] = (char)(0x80 | (c >> 12 & 0x3f));
+            label[pos++] = (char)(0x80 | (c >> 6 & 0x3f));
+            label[pos++] = (char)(0x80 | (c & 0x3f));
+        }
+    }
+    label[pos] = '\0';
+}
+
+/**
+ * Checks whether a used partition entry matches a lookup.
+ *
+ * @param entry     The partition entry.
+ * @param label     The UTF-8 name of the partition entry, NULL if not needed by any lookup.
+ * @param lookup    The partition to look for.
+ *
+ * @return  true if the entry matches, false otherwise
+ */
+static bool cominitAutomountEntryMatches(const cominitGPTEntry_t *entry, const char *label,
+                                         const cominitGPTLookup_t *lookup) {
+    switch (lookup->match) {
+        case COMINIT_GPT_MATCH_TYPE:
+            return memcmp(entry->typeGuid.bytes, lookup->guid->bytes, sizeof(lookup->guid->bytes)) == 0;
+        case COMINIT_GPT_MATCH_PARTUUID:
+            return memcmp(entry->uniqueGuid.bytes, lookup->guid->bytes, sizeof(lookup->guid->bytes)) == 0;
+        case COMINIT_GPT_MATCH_PARTLABEL:
+            return label != NULL && strcmp(label, lookup->label) == 0;
+        default:
+            return false;
+    }
+}
+
+int cominitAutomountFindPartitionsOnDisk(cominitGPTDisk_t *gptDisk, cominitGPTLookup_t *lookups, size_t lookupCount) {
+    if (gptDisk == NULL || gptDisk->diskName[0] == '\0' || lookups == NULL || lookupCount == 0) {
         cominitErrPrint("Invalid parameters");
-    } else {
+        return EXIT_FAILURE;
+    }
+    bool needLabel = false;
+    for (size_t i = 0; i < lookupCount; i++) {
+        bool keyValid = (lookups[i].match == COMINIT_GPT_MATCH_PARTLABEL) ? lookups[i].label != NULL
+                                                                          : lookups[i].guid != NULL;
+        if (!keyValid || lookups[i].partitionName == NULL || lookups[i].partitionNameSize == 0) {
+            cominitErrPrint("Invalid parameters");
+            return EXIT_FAILURE;
+        }
+        needLabel |= (lookups[i].match == COMINIT_GPT_MATCH_PARTLABEL);
+        lookups[i].found = false;
+    }
+
+    if (gptDisk->entries == NULL) {
         int fd = open(gptDisk->diskName, O_RDONLY | O_CLOEXEC);
         if (fd < 0) {
             cominitErrnoPrint("Could not open disk %s.", gptDisk->diskName);
-        } else {
-            cominitGPTHeader_t *hdr = &(gptDisk->hdr);
-            uint64_t diskSize = 0;
-            if (cominitCommonGetPartSize(&diskSize, fd) == -1) {
-                cominitErrPrint("Could not get size of disk %s.", gptDisk->diskName);
-            } else {
-                uint32_t partitionEntrySize = hdr->partitionEntrySize;
-                if (partitionEntrySize < GPT_HEADER_DEFAULT_ENTRY_SIZE || partitionEntrySize > diskSize) {
-                    cominitErrPrint("Entry size of gpt header invalid.");
-                } else {
-                    uint8_t *entryBuffer = malloc(partitionEntrySize);
-                    if (!entryBuffer) {
-                        cominitErrnoPrint("Allocation of entry buffer failed");
-                    } else {
-                        char typeGuidString[37] = {0};
-                        for (uint32_t entryIndex = 0; entryIndex < hdr->partitionEntryCount; ++entryIndex) {
-                            uint64_t tableBaseBytes = hdr->partitionEntriesLba * (uint64_t)gptDisk->blockSize;
-                            uint64_t entryOffsetBytes = tableBaseBytes + (uint64_t)entryIndex * partitionEntrySize;
-                            if (entryOffsetBytes > diskSize || entryOffsetBytes > UINT64_MAX) {
-                                cominitErrPrint("Entry offset to large.");
-                                break;
-                            }
-                            off_t entryOffset = (off_t)entryOffsetBytes;
-                            ssize_t bytesRead = pread(fd, entryBuffer, partitionEntrySize, entryOffset);
-                            if (bytesRead != (ssize_t)partitionEntrySize) {
-                                cominitErrnoPrint("Could only read %zd bytes from partition entry of %zd byte size)",
-                                                  bytesRead, partitionEntrySize);
-                                break;
-                            }
-                            bool typeGuidAllZero = true;
-                            for (int b = 0; b < 16; ++b) {
-                                if (entryBuffer[b] != 0) {
-                                    typeGuidAllZero = false;
-                                    break;
-                                }
-                            }
-                            if (typeGuidAllZero) {
-                                continue;
-                            }
-                            cominitAutomountFormatGuid(entryBuffer, typeGuidString);
-                            if (strcasecmp(typeGuidString, guidType) == 0) {
-                                result = cominitAutomountBuildPartitionNode(gptDisk->diskName, entryIndex + 1,
-                                                                            partitionName, partitionNameSize);
-                                break;
-                            }
-                        }
-                        free(entryBuffer);
-                    }
-                }
+            return EXIT_FAILURE;
+        }
+        int loaded = cominitAutomountLoadEntries(fd, gptDisk);
+        close(fd);
+        if (loaded == EXIT_FAILURE) {
+            return EXIT_FAILURE;
+        }
+    }
+
+    static const cominitGuid_t unusedEntry = {{0}};
+    cominitGPTHeader_t *hdr = &(gptDisk->hdr);
+    char label[GPT_ENTRY_LABEL_SIZE_MAX];
+    size_t remaining = lookupCount;
+    for (uint32_t entryIndex = 0; entryIndex < hdr->partitionEntryCount && remaining > 0; ++entryIndex) {
+        const cominitGPTEntry_t *entry =
+            (const cominitGPTEntry_t *)(gptDisk->entries + (size_t)entryIndex * hdr->partitionEntrySize);
+        if (memcmp(entry->typeGuid.bytes, unusedEntry.bytes, sizeof(unusedEntry.bytes)) == 0) {
+            continue;
+        }
+        if (needLabel) {
+            cominitAutomountEntryLabel(entry, label);
+        }
+        for (size_t i = 0; i < lookupCount; i++) {
+            if (lookups[i].found || !cominitAutomountEntryMatches(entry, needLabel ? label : NULL, &lookups[i])) {
+                continue;
+            }
+            if (cominitAutomountBuildPartitionNode(gptDisk->diskName, entryIndex + 1, lookups[i].partitionName,
+                                                   lookups[i].partitionNameSize) == EXIT_SUCCESS) {
+                lookups[i].found = true;
+                remaining--;
             }
-            close(fd);
         }
     }
 
+    return (remaining == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int cominitAutomountFindPartitionOnDisk(cominitGPTDisk_t *gptDisk, const cominitGuid_t *guidType, char *partitionName,
+                                        size_t partitionNameSize) {
+    cominitGPTLookup_t lookup = {.match = COMINIT_GPT_MATCH_TYPE,
+                                 .guid = guidType,
+                                 .partitionName = partitionName,
+                                 .partitionNameSize = partitionNameSize,
+                                 .found = false};
+
+    return cominitAutomountFindPartitionsOnDisk(gptDisk, &lookup, 1);
+}
+
+/**
+ * Checks a single block device for a GPT containing the partition described by a lookup.
+ *
+ * @param candidate         The block device to probe.
+ * @param lookup            The partition to look for. Its buffer receives the device node of the partition.
+ * @param gptDisk           The pointer to a cominitGPTDisk_t struct that receives the disk information on success.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitAutomountProbeDevice(const cominitAutomountCandidate_t *candidate, cominitGPTLookup_t *lookup,
+                                       cominitGPTDisk_t *gptDisk) {
+    cominitGPTDisk_t diskToProbe = {.blockSize = candidate->blockSize, .diskSize = candidate->size};
+
+    if (cominitAutomountFindGpt(candidate->device, &diskToProbe) == EXIT_SUCCESS &&
+        cominitAutomountFindPartitionsOnDisk(&diskToProbe, lookup, 1) == EXIT_SUCCESS) {
+        memcpy(gptDisk, &diskToProbe, sizeof(*gptDisk));
+        return EXIT_SUCCESS;
+    }
+    cominitAutomountFreeDisk(&diskToProbe);
+
+    return EXIT_FAILURE;
+}
+
+/**
+ * Drops a reference to a parallel scan and frees the scan if it was the last one.
+ *
+ * @param probe     The scan to release.
+ */
+static void cominitAutomountProbeRelease(cominitAutomountProbe_t *probe) {
+    pthread_mutex_lock(&probe->lock);
+    bool last = (--probe->refs == 0);
+    pthread_mutex_unlock(&probe->lock);
+
+    if (last) {
+        pthread_cond_destroy(&probe->done);
+        pthread_mutex_destroy(&probe->lock);
+        cominitAutomountFreeDisk(&probe->disk);
+        free(probe);
+    }
+}
+
+/**
+ * Checks whether the time to probe devices of a parallel scan is up.
+ *
+ * @param probe     The scan to check.
+ *
+ * @return  true if no further devices shall be probed, false otherwise
+ */
+static bool cominitAutomountProbeExpired(const cominitAutomountProbe_t *probe) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (now.tv_sec > probe->until.tv_sec ||
+            (now.tv_sec == probe->until.tv_sec && now.tv_nsec >= probe->until.tv_nsec));
+}
+
+/**
+ * Marks a block device as being probed.
+ *
+ * @param device    The device node of the block device.
+ *
+ * @return  The slot of the device in cominitAutomountProbeState_t::busy, -1 if the device is still being probed by an
+ *          earlier scan that timed out or no slot is left
+ */
+static int cominitAutomountProbeClaim(const char *device) {
+    int slot = -1;
+
+    pthread_mutex_lock(&cominitAutomountProbeState.lock);
+    for (int i = 0; i < COMINIT_AUTOMOUNT_PROBE_BUSY_MAX; i++) {
+        if (strcmp(cominitAutomountProbeState.busy[i], device) == 0) {
+            slot = -1;
+            break;
+        }
+        if (slot < 0 && cominitAutomountProbeState.busy[i][0] == '\0') {
+            slot = i;
+        }
+    }
+    if (slot >= 0) {
+        memcpy(cominitAutomountProbeState.busy[slot], device, strlen(device) + 1);
+    }
+    pthread_mutex_unlock(&cominitAutomountProbeState.lock);
+
+    return slot;
+}
+
+/**
+ * Marks a block device claimed with cominitAutomountProbeClaim() as no longer being probed.
+ *
+ * @param slot  The slot returned by cominitAutomountProbeClaim().
+ */
+static void cominitAutomountProbeUnclaim(int slot) {
+    pthread_mutex_lock(&cominitAutomountProbeState.lock);
+    cominitAutomountProbeState.busy[slot][0] = '\0';
+    pthread_mutex_unlock(&cominitAutomountProbeState.lock);
+}
+
+/**
+ * Probes one device of a parallel scan and records the result.
+ *
+ * The device is opened and its GPT is read into memory owned by the probe, so a probe left behind by a scan that timed
+ * out only touches the state protected by cominitAutomountProbe_t::lock.
+ *
+ * @param probe     The scan the device belongs to.
+ * @param index     Index of the device to probe in cominitAutomountProbe_t::candidates.
+ */
+static void cominitAutomountProbeRun(cominitAutomountProbe_t *probe, size_t index) {
+    cominitGPTDisk_t disk = {0};
+    char partitionName[COMINIT_ROOTFS_DEV_PATH_MAX] = {0};
+    cominitGPTLookup_t lookup = {.match = probe->match,
+                                 .guid = &probe->guid,
+                                 .label = probe->label,
+                                 .partitionName = partitionName,
+                                 .partitionNameSize = sizeof(partitionName)};
+    int result = cominitAutomountProbeDevice(&probe->candidates[index], &lookup, &disk);
+
+    pthread_mutex_lock(&probe->lock);
+    probe->running--;
+    if (result == EXIT_SUCCESS && !probe->found && !probe->stop) {
+        probe->found = true;
+        memcpy(&probe->disk, &disk, sizeof(probe->disk));
+        memcpy(probe->partitionName, partitionName, sizeof(probe->partitionName));
+    } else {
+        cominitAutomountFreeDisk(&disk);
+    }
+    pthread_cond_signal(&probe->done);
+    pthread_mutex_unlock(&probe->lock);
+}
+
+/**
+ * Probes the devices of a parallel scan one after another until all have been probed, the partition has been found,
+ * the scan is stopped or its time is up. Devices still being probed by an earlier scan that timed out are skipped, so a
+ * hung device blocks at most one probe thread.
+ *
+ * @param probe     The scan to probe the devices of.
+ */
+static void cominitAutomountProbeLoop(cominitAutomountProbe_t *probe) {
+    pthread_mutex_lock(&probe->lock);
+    while (!probe->stop && !probe->found && probe->next < probe->count && !cominitAutomountProbeExpired(probe)) {
+        size_t index = probe->next++;
+        int slot = cominitAutomountProbeClaim(probe->candidates[index].device);
+        if (slot < 0) {
+            cominitInfoPrint("%s is still being probed, skipping it.", probe->candidates[index].device);
+            continue;
+        }
+        probe->running++;
+        pthread_mutex_unlock(&probe->lock);
+        cominitAutomountProbeRun(probe, index);
+        cominitAutomountProbeUnclaim(slot);
+        pthread_mutex_lock(&probe->lock);
+    }
+    pthread_mutex_unlock(&probe->lock);
+}
+
+/**
+ * Thread function of a detached probe thread running cominitAutomountProbeLoop().
+ *
+ * @param arg   Pointer to the cominitAutomountProbe_t of the scan. The thread holds a reference to it.
+ *
+ * @return  Always NULL
+ */
+static void *cominitAutomountProbeThread(void *arg) {
+    cominitAutomountProbe_t *probe = arg;
+
+    cominitAutomountProbeLoop(probe);
+
+    pthread_mutex_lock(&cominitAutomountProbeState.lock);
+    cominitAutomountProbeState.threads--;
+    pthread_mutex_unlock(&cominitAutomountProbeState.lock);
+    cominitAutomountProbeRelease(probe);
+
+    return NULL;
+}
+
+/**
+ * Starts detached probe threads for a parallel scan.
+ *
+ * At most #COMINIT_AUTOMOUNT_PROBE_THREADS_MAX probe threads are alive at once across all scans, so repeated scans do
+ * not pile up threads blocked on a hung device.
+ *
+ * @param probe         The scan to start the threads for.
+ * @param deviceCount   The number of devices to probe, no more threads than this are started.
+ *
+ * @return  The number of threads started
+ */
+static size_t cominitAutomountProbeStartThreads(cominitAutomountProbe_t *probe, size_t deviceCount) {
+    pthread_attr_t threadAttr;
+    size_t threadCount = 0;
+    size_t available = 0;
+
+    if (pthread_attr_init(&threadAttr) != 0) {
+        return 0;
+    }
+    if (pthread_attr_setdetachstate(&threadAttr, PTHREAD_CREATE_DETACHED) == 0) {
+        pthread_mutex_lock(&cominitAutomountProbeState.lock);
+        available = COMINIT_AUTOMOUNT_PROBE_THREADS_MAX - cominitAutomountProbeState.threads;
+        if (available > deviceCount) {
+            available = deviceCount;
+        }
+        cominitAutomountProbeState.threads += available;
+        pthread_mutex_unlock(&cominitAutomountProbeState.lock);
+
+        while (threadCount < available) {
+            pthread_t thread;
+            pthread_mutex_lock(&probe->lock);
+            probe->refs++;
+            pthread_mutex_unlock(&probe->lock);
+            if (pthread_create(&thread, &threadAttr, cominitAutomountProbeThread, probe) != 0) {
+                pthread_mutex_lock(&probe->lock);
+                probe->refs--;
+                pthread_mutex_unlock(&probe->lock);
+                cominitDebugPrint("Could not start probe thread, using %zu thread(s).", threadCount);
+                break;
+            }
+            threadCount++;
+        }
+
+        if (threadCount < available) {
+            pthread_mutex_lock(&cominitAutomountProbeState.lock);
+            cominitAutomountProbeState.threads -= available - threadCount;
+            pthread_mutex_unlock(&cominitAutomountProbeState.lock);
+        }
+    }
+    pthread_attr_destroy(&threadAttr);
+
+    return threadCount;
+}
+
+/**
+ * Probes several block devices concurrently on detached probe threads.
+ *
+ * Waits until the first device containing the partition has been found, all devices have been probed or
+ * #COMINIT_AUTOMOUNT_PROBE_TIMEOUT_MILLIS have passed. Probes still running then, e.g. blocked in a read from a hung
+ * or spinning-up device, are left behind: They own their file descriptor and GPT copy, discard their result and free
+ * the scan once the last of them returns. Later scans skip the devices they are still blocked on. If no probe thread
+ * can be started, the devices are probed on the calling thread until the time is up, which only bounds the time
+ * between two devices.
+ *
+ * @param probe             The scan with the partition to look for and cominitAutomountProbe_t::candidates set up.
+ *                          Ownership is passed to this function.
+ * @param deviceCount       The number of devices to probe.
+ * @param gptDisk           The pointer to a cominitGPTDisk_t struct that receives the disk information on success.
+ * @param partitionName     Pointer to a buffer that receives device node of the partition.
+ * @param partitionNameSize The size of the buffer.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitAutomountProbeParallel(cominitAutomountProbe_t *probe, size_t deviceCount, cominitGPTDisk_t *gptDisk,
+                                         char *partitionName, size_t partitionNameSize) {
+    int result = EXIT_FAILURE;
+    pthread_condattr_t condAttr;
+    size_t unfinished = 0;
+
+    if (pthread_condattr_init(&condAttr) != 0) {
+        cominitErrPrint("Could not set up condition for parallel disk scan.");
+        free(probe);
+        return EXIT_FAILURE;
+    }
+    if (pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC) != 0 ||
+        pthread_cond_init(&probe->done, &condAttr) != 0) {
+        cominitErrPrint("Could not set up condition for parallel disk scan.");
+        pthread_condattr_destroy(&condAttr);
+        free(probe);
+        return EXIT_FAILURE;
+    }
+    pthread_condattr_destroy(&condAttr);
+    pthread_mutex_init(&probe->lock, NULL);
+    probe->count = deviceCount;
+    probe->refs = 1;
+
+    clock_gettime(CLOCK_MONOTONIC, &probe->until);
+    probe->until.tv_sec += COMINIT_AUTOMOUNT_PROBE_TIMEOUT_MILLIS / 1000;
+    probe->until.tv_nsec += (COMINIT_AUTOMOUNT_PROBE_TIMEOUT_MILLIS % 1000) * 1000000L;
+    if (probe->until.tv_nsec >= 1000000000L) {
+        probe->until.tv_sec++;
+        probe->until.tv_nsec -= 1000000000L;
+    }
+
+    if (cominitAutomountProbeStartThreads(probe, deviceCount) == 0) {
+        cominitDebugPrint("No probe thread available, probing block devices on the scanning thread.");
+        cominitAutomountProbeLoop(probe);
+    }
+
+    pthread_mutex_lock(&probe->lock);
+    while (!probe->found && (probe->next < probe->count || probe->running > 0)) {
+        if (pthread_cond_timedwait(&probe->done, &probe->lock, &probe->until) != 0) {
+            break;
+        }
+    }
+    probe->stop = true;
+    if (probe->found) {
+        int n = snprintf(partitionName, partitionNameSize, "%s", probe->partitionName);
+        if (n < 0 || (size_t)n >= partitionNameSize) {
+            cominitErrPrint("buffer too small  %s.", probe->partitionName);
+        } else {
+            cominitAutomountFreeDisk(gptDisk);
+            memcpy(gptDisk, &probe->disk, sizeof(*gptDisk));
+            probe->disk.entries = NULL;
+            result = EXIT_SUCCESS;
+        }
+    } else {
+        unfinished = probe->count - probe->next + probe->running;
+    }
+    pthread_mutex_unlock(&probe->lock);
+
+    if (unfinished > 0) {
+        cominitInfoPrint("Probing %zu block device(s) timed out after %dms.", unfinished,
+                         COMINIT_AUTOMOUNT_PROBE_TIMEOUT_MILLIS);
+    }
+    cominitAutomountProbeRelease(probe);
+
     return result;
 }
 
-int cominitAutomountFindPartition(cominitGPTDisk_t *gptDisk, const char *guidType, char *partitionName,
-                                  size_t partitionNameSize) {
+/**
+ * Reads an unsigned decimal value from a sysfs attribute.
+ *
+ * @param path      The path of the attribute.
+ * @param value     Pointer that receives the value.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitAutomountReadSysfsValue(const char *path, uint64_t *value) {
+    int result = EXIT_FAILURE;
+    FILE *f = fopen(path, "re");
+
+    if (f != NULL) {
+        if (fscanf(f, "%" SCNu64, value) == 1) {
+            result = EXIT_SUCCESS;
+        }
+        fclose(f);
+    }
+
+    return result;
+}
+
+/**
+ * Builds the device node of a block device from its name in sysfs.
+ *
+ * Sysfs replaces the '/' of device nodes in subdirectories of /dev with '!', e.g. cciss!c0d0.
+ *
+ * @param name          The name of the block device in #COMINIT_AUTOMOUNT_SYSFS_BLOCK.
+ * @param device        Buffer that receives the device node.
+ * @param deviceSize    The size of the buffer.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE if the buffer is too small
+ */
+static int cominitAutomountSysfsDeviceNode(const char *name, char *device, size_t deviceSize) {
+    int n = snprintf(device, deviceSize, "/dev/%s", name);
+    if (n < 0 || (size_t)n >= deviceSize) {
+        return EXIT_FAILURE;
+    }
+    for (char *c = device; *c != '\0'; c++) {
+        if (*c == '!') *c = '/';
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Collects the whole disks listed in sysfs as candidates for a GPT scan.
+ *
+ * Partitions and disks without media are skipped. Size and logical block size are taken from sysfs if available, so
+ * the probes do not need to query them from the device.
+ *
+ * @param d             The open directory stream of #COMINIT_AUTOMOUNT_SYSFS_BLOCK.
+ * @param candidates    Array of #COMINIT_AUTOMOUNT_CANDIDATES_MAX elements that receives the candidates.
+ *
+ * @return  The number of candidates found, at most #COMINIT_AUTOMOUNT_CANDIDATES_MAX
+ */
+static size_t cominitAutomountListSysfsDisks(DIR *d, cominitAutomountCandidate_t *candidates) {
+    struct dirent *deviceEntry = NULL;
+    char path[2 * COMINIT_ROOTFS_DEV_PATH_MAX] = {0};
+    size_t count = 0;
+
+    while ((deviceEntry = readdir(d))) {
+        const char *name = deviceEntry->d_name;
+        cominitAutomountCandidate_t candidate = {0};
+        uint64_t value = 0;
+        if (name[0] == '.') continue;
+        if (cominitAutomountIsBlacklistedName(name)) continue;
+
+        int n = snprintf(path, sizeof(path), COMINIT_AUTOMOUNT_SYSFS_BLOCK "/%s/partition", name);
+        if (n < 0 || (size_t)n >= sizeof(path)) continue;
+        if (access(path, F_OK) == 0) continue;
+
+        if (cominitAutomountSysfsDeviceNode(name, candidate.device, sizeof(candidate.device)) == EXIT_FAILURE)
+            continue;
+
+        n = snprintf(path, sizeof(path), COMINIT_AUTOMOUNT_SYSFS_BLOCK "/%s/size", name);
+        if (n < 0 || (size_t)n >= sizeof(path)) continue;
+        if (cominitAutomountReadSysfsValue(path, &value) == EXIT_SUCCESS) {
+            if (value == 0) {
+                cominitDebugPrint("%s has no media, skipping.", candidate.device);
+                continue;
+            }
+            if (value <= UINT64_MAX / COMINIT_AUTOMOUNT_SYSFS_SECTOR_SIZE) {
+                candidate.size = value * COMINIT_AUTOMOUNT_SYSFS_SECTOR_SIZE;
+            }
+        }
+
+        n = snprintf(path, sizeof(path), COMINIT_AUTOMOUNT_SYSFS_BLOCK "/%s/queue/logical_block_size", name);
+        if (n < 0 || (size_t)n >= sizeof(path)) continue;
+        if (cominitAutomountReadSysfsValue(path, &value) == EXIT_SUCCESS && value > 0 && value <= INT_MAX) {
+            candidate.blockSize = (int)value;
+        }
+
+        if (count == COMINIT_AUTOMOUNT_CANDIDATES_MAX) {
+            cominitErrPrint("More than %d disks found, not scanning %s and any further disks.",
+                            COMINIT_AUTOMOUNT_CANDIDATES_MAX, candidate.device);
+            break;
+        }
+        candidates[count++] = candidate;
+    }
+
+    return count;
+}
+
+/**
+ * Collects the block device nodes in /dev as candidates for a GPT scan.
+ *
+ * Fallback for systems without sysfs mounted. Every entry needs an lstat() and partitions cannot be told apart from
+ * whole disks, so they are probed as well.
+ *
+ * @param d             The open directory stream of /dev.
+ * @param candidates    Array of #COMINIT_AUTOMOUNT_CANDIDATES_MAX elements that receives the candidates.
+ *
+ * @return  The number of candidates found, at most #COMINIT_AUTOMOUNT_CANDIDATES_MAX
+ */
+static size_t cominitAutomountListDevNodes(DIR *d, cominitAutomountCandidate_t *candidates) {
+    struct dirent *deviceEntry = NULL;
+    char device[2 * COMINIT_ROOTFS_DEV_PATH_MAX] = {0};
+    struct stat st = {0};
+    size_t count = 0;
+
+    while ((deviceEntry = readdir(d))) {
+        const char *name = deviceEntry->d_name;
+        if (name[0] == '.') continue;
+        if (cominitAutomountIsBlacklistedName(name)) continue;
+
+        int n = snprintf(device, sizeof(device), "/dev/%s", name);
+        if (n < 0 || (size_t)n >= sizeof(candidates[0].device)) continue;
+        if (lstat(device, &st) != 0) continue;
+        if (S_ISLNK(st.st_mode)) continue;
+        if (!S_ISBLK(st.st_mode)) continue;
+
+        if (count == COMINIT_AUTOMOUNT_CANDIDATES_MAX) {
+            cominitErrPrint("More than %d block devices found, not scanning %s and any further devices.",
+                            COMINIT_AUTOMOUNT_CANDIDATES_MAX, device);
+            break;
+        }
+        memcpy(candidates[count].device, device, (size_t)n + 1);
+        candidates[count].blockSize = 0;
+        candidates[count].size = 0;
+        count++;
+    }
+
+    return count;
+}
+
+int cominitAutomountFindPartitionByLookup(cominitGPTDisk_t *gptDisk, cominitGPTLookup_t *lookup) {
     int result = EXIT_FAILURE;
-    if (gptDisk == NULL || guidType == NULL || partitionName == NULL || partitionNameSize == 0) {
+    bool keyValid = false;
+    if (lookup != NULL && lookup->match == COMINIT_GPT_MATCH_PARTLABEL) {
+        keyValid =
+            (lookup->label != NULL && strnlen(lookup->label, GPT_ENTRY_LABEL_SIZE_MAX) < GPT_ENTRY_LABEL_SIZE_MAX);
+    } else if (lookup != NULL) {
+        keyValid = (lookup->guid != NULL);
+    }
+    if (gptDisk == NULL || !keyValid || lookup->partitionName == NULL || lookup->partitionNameSize == 0) {
         cominitErrPrint("Invalid parameters");
     } else {
-        DIR *d = opendir("/dev");
-        if (!d) {
-            cominitErrnoPrint("Could not open /dev for gpt disk scan.");
+        cominitAutomountProbe_t *probe = calloc(1, sizeof(*probe));
+        DIR *d = NULL;
+        bool sysfs = false;
+        if (probe == NULL) {
+            cominitErrnoPrint("Allocation of disk scan failed");
+        } else if ((d = opendir(COMINIT_AUTOMOUNT_SYSFS_BLOCK)) != NULL) {
+            sysfs = true;
         } else {
-            struct dirent *deviceEntry = NULL;
-            char device[2 * COMINIT_ROOTFS_DEV_PATH_MAX] = {0};
-            struct stat st = {0};
-
-            while ((deviceEntry = readdir(d))) {
-                const char *name = deviceEntry->d_name;
-                if (name[0] == '.') continue;
-                if (cominitAutomountIsBlacklistedName(name)) continue;
-
-                snprintf(device, sizeof(device), "/dev/%s", name);
-                if (lstat(device, &st) != 0) continue;
-                if (S_ISLNK(st.st_mode)) continue;
-                if (!S_ISBLK(st.st_mode)) continue;
-
-                cominitGPTDisk_t diskToProbe = {0};
-                result = cominitAutomountFindGpt(device, &diskToProbe);
+            cominitDebugPrint("Could not open " COMINIT_AUTOMOUNT_SYSFS_BLOCK ", scanning /dev instead.");
+            d = opendir("/dev");
+        }
+
+        if (probe != NULL && d == NULL) {
+            cominitErrnoPrint("Could not open /dev for gpt disk scan.");
+            free(probe);
+        } else if (probe != NULL) {
+            size_t deviceCount = sysfs ? cominitAutomountListSysfsDisks(d, probe->candidates)
+                                       : cominitAutomountListDevNodes(d, probe->candidates);
+            closedir(d);
+
+            lookup->found = false;
+            if (deviceCount == 1) {
+                cominitGPTDisk_t disk = {0};
+                result = cominitAutomountProbeDevice(&probe->candidates[0], lookup, &disk);
                 if (result == EXIT_SUCCESS) {
-                    result =
-                        cominitAutomountFindPartitionOnDisk(&diskToProbe, guidType, partitionName, partitionNameSize);
-                    if (result == EXIT_SUCCESS) {
-                        memcpy(gptDisk, &diskToProbe, sizeof(*gptDisk));
-                        break;
-                    }
+                    cominitAutomountFreeDisk(gptDisk);
+                    memcpy(gptDisk, &disk, sizeof(*gptDisk));
+                }
+                free(probe);
+            } else if (deviceCount > 1) {
+                probe->match = lookup->match;
+                if (lookup->match == COMINIT_GPT_MATCH_PARTLABEL) {
+                    memcpy(probe->label, lookup->label, strlen(lookup->label) + 1);
+                } else {
+                    memcpy(&probe->guid, lookup->guid, sizeof(probe->guid));
                 }
+                result = cominitAutomountProbeParallel(probe, deviceCount, gptDisk, lookup->partitionName,
+                                                       lookup->partitionNameSize);
+                lookup->found = (result == EXIT_SUCCESS);
+            } else {
+                free(probe);
             }
-            closedir(d);
         }
     }
 
     return result;
-}
\ No newline at end of file
+}
+
+int cominitAutomountFindPartition(cominitGPTDisk_t *gptDisk, const cominitGuid_t *guidType, char *partitionName,
+                                  size_t partitionNameSize) {
+    cominitGPTLookup_t lookup = {.match = COMINIT_GPT_MATCH_TYPE,
+                                 .guid = guidType,
+                                 .partitionName = partitionName,
+                                 .partitionNameSize = partitionNameSize,
+                                 .found = false};
+
+    return cominitAutomountFindPartitionByLookup(gptDisk, &lookup);
+}
+
+int cominitAutomountParseGuid(cominitGuid_t *guid, const char *str) {
+    /* Byte order of the textual form on disk, the first three fields are stored little-endian. */
+    static const uint8_t byteOrder[sizeof(guid->bytes)] = {3, 2, 1, 0, 5, 4, 7, 6, 8, 9, 10, 11, 12, 13, 14, 15};
+    /* Number of Bytes of each dash separated group of the textual form. */
+    static const size_t groupBytes[] = {4, 2, 2, 2, 6};
+    uint8_t textual[sizeof(guid->bytes)] = {0};
+    size_t offset = 0;
+
+    if (guid == NULL || str == NULL) {
+        cominitErrPrint("Invalid parameters");
+        return EXIT_FAILURE;
+    }
+
+    for (size_t i = 0; i < ARRAY_SIZE(groupBytes); i++) {
+        size_t groupLen = 2 * groupBytes[i];
+        if (strnlen(str, groupLen) != groupLen ||
+            cominitCommonHexToBytes(textual + offset, groupBytes[i], str, groupLen) != (ssize_t)groupBytes[i]) {
+            return EXIT_FAILURE;
+        }
+        offset += groupBytes[i];
+        str += groupLen;
+        if (*str != ((i + 1 < ARRAY_SIZE(groupBytes)) ? '-' : '\0')) {
+            return EXIT_FAILURE;
+        }
+        str++;
+    }
+
+    for (size_t i = 0; i < sizeof(guid->bytes); i++) {
+        guid->bytes[i] = textual[byteOrder[i]];
+    }
+
+    return EXIT_SUCCESS;
+}
+
+int cominitAutomountParsePartitionSpec(cominitGPTLookup_t *lookup, cominitGuid_t *guid, const char *spec) {
+    static const char partUuidPrefix[] = "PARTUUID=";
+    static const char partLabelPrefix[] = "PARTLABEL=";
+    int result = EXIT_FAILURE;
+
+    if (lookup == NULL || guid == NULL || spec == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else if (strncmp(spec, partUuidPrefix, sizeof(partUuidPrefix) - 1) == 0) {
+        if (cominitAutomountParseGuid(guid, spec + sizeof(partUuidPrefix) - 1) == EXIT_SUCCESS) {
+            lookup->match = COMINIT_GPT_MATCH_PARTUUID;
+            lookup->guid = guid;
+            lookup->label = NULL;
+            result = EXIT_SUCCESS;
+        }
+    } else if (strncmp(spec, partLabelPrefix, sizeof(partLabelPrefix) - 1) == 0) {
+        const char *label = spec + sizeof(partLabelPrefix) - 1;
+        size_t len = strnlen(label, GPT_ENTRY_LABEL_SIZE_MAX);
+        if (len > 0 && len < GPT_ENTRY_LABEL_SIZE_MAX) {
+            lookup->match = COMINIT_GPT_MATCH_PARTLABEL;
+            lookup->guid = NULL;
+            lookup->label = label;
+            result = EXIT_SUCCESS;
+        }
+    }
+
+    return result;
+}
+
+int cominitAutomountFindPartitionOnDevice(cominitGPTDisk_t *gptDisk, const char *device, cominitGPTLookup_t *lookup) {
+    cominitAutomountCandidate_t candidate = {0};
+    cominitGPTDisk_t disk = {0};
+
+    if (gptDisk == NULL || device == NULL || lookup == NULL) {
+        cominitErrPrint("Invalid parameters");
+        return EXIT_FAILURE;
+    }
+    int n = snprintf(candidate.device, sizeof(candidate.device), "%s", device);
+    if (n < 0 || (size_t)n >= sizeof(candidate.device)) {
+        cominitErrPrint("Device node %s too long.", device);
+        return EXIT_FAILURE;
+    }
+
+    if (cominitAutomountProbeDevice(&candidate, lookup, &disk) == EXIT_FAILURE) {
+        return EXIT_FAILURE;
+    }
+    cominitAutomountFreeDisk(gptDisk);
+    memcpy(gptDisk, &disk, sizeof(*gptDisk));
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Reads the unique partition GUID of the ESP the boot loader was started from out of the LoaderDevicePartUUID EFI
+ * variable.
+ *
+ * @param partUuid  Pointer that receives the unique partition GUID.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitAutomountReadLoaderPartUuid(cominitGuid_t *partUuid) {
+    /* 4 Bytes of attributes followed by the GUID as null-terminated UTF-16LE string */
+    uint8_t var[sizeof(uint32_t) + 2 * (COMINIT_AUTOMOUNT_GUID_STRING_LENGTH + 1)];
+    char str[COMINIT_AUTOMOUNT_GUID_STRING_LENGTH + 1];
+    int fd = open(COMINIT_AUTOMOUNT_EFIVAR_LOADER_PARTUUID, O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0) {
+        cominitDebugPrint("No LoaderDevicePartUUID EFI variable available.");
+        return EXIT_FAILURE;
+    }
+    ssize_t bytesRead = read(fd, var, sizeof(var));
+    close(fd);
+    if (bytesRead < (ssize_t)(sizeof(uint32_t) + 2 * COMINIT_AUTOMOUNT_GUID_STRING_LENGTH)) {
+        cominitErrPrint("LoaderDevicePartUUID EFI variable is too short.");
+        return EXIT_FAILURE;
+    }
+
+    for (size_t i = 0; i < COMINIT_AUTOMOUNT_GUID_STRING_LENGTH; i++) {
+        const uint8_t *c = var + sizeof(uint32_t) + 2 * i;
+        str[i] = (c[1] == 0 && c[0] < 0x80) ? (char)c[0] : '?';
+    }
+    str[COMINIT_AUTOMOUNT_GUID_STRING_LENGTH] = '\0';
+    if (cominitAutomountParseGuid(partUuid, str) == EXIT_FAILURE) {
+        cominitErrPrint("LoaderDevicePartUUID EFI variable holds no valid GUID.");
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Checks whether the uevent attribute of a block device in sysfs announces a given unique partition GUID.
+ *
+ * @param path      The path of the uevent attribute.
+ * @param partUuid  The unique partition GUID to look for.
+ *
+ * @return  true if the block device is the partition, false otherwise
+ */
+static bool cominitAutomountUeventHasPartUuid(const char *path, const cominitGuid_t *partUuid) {
+    static const char key[] = "PARTUUID=";
+    char line[COMINIT_ROOTFS_DEV_PATH_MAX];
+    bool match = false;
+    FILE *f = fopen(path, "re");
+
+    if (f == NULL) {
+        return false;
+    }
+    while (!match && fgets(line, sizeof(line), f) != NULL) {
+        cominitGuid_t guid;
+        if (strncmp(line, key, sizeof(key) - 1) != 0) {
+            continue;
+        }
+        line[strcspn(line, "\n")] = '\0';
+        match = (cominitAutomountParseGuid(&guid, line + sizeof(key) - 1) == EXIT_SUCCESS &&
+                 memcmp(guid.bytes, partUuid->bytes, sizeof(guid.bytes)) == 0);
+    }
+    fclose(f);
+
+    return match;
+}
+
+int cominitAutomountGetBootDisk(char *device, size_t deviceSize) {
+    int result = EXIT_FAILURE;
+    cominitGuid_t partUuid;
+    DIR *d = NULL;
+
+    if (device == NULL || deviceSize == 0) {
+        cominitErrPrint("Invalid parameters");
+    } else if (cominitAutomountReadLoaderPartUuid(&partUuid) == EXIT_SUCCESS &&
+               (d = opendir(COMINIT_AUTOMOUNT_SYSFS_BLOCK)) != NULL) {
+        struct dirent *deviceEntry = NULL;
+        char path[2 * COMINIT_ROOTFS_DEV_PATH_MAX];
+
+        while (result == EXIT_FAILURE && (deviceEntry = readdir(d))) {
+            const char *name = deviceEntry->d_name;
+            if (name[0] == '.') continue;
+
+            int n = snprintf(path, sizeof(path), COMINIT_AUTOMOUNT_SYSFS_BLOCK "/%s/uevent", name);
+            if (n < 0 || (size_t)n >= sizeof(path)) continue;
+            if (!cominitAutomountUeventHasPartUuid(path, &partUuid)) continue;
+
+            /* The sysfs directory of a partition is a subdirectory of the one of its disk. */
+            char *diskDir = NULL;
+            snprintf(path, sizeof(path), COMINIT_AUTOMOUNT_SYSFS_BLOCK "/%s/..", name);
+            if ((diskDir = realpath(path, NULL)) == NULL) {
+                cominitErrnoPrint("Could not resolve disk of boot partition %s.", name);
+                break;
+            }
+            const char *diskName = strrchr(diskDir, '/');
+            if (diskName != NULL &&
+                cominitAutomountSysfsDeviceNode(diskName + 1, device, deviceSize) == EXIT_SUCCESS) {
+                cominitDebugPrint("Boot loader was started from %s on disk %s.", name, device);
+                result = EXIT_SUCCESS;
+            }
+            free(diskDir);
+            break;
+        }
+        closedir(d);
+    }
+
+    return result;
+}
+
+void cominitAutomountFreeDisk(cominitGPTDisk_t *gptDisk) {
+    if (gptDisk != NULL) {
+        free(gptDisk->entries);
+        gptDisk->entries = NULL;
+    }
+}
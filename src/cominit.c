@@ -25,27 +25,41 @@
 #endif
 #include "automount.h"
 #include "common.h"
+#include "crypto.h"
 #include "minsetup.h"
 #include "output.h"
+#include "sha256.h"
+#include "timing.h"
+#include "uevent.h"
+#include "verity.h"
 #include "version.h"
 
 /**
- * Number of times cominit tries to mount the rootfs.
+ * Default for the maximum time cominit waits for the rootfs to appear.
  *
- * If the rootfs is not immediately available, cominit will check again after #COMINIT_ROOT_WAIT_INTERVAL_MILLIS,
- * maximum this many times.
- *
- * TODO: This is a fix for booting on a Raspberry Pi 4. To be more hardware-agnostic we need to make this parameter
- * configurable on the Kernel command line.
+ * Unit is milliseconds. If the rootfs is not immediately available, cominit waits for the Kernel to announce new block
+ * devices via uevents and retries until this deadline has passed. Can be changed on the Kernel command line with
+ * `cominit.rootwait=`.
  */
-#define COMINIT_ROOT_WAIT_TRIES 10uL
+#define COMINIT_ROOT_WAIT_TIMEOUT_MILLIS 5000uL
 /**
- * Interval between tries to mount the rootfs.
+ * Default for the maximum interval between tries to find the rootfs.
  *
- * Unit is milliseconds. See #COMINIT_ROOT_WAIT_TRIES.
+ * Unit is milliseconds. Cominit retries after the intervals given in #cominitRootWaitBackoffMillis, capped by this
+ * value, even if no uevent arrives. Can be changed on the Kernel command line with `cominit.rootdelay=`. See
+ * #COMINIT_ROOT_WAIT_TIMEOUT_MILLIS.
  */
 #define COMINIT_ROOT_WAIT_INTERVAL_MILLIS 500uL
 
+/**
+ * Backoff schedule between tries to find the rootfs in milliseconds.
+ *
+ * Starts small so a rootfs probed shortly after cominit has started is picked up with low latency, and grows to avoid
+ * needless rescans on slow storage. Every interval is capped by cominitCliArgs_t::rootDelayMillis, the last entry is
+ * repeated until the deadline cominitCliArgs_t::rootWaitMillis has passed.
+ */
+static const unsigned long cominitRootWaitBackoffMillis[] = {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000};
+
 /**
  * Checks if a string is equal to at least one of two comparison literals.
  *
@@ -72,6 +86,28 @@
  * @return  0 on success, -1 on error
  */
 static inline int cominitMicroSleep(unsigned long long micros);
+/**
+ * Gets the milliseconds passed since a point in time of the monotonic clock.
+ *
+ * @param start  The point in time to measure from, as returned by clock_gettime(CLOCK_MONOTONIC, ...).
+ *
+ * @return  The elapsed time in milliseconds, 0 if the clock could not be read
+ */
+static unsigned long cominitMillisSince(const struct timespec *start);
+/**
+ * Waits until the rootfs can be discovered or the deadline has passed.
+ *
+ * Calls cominitDiscoverRootfs() and, as long as that fails, sleeps until the Kernel announces a new block device
+ * (see cominitUeventWaitForBlockDevice()) but no longer than the next interval of #cominitRootWaitBackoffMillis
+ * before trying again. Falls back to polling with that schedule if no uevent socket could be opened.
+ *
+ * @param argCtx        Pointer to the structure that holds the parsed options.
+ * @param rfsMeta       Pointer to the structure that receives the rootfs partition.
+ * @param gptDiskRoot   The pointer to a cominitGPTDisk_t struct that receives the disk information.
+ * @return  true if the rootfs was found in time, false otherwise
+ */
+static bool cominitWaitForRootfs(cominitCliArgs_t *argCtx, cominitRfsMetaData_t *rfsMeta,
+                                 cominitGPTDisk_t *gptDiskRoot);
 /**
  * Prints a message indicating cominit's version to stderr.
  */
@@ -90,6 +126,13 @@ static void cominitPrintUsage(void);
  * @return  true if used, false otherwise
  */
 static inline bool cominitUseTpm(cominitCliArgs_t *ctx);
+/**
+ * Checks at RT the parsed options to determine if a TPM may be used, before the secureStorage partition is known.
+ *
+ * @param ctx   Pointer to the structure that receives the parsed options.
+ * @return  true if the TPM may be used, false otherwise
+ */
+static inline bool cominitMayUseTpm(cominitCliArgs_t *ctx);
 #endif
 /**
  * Parses a device node from a value in an argument of argv.
@@ -99,6 +142,25 @@ static inline bool cominitUseTpm(cominitCliArgs_t *ctx);
  * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
  */
 static int cominitParseDeviceNode(char *device, const char *argValue);
+/**
+ * Parses the location of the rootfs partition from a value in an argument of argv.
+ *
+ * Accepts a device node as well as a `PARTUUID=` or `PARTLABEL=` specification of a GPT partition. A later argument
+ * overrides an earlier one.
+ *
+ * @param argCtx    Pointer to the structure that receives the location.
+ * @param argValue  The parsed value of the argument found in the provided argument vector.
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitParseRootPartition(cominitCliArgs_t *argCtx, const char *argValue);
+/**
+ * Parses a non-negative decimal number from a value in an argument of argv.
+ *
+ * @param value     Pointer to the variable that receives the parsed number.
+ * @param argValue  The parsed value of the argument found in the provided argument vector.
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitParseUnsigned(unsigned long *value, const char *argValue);
 /**
  * Parses a value from an argument of argv.
  *
@@ -118,6 +180,19 @@ static const char *cominitParseArgValue(const char *arg, const char *param1, con
  * @return  true on success, false otherwise
  */
 bool cominitDiscoverRootfs(cominitCliArgs_t *argCtx, cominitRfsMetaData_t *rfsMeta, cominitGPTDisk_t *gptDiskRoot);
+/**
+ * Looks for the rootfs partition in the GPT of the disks most likely holding it before scanning all disks.
+ *
+ * The disks are tried in the order: the disk found by a previous try, the disk given by `cominit.disk=`, the disk the
+ * boot loader was started from and finally all disks.
+ *
+ * @param argCtx        Pointer to the structure that holds the parsed options.
+ * @param lookup        The rootfs partition to look for. Its buffer receives the device node of the partition.
+ * @param gptDiskRoot   The pointer to a cominitGPTDisk_t struct that receives the disk information.
+ * @return  true if the partition has been found, false otherwise
+ */
+static bool cominitFindRootPartition(cominitCliArgs_t *argCtx, cominitGPTLookup_t *lookup,
+                                     cominitGPTDisk_t *gptDiskRoot);
 /**
  * Load selinux policy file from corresponding path given.
  *
@@ -154,9 +229,17 @@ int main(int argc, char *argv[], char *envp[]) {
 #endif
                                .enableSelinux = false,
                                .enableEnforceMode = false,
-                               .devNodeRootFs[0] = '\0'};
+                               .verityCheck = false,
+                               .verityCheckLevels = COMINIT_VERITY_CHECK_LEVELS_DEFAULT,
+                               .rootWaitMillis = COMINIT_ROOT_WAIT_TIMEOUT_MILLIS,
+                               .rootDelayMillis = COMINIT_ROOT_WAIT_INTERVAL_MILLIS,
+                               .devNodeRootFs[0] = '\0',
+                               .rootPartSpec[0] = '\0',
+                               .devNodeDisk[0] = '\0'};
     const char *argValue = NULL;
 
+    cominitTimingInit();
+
     for (int i = 0; i < argc; i++) {
         if (cominitParamCheck(argv[i], "-V", "--version")) {
             cominitPrintVersion();
@@ -167,11 +250,20 @@ int main(int argc, char *argv[], char *envp[]) {
             return EXIT_FAILURE;
         }
         if ((argValue = cominitParseArgValue(argv[i], "root", "cominit.rootfs")) != NULL) {
-            if (cominitParseDeviceNode(argCtx.devNodeRootFs, argValue) == EXIT_FAILURE) {
+            if (cominitParseRootPartition(&argCtx, argValue) == EXIT_FAILURE) {
+                cominitErrPrint("\'%s\' requires a valid device node, PARTUUID=<uuid> or PARTLABEL=<label> ", argv[i]);
+                continue;
+            }
+        }
+        if ((argValue = cominitParseArgValue(argv[i], "disk", "cominit.disk")) != NULL) {
+            if (cominitParseDeviceNode(argCtx.devNodeDisk, argValue) == EXIT_FAILURE) {
                 cominitErrPrint("\'%s\' requires a valid device node ", argv[i]);
                 continue;
             }
         }
+        if (cominitCommonParseRootWaitArg(&argCtx, argv[i]) != 0) {
+            continue;
+        }
         if ((argValue = cominitParseArgValue(argv[i], "logLevel", "cominit.logLevel")) != NULL) {
             if (cominitOutputParseLogLevel(&argCtx.visibleLogLevel, argValue) == EXIT_FAILURE) {
                 cominitErrPrint("\'%s\' requires a valid log level ", argv[i]);
@@ -184,6 +276,17 @@ int main(int argc, char *argv[], char *envp[]) {
             cominitInfoPrint("Selinux is enabled, corresponding setup will be included");
         }
 
+        if (cominitParamCheck(argv[i], "veritycheck", "cominit.veritycheck")) {
+            argCtx.verityCheck = true;
+        }
+        if ((argValue = cominitParseArgValue(argv[i], "veritycheck", "cominit.veritycheck")) != NULL) {
+            if (cominitParseUnsigned(&argCtx.verityCheckLevels, argValue) == EXIT_FAILURE) {
+                cominitErrPrint("\'%s\' requires a valid number of hash tree levels", argv[i]);
+                continue;
+            }
+            argCtx.verityCheck = true;
+        }
+
         if (cominitParamCheck(argv[i], "enforcing", "cominit.enforcing")) {
             argCtx.enableEnforceMode = true;
             cominitInfoPrint("Selinux is set to enforcing mode. Selinux should be enabled.");
@@ -214,19 +317,28 @@ int main(int argc, char *argv[], char *envp[]) {
                 continue;
             }
         }
+        if ((argValue = cominitParseArgValue(argv[i], "tcti", "cominit.tcti")) != NULL) {
+            if (cominitTpmParseTcti(&argCtx, argValue) == EXIT_FAILURE) {
+                cominitErrPrint("\'%s\' requires a TCTI configuration ", argv[i]);
+                continue;
+            }
+        }
 #endif
     }
     setsid();
     umask(0);
     cominitOutputSetVisibleLogLevel(argCtx.visibleLogLevel);
     cominitInfoPrint("BaseOS Compact Init version %s started.", cominitGetVersionString());
+    cominitDebugPrint("Using %s SHA-256 implementation.", cominitSha256GetBackend());
 
     /* Mount devtmpfs so we have a minimal system */
     cominitInfoPrint("Setting up minimal environment...");
+    cominitTimingStart(COMINIT_TIMING_SETUP_SYSFILES);
     if (cominitSetupSysfiles() == -1) {
         cominitErrPrint("Could not setup minimal system/device files. Init failed.");
         goto rescue;
     }
+    cominitTimingStop(COMINIT_TIMING_SETUP_SYSFILES);
 
 /* In case we are built to emulate a HSM, enroll the standard development key for dm-integrity HMAC in the Kernel
  * user keyring. */
@@ -238,26 +350,32 @@ int main(int argc, char *argv[], char *envp[]) {
     }
 #endif
 
+/* Bring up the TPM in the background while the rootfs is discovered and verified. If the secureStorage partition is
+ * not found later on, the TPM is not used and only released again. */
+#ifdef COMINIT_USE_TPM
+    cominitTpmInit_t tpmInit = {0};
+    if (cominitMayUseTpm(&argCtx) == true) {
+        cominitTpmInitStart(&tpmInit, argCtx.tcti);
+    }
+#endif
+
     cominitRfsMetaData_t rfsMeta = {0};
     cominitGPTDisk_t gptDiskRoot = {0};
 
-    unsigned long failCount = 0;
-    while (cominitDiscoverRootfs(&argCtx, &rfsMeta, &gptDiskRoot) == false) {
-        if (failCount < COMINIT_ROOT_WAIT_TRIES) {
-            failCount++;
-            cominitInfoPrint("No valid rootfs yet found, trying again in %lums.", COMINIT_ROOT_WAIT_INTERVAL_MILLIS);
-            cominitMicroSleep((unsigned long long)COMINIT_ROOT_WAIT_INTERVAL_MILLIS * 1000uLL);
-        } else {
-            cominitErrPrint("No valid rootfs found.");
-            goto rescue;
-        }
+    cominitTimingStart(COMINIT_TIMING_DISCOVER_ROOTFS);
+    if (cominitWaitForRootfs(&argCtx, &rfsMeta, &gptDiskRoot) == false) {
+        cominitErrPrint("No valid rootfs found.");
+        goto rescue;
     }
+    cominitTimingStop(COMINIT_TIMING_DISCOVER_ROOTFS);
 
     cominitInfoPrint("Looking for rootfs metadata on partition \'%s\'.", rfsMeta.devicePath);
+    cominitTimingStart(COMINIT_TIMING_VERIFY_METADATA);
     if (cominitLoadVerifyMetadata(&rfsMeta, COMINIT_ROOTFS_KEY_LOCATION) == -1) {
         cominitErrPrint("Could not verify partition metadata. Init failed.");
         goto rescue;
     }
+    cominitTimingStop(COMINIT_TIMING_VERIFY_METADATA);
     cominitInfoPrint("Rootfs metadata successfully loaded and verified.");
 
     if (rfsMeta.crypt & COMINIT_CRYPTOPT_CRYPT) {
@@ -265,44 +383,55 @@ int main(int argc, char *argv[], char *envp[]) {
         goto rescue;
     }
 
+    if (argCtx.verityCheck && rfsMeta.crypt == COMINIT_CRYPTOPT_VERITY) {
+        cominitTimingStart(COMINIT_TIMING_VERITY_CHECK);
+        if (cominitVerityPreCheck(&rfsMeta, argCtx.verityCheckLevels) == -1) {
+            cominitErrPrint("The dm-verity pre-check of the rootfs failed. Init failed.");
+            goto rescue;
+        }
+        cominitTimingStop(COMINIT_TIMING_VERITY_CHECK);
+    }
+
 #ifdef COMINIT_USE_TPM
+    cominitTimingStart(COMINIT_TIMING_TPM);
     if (argCtx.devNodeCrypt[0] == '\0') {
         cominitInfoPrint("No secureStorage partition given from kernel command line.");
         if (gptDiskRoot.diskName[0] != '\0') {
-            if (cominitAutomountFindPartitionOnDisk(&gptDiskRoot, (const char *)COMINIT_SECURE_STORAGE_GUID_TYPE,
+            if (cominitAutomountFindPartitionOnDisk(&gptDiskRoot, &COMINIT_SECURE_STORAGE_GUID_TYPE,
                                                     argCtx.devNodeCrypt, sizeof(argCtx.devNodeCrypt)) == EXIT_FAILURE) {
                 cominitErrPrint("Could not find secureStorage partition from guid type.");
             }
         } else {
             cominitGPTDisk_t gptDiskNotRoot = {0};
-            if (cominitAutomountFindPartition(&gptDiskNotRoot, (const char *)COMINIT_SECURE_STORAGE_GUID_TYPE,
+            if (cominitAutomountFindPartition(&gptDiskNotRoot, &COMINIT_SECURE_STORAGE_GUID_TYPE,
                                               argCtx.devNodeCrypt, sizeof(argCtx.devNodeCrypt)) == EXIT_FAILURE) {
                 cominitErrPrint("Could not find secureStorage partition from guid type.");
             }
+            cominitAutomountFreeDisk(&gptDiskNotRoot);
         }
     }
 
     if (cominitUseTpm(&argCtx) == true) {
-        cominitTpmContext_t tpmCtx;
+        cominitTpmContext_t *tpmCtx = &tpmInit.tpmCtx;
 
         cominitInfoPrint("TPM is used");
 
-        int result = cominitInitTpm(&tpmCtx);
+        int result = cominitTpmInitJoin(&tpmInit);
 
         if (result != EXIT_SUCCESS) {
             cominitErrPrint("TPM init failed.");
         } else {
             if (cominitTpmExtendEnabled(&argCtx) == true) {
-                result = cominitTpmExtendPCR(&tpmCtx, COMINIT_ROOTFS_KEY_LOCATION, argCtx.pcrIndex);
+                result = cominitTpmExtendPCR(tpmCtx, COMINIT_ROOTFS_KEY_LOCATION, argCtx.pcrIndex);
                 if (result != EXIT_SUCCESS) {
                     cominitErrPrint("PCR extention failed.");
                 }
             }
             if (cominitTpmSecureStorageEnabled(&argCtx) == true) {
-                cominitTpmState_t state = cominitTpmProtectData(&tpmCtx, &argCtx);
+                cominitTpmState_t state = cominitTpmProtectData(tpmCtx, &argCtx);
                 switch (state) {
                     case TpmPolicyFailure:
-                        result = cominitTpmHandlePolicyFailure(&tpmCtx);
+                        result = cominitTpmHandlePolicyFailure(tpmCtx);
                         if (result != EXIT_SUCCESS) {
                             cominitErrPrint("Failed to handle policy failure");
                         }
@@ -317,9 +446,13 @@ int main(int argc, char *argv[], char *envp[]) {
                 }
             }
         }
-        cominitDeleteTpm(&tpmCtx);
     }
+    cominitTpmInitRelease(&tpmInit);
+    cominitTimingStop(COMINIT_TIMING_TPM);
 #endif
+    cominitCryptoReleaseKey();
+    cominitReleaseMetadata(&rfsMeta);
+    cominitAutomountFreeDisk(&gptDiskRoot);
 
     /* Set up the rootfs */
     cominitInfoPrint("Setting up rootfs at /newroot...");
@@ -337,6 +470,7 @@ int main(int argc, char *argv[], char *envp[]) {
 #endif
 
     if (argCtx.enableSelinux) {
+        cominitTimingStart(COMINIT_TIMING_LOAD_SELINUX);
         if (cominitSetupSysSelinuxfiles() == -1) {
             cominitErrPrint("Could not add selinuxfs to minimal system/device files.");
             cominitErrPrint("Installed Policies will not be loaded ");
@@ -363,10 +497,12 @@ int main(int argc, char *argv[], char *envp[]) {
                 }
             }
         }
+        cominitTimingStop(COMINIT_TIMING_LOAD_SELINUX);
     }
 
     /* Housekeeping/cleanup before switching to rootfs. */
     cominitInfoPrint("Unmounting system directories...");
+    cominitTimingStart(COMINIT_TIMING_CLEANUP_SYSFILES);
     if (argCtx.enableSelinux) {
         if (cominitCleanupSelinuxfiles() == -1) {
             cominitInfoPrint("Warning: Could not unmount all selinux files.");
@@ -375,6 +511,7 @@ int main(int argc, char *argv[], char *envp[]) {
     if (cominitCleanupSysfiles() == -1) {
         cominitInfoPrint("Warning: Could not unmount all system/device files.");
     }
+    cominitTimingStop(COMINIT_TIMING_CLEANUP_SYSFILES);
 
     /* Switch into the new rootfs */
     if (cominitSwitchIntoRootfs() == -1) {
@@ -382,6 +519,11 @@ int main(int argc, char *argv[], char *envp[]) {
         goto rescue;
     }
 
+    /* Hand the timing report over to the rootfs, it is of no use if it cannot be written. */
+    if (cominitSetupRunfs() == -1 || cominitTimingWriteReport(COMINIT_TIMING_REPORT_PATH) == -1) {
+        cominitInfoPrint("Warning: Could not write timing report.");
+    }
+
     /* if we made it up to here we say goodbye and exec into the rootfs init daemon */
     cominitInfoPrint("Exec into rootfs init...");
     char *const initArgs[] = {"/sbin/init", NULL};
@@ -426,6 +568,73 @@ static inline int cominitMicroSleep(unsigned long long micros) {
     return 0;
 }
 
+static unsigned long cominitMillisSince(const struct timespec *start) {
+    struct timespec now;
+    if (clock_gettime(CLOCK_MONOTONIC, &now) == -1) {
+        cominitErrnoPrint("Could not get current time from monotonic clock.");
+        return 0;
+    }
+    return (unsigned long)((now.tv_sec - start->tv_sec) * 1000L + (now.tv_nsec - start->tv_nsec) / 1000000L);
+}
+
+static bool cominitWaitForRootfs(cominitCliArgs_t *argCtx, cominitRfsMetaData_t *rfsMeta,
+                                 cominitGPTDisk_t *gptDiskRoot) {
+    struct timespec start;
+    bool rootFound = false;
+    size_t step = 0;
+    unsigned long tries = 1;
+
+    if (clock_gettime(CLOCK_MONOTONIC, &start) == -1) {
+        cominitErrnoPrint("Could not get current time from monotonic clock.");
+        return false;
+    }
+    // Subscribe before the first try so no uevent between a failed try and the wait gets lost.
+    int ueventFd = cominitUeventOpen();
+    if (ueventFd == -1) {
+        cominitInfoPrint("Uevents unavailable, falling back to polling.");
+    }
+
+    unsigned long elapsed = 0;
+    while ((rootFound = cominitDiscoverRootfs(argCtx, rfsMeta, gptDiskRoot)) == false) {
+        elapsed = cominitMillisSince(&start);
+        if (elapsed >= argCtx->rootWaitMillis) {
+            break;
+        }
+        if (tries == 1) {
+            cominitInfoPrint("No valid rootfs yet found, waiting up to %lums (retry backoff %lums..%lums).",
+                             argCtx->rootWaitMillis, cominitRootWaitBackoffMillis[0], argCtx->rootDelayMillis);
+        }
+        unsigned long wait = cominitRootWaitBackoffMillis[step];
+        if (step < ARRAY_SIZE(cominitRootWaitBackoffMillis) - 1) {
+            step++;
+        }
+        if (wait > argCtx->rootDelayMillis) {
+            wait = argCtx->rootDelayMillis;
+        }
+        if (wait > argCtx->rootWaitMillis - elapsed) {
+            wait = argCtx->rootWaitMillis - elapsed;
+        }
+        cominitDebugPrint("Try %lu failed after %lums, waiting up to %lums for new block devices.", tries, elapsed,
+                          wait);
+        if (ueventFd == -1 || cominitUeventWaitForBlockDevice(ueventFd, wait) == -1) {
+            cominitMicroSleep((unsigned long long)wait * 1000uLL);
+        }
+        tries++;
+    }
+    cominitUeventClose(ueventFd);
+
+    if (rootFound) {
+        cominitInfoPrint("Rootfs found after %lums and %lu tries.", cominitMillisSince(&start), tries);
+    } else {
+        cominitErrPrint("Gave up waiting for rootfs after %lums and %lu tries.", elapsed, tries);
+    }
+    cominitTimingSetValue(COMINIT_TIMING_ROOT_WAIT, argCtx->rootWaitMillis);
+    cominitTimingSetValue(COMINIT_TIMING_ROOT_DELAY, argCtx->rootDelayMillis);
+    cominitTimingSetValue(COMINIT_TIMING_ROOT_TRIES, tries);
+
+    return rootFound;
+}
+
 static void cominitPrintVersion(void) {
     printf("Compact Init (cominit) version %s\n", cominitGetVersionString());
 }
@@ -435,7 +644,8 @@ static void cominitPrintUsage(void) {
     printf(
         "USAGE: cominit must be started by the Kernel as PID 1 from initramfs to set up a rootfs according to its\n"
         "       metadata and then switch into it. The location of the rootfs partition (e.g. "
-        "/dev/<blkdevice><partno>)\n"
+        "/dev/<blkdevice><partno>,\n"
+        "       PARTUUID=<uuid> or PARTLABEL=<label>)\n"
         "       is determined through an argument passed to cominit by the bootloader on the kernel command line.\n");
 }
 
@@ -457,6 +667,47 @@ static int cominitParseDeviceNode(char *device, const char *argValue) {
     return result;
 }
 
+static int cominitParseRootPartition(cominitCliArgs_t *argCtx, const char *argValue) {
+    int result = EXIT_FAILURE;
+
+    if (argCtx == NULL || argValue == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else if (cominitParseDeviceNode(argCtx->devNodeRootFs, argValue) == EXIT_SUCCESS) {
+        argCtx->rootPartSpec[0] = '\0';
+        result = EXIT_SUCCESS;
+    } else {
+        cominitGPTLookup_t lookup = {0};
+        cominitGuid_t guid;
+        size_t specLen = strnlen(argValue, sizeof(argCtx->rootPartSpec));
+        if (specLen < sizeof(argCtx->rootPartSpec) &&
+            cominitAutomountParsePartitionSpec(&lookup, &guid, argValue) == EXIT_SUCCESS) {
+            memcpy(argCtx->rootPartSpec, argValue, specLen + 1);
+            argCtx->devNodeRootFs[0] = '\0';
+            result = EXIT_SUCCESS;
+        }
+    }
+
+    return result;
+}
+
+static int cominitParseUnsigned(unsigned long *value, const char *argValue) {
+    int result = EXIT_FAILURE;
+
+    if (value == NULL || argValue == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        char *end = NULL;
+        errno = 0;
+        unsigned long parsed = strtoul(argValue, &end, 10);
+        if (!errno && end != argValue && *end == '\0' && argValue[0] != '-') {
+            *value = parsed;
+            result = EXIT_SUCCESS;
+        }
+    }
+
+    return result;
+}
+
 #ifdef COMINIT_USE_TPM
 static inline bool cominitUseTpm(cominitCliArgs_t *argCtx) {
     bool useTpm = false;
@@ -469,6 +720,18 @@ static inline bool cominitUseTpm(cominitCliArgs_t *argCtx) {
 
     return useTpm;
 }
+
+static inline bool cominitMayUseTpm(cominitCliArgs_t *argCtx) {
+    bool mayUseTpm = false;
+
+    if (cominitTpmExtendEnabled(argCtx) == true) {
+        mayUseTpm = true;
+    } else if (argCtx->devNodeBlob[0] != '\0' && argCtx->pcrSealCount > 0) {
+        mayUseTpm = true;
+    }
+
+    return mayUseTpm;
+}
 #endif
 
 static const char *cominitParseArgValue(const char *arg, const char *key1, const char *key2) {
@@ -487,30 +750,63 @@ static const char *cominitParseArgValue(const char *arg, const char *key1, const
     return value;
 }
 
+static bool cominitFindRootPartition(cominitCliArgs_t *argCtx, cominitGPTLookup_t *lookup,
+                                     cominitGPTDisk_t *gptDiskRoot) {
+    char bootDisk[COMINIT_ROOTFS_DEV_PATH_MAX] = {0};
+
+    if (gptDiskRoot->entries != NULL && cominitAutomountFindPartitionsOnDisk(gptDiskRoot, lookup, 1) == EXIT_SUCCESS) {
+        return true;
+    }
+    if (argCtx->devNodeDisk[0] != '\0' &&
+        cominitAutomountFindPartitionOnDevice(gptDiskRoot, argCtx->devNodeDisk, lookup) == EXIT_SUCCESS) {
+        return true;
+    }
+    if (cominitAutomountGetBootDisk(bootDisk, sizeof(bootDisk)) == EXIT_SUCCESS &&
+        strcmp(bootDisk, argCtx->devNodeDisk) != 0 &&
+        cominitAutomountFindPartitionOnDevice(gptDiskRoot, bootDisk, lookup) == EXIT_SUCCESS) {
+        return true;
+    }
+
+    return cominitAutomountFindPartitionByLookup(gptDiskRoot, lookup) == EXIT_SUCCESS;
+}
+
 bool cominitDiscoverRootfs(cominitCliArgs_t *argCtx, cominitRfsMetaData_t *rfsMeta, cominitGPTDisk_t *gptDiskRoot) {
     bool rootFound = false;
     static bool printedOnce = false;
 
     if (argCtx == NULL || rfsMeta == NULL || gptDiskRoot == NULL) {
         cominitErrPrint("Invalid parameters");
+    } else if (argCtx->devNodeRootFs[0] != '\0') {
+        if (!printedOnce) {
+            cominitInfoPrint("Rootfs partition %s given from kernel cmdline.", argCtx->devNodeRootFs);
+            printedOnce = true;
+        }
+        struct stat statbuf = {0};
+        if (stat(argCtx->devNodeRootFs, &statbuf) == 0) {
+            memcpy(rfsMeta->devicePath, argCtx->devNodeRootFs, sizeof(rfsMeta->devicePath));
+            rootFound = true;
+        }
     } else {
-        if (argCtx->devNodeRootFs[0] != '\0') {
-            if (!printedOnce) {
-                cominitInfoPrint("Rootfs partition %s given from kernel cmdline.", argCtx->devNodeRootFs);
-                printedOnce = true;
-            }
-            struct stat statbuf = {0};
-            if (stat(argCtx->devNodeRootFs, &statbuf) == 0) {
-                memcpy(rfsMeta->devicePath, argCtx->devNodeRootFs, sizeof(rfsMeta->devicePath));
-                rootFound = true;
-            }
-        } else {
-            if (!printedOnce) {
+        cominitGPTLookup_t lookup = {.match = COMINIT_GPT_MATCH_TYPE,
+                                     .guid = &COMINIT_ROOTFS_GUID_TYPE,
+                                     .partitionName = rfsMeta->devicePath,
+                                     .partitionNameSize = sizeof(rfsMeta->devicePath)};
+        cominitGuid_t partUuid;
+        if (!printedOnce) {
+            if (argCtx->rootPartSpec[0] != '\0') {
+                cominitInfoPrint("Rootfs partition %s given from kernel cmdline; scanning GPT for it.",
+                                 argCtx->rootPartSpec);
+            } else {
                 cominitInfoPrint("No rootfs from kernel cmdline; scanning GPT for rootfs GUID");
-                printedOnce = true;
             }
-            if (cominitAutomountFindPartition(gptDiskRoot, (const char *)COMINIT_ROOTFS_GUID_TYPE, rfsMeta->devicePath,
-                                              sizeof(rfsMeta->devicePath)) == EXIT_SUCCESS) {
+            printedOnce = true;
+        }
+        if ((argCtx->rootPartSpec[0] == '\0' ||
+             cominitAutomountParsePartitionSpec(&lookup, &partUuid, argCtx->rootPartSpec) == EXIT_SUCCESS) &&
+            cominitFindRootPartition(argCtx, &lookup, gptDiskRoot)) {
+            // The disk may be announced before the Kernel has created the nodes of its partitions.
+            struct stat statbuf = {0};
+            if (stat(rfsMeta->devicePath, &statbuf) == 0) {
                 rootFound = true;
             }
         }
@@ -6,9 +6,17 @@
 
 #include "common.h"
 
+#include <errno.h>
 #include <linux/fs.h>
+#include <stdlib.h>
+#include <string.h>
 #include <sys/ioctl.h>
 
+/** Option setting cominitCliArgs_t::rootWaitMillis including the `=`. **/
+#define COMINIT_COMMON_ROOT_WAIT_ARG "cominit.rootwait="
+/** Option setting cominitCliArgs_t::rootDelayMillis including the `=`. **/
+#define COMINIT_COMMON_ROOT_DELAY_ARG "cominit.rootdelay="
+
 int cominitCommonGetPartSize(uint64_t *partSize, int fd) {
     if (partSize == NULL) {
         cominitErrPrint("Return pointer must not be NULL.");
@@ -19,4 +27,78 @@ int cominitCommonGetPartSize(uint64_t *partSize, int fd) {
         return -1;
     }
     return 0;
-}
\ No newline at end of file
+}
+
+int cominitCommonBytesToHex(char *dest, const uint8_t *src, size_t n) {
+    // Small enough to stay within one cache line, so lookups do not depend on the data at cache line granularity.
+    static const char digits[16] = "0123456789abcdef";
+
+    if (dest == NULL || src == NULL) {
+        cominitErrPrint("Input parameters must not be NULL.");
+        return -1;
+    }
+    for (size_t i = 0; i < n; i++) {
+        dest[2 * i] = digits[src[i] >> 4];
+        dest[2 * i + 1] = digits[src[i] & 0x0f];
+    }
+    dest[2 * n] = '\0';
+    return 0;
+}
+
+ssize_t cominitCommonHexToBytes(uint8_t *dest, size_t destLen, const char *hex, size_t hexLen) {
+    // Value of each hexadecimal digit plus one, 0 for all other characters.
+    static const uint8_t values[256] = {
+        ['0'] = 1,   ['1'] = 2,   ['2'] = 3,   ['3'] = 4,   ['4'] = 5,   ['5'] = 6,   ['6'] = 7,   ['7'] = 8,
+        ['8'] = 9,   ['9'] = 10,  ['a'] = 11,  ['b'] = 12,  ['c'] = 13,  ['d'] = 14,  ['e'] = 15,  ['f'] = 16,
+        ['A'] = 11,  ['B'] = 12,  ['C'] = 13,  ['D'] = 14,  ['E'] = 15,  ['F'] = 16,
+    };
+
+    if (dest == NULL || hex == NULL) {
+        cominitErrPrint("Input parameters must not be NULL.");
+        return -1;
+    }
+    if (hexLen % 2 != 0 || hexLen / 2 > destLen) {
+        return -1;
+    }
+    for (size_t i = 0; i < hexLen / 2; i++) {
+        uint8_t high = values[(uint8_t)hex[2 * i]];
+        uint8_t low = values[(uint8_t)hex[2 * i + 1]];
+        if (high == 0 || low == 0) {
+            return -1;
+        }
+        dest[i] = (uint8_t)((high - 1) << 4 | (low - 1));
+    }
+    return (ssize_t)(hexLen / 2);
+}
+
+int cominitCommonParseRootWaitArg(cominitCliArgs_t *argCtx, const char *arg) {
+    unsigned long *target = NULL;
+    const char *value = NULL;
+
+    if (argCtx == NULL || arg == NULL) {
+        cominitErrPrint("Input parameters must not be NULL.");
+        return -1;
+    }
+    if (strncmp(arg, COMINIT_COMMON_ROOT_WAIT_ARG, sizeof(COMINIT_COMMON_ROOT_WAIT_ARG) - 1) == 0) {
+        target = &argCtx->rootWaitMillis;
+        value = arg + sizeof(COMINIT_COMMON_ROOT_WAIT_ARG) - 1;
+    } else if (strncmp(arg, COMINIT_COMMON_ROOT_DELAY_ARG, sizeof(COMINIT_COMMON_ROOT_DELAY_ARG) - 1) == 0) {
+        target = &argCtx->rootDelayMillis;
+        value = arg + sizeof(COMINIT_COMMON_ROOT_DELAY_ARG) - 1;
+    } else {
+        return 0;
+    }
+
+    char *end = NULL;
+    errno = 0;
+    unsigned long millis = strtoul(value, &end, 10);
+    // strtoul() would also accept leading whitespace and signs.
+    if (errno != 0 || value[0] < '0' || value[0] > '9' || *end != '\0' ||
+        (target == &argCtx->rootDelayMillis && millis == 0)) {
+        cominitErrPrint("\'%s\' requires a %sduration in milliseconds", arg,
+                        (target == &argCtx->rootDelayMillis) ? "non-zero " : "");
+        return -1;
+    }
+    *target = millis;
+    return 1;
+}
@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file crc32.c
+ * @brief Implementation of computing CRC32 checksums.
+ */
+#include "crc32.h"
+
+#include <string.h>
+
+#if defined(__ARM_FEATURE_CRC32) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#include <arm_acle.h>
+
+uint32_t cominitCrc32(uint32_t crc, const void *buf, size_t len) {
+    const uint8_t *p = buf;
+    uint32_t c = ~crc;
+
+    while (len >= sizeof(uint64_t)) {
+        uint64_t v;
+        memcpy(&v, p, sizeof(v));
+        c = __crc32d(c, v);
+        p += sizeof(v);
+        len -= sizeof(v);
+    }
+    while (len-- > 0) {
+        c = __crc32b(c, *p++);
+    }
+
+    return ~c;
+}
+
+#else
+#include <pthread.h>
+
+/** Reversed representation of the CRC32 polynomial 0x04c11db7. **/
+#define COMINIT_CRC32_POLYNOMIAL 0xedb88320u
+
+/** Lookup tables for slicing-by-8, table n holds the CRC of a byte followed by n zero Bytes. **/
+static uint32_t cominitCrc32Table[8][256];
+/** Makes sure the lookup tables are generated once, even if several disks are probed concurrently. **/
+static pthread_once_t cominitCrc32TableOnce = PTHREAD_ONCE_INIT;
+
+/**
+ * Generates the lookup tables for slicing-by-8.
+ */
+static void cominitCrc32InitTable(void) {
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t c = i;
+        for (int bit = 0; bit < 8; bit++) {
+            c = (c & 1) ? (c >> 1) ^ COMINIT_CRC32_POLYNOMIAL : c >> 1;
+        }
+        cominitCrc32Table[0][i] = c;
+    }
+    for (uint32_t i = 0; i < 256; i++) {
+        for (size_t n = 1; n < 8; n++) {
+            uint32_t prev = cominitCrc32Table[n - 1][i];
+            cominitCrc32Table[n][i] = (prev >> 8) ^ cominitCrc32Table[0][prev & 0xff];
+        }
+    }
+}
+
+/**
+ * Loads 4 Bytes in little-endian order independent of the alignment of @p p.
+ *
+ * @param p     The Bytes to load.
+ *
+ * @return  The loaded value
+ */
+static inline uint32_t cominitCrc32Load32(const uint8_t *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap32(v);
+#endif
+    return v;
+}
+
+uint32_t cominitCrc32(uint32_t crc, const void *buf, size_t len) {
+    const uint8_t *p = buf;
+    uint32_t c = ~crc;
+
+    pthread_once(&cominitCrc32TableOnce, cominitCrc32InitTable);
+
+    while (len >= 8) {
+        uint32_t lo = cominitCrc32Load32(p) ^ c;
+        uint32_t hi = cominitCrc32Load32(p + 4);
+        c = cominitCrc32Table[7][lo & 0xff] ^ cominitCrc32Table[6][(lo >> 8) & 0xff] ^
+            cominitCrc32Table[5][(lo >> 16) & 0xff] ^ cominitCrc32Table[4][lo >> 24] ^
+            cominitCrc32Table[3][hi & 0xff] ^ cominitCrc32Table[2][(hi >> 8) & 0xff] ^
+            cominitCrc32Table[1][(hi >> 16) & 0xff] ^ cominitCrc32Table[0][hi >> 24];
+        p += 8;
+        len -= 8;
+    }
+    while (len-- > 0) {
+        c = (c >> 8) ^ cominitCrc32Table[0][(c ^ *p++) & 0xff];
+    }
+
+    return ~c;
+}
+
+#endif
@@ -1,11 +1,19 @@
 #include "crypto.h"
 
 #include <mbedtls/ctr_drbg.h>
+#include <mbedtls/ecp.h>
 #include <mbedtls/entropy.h>
+#include <limits.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "common.h"
 #include "output.h"
+#include "sha256.h"
+#ifdef COMINIT_ROOTFS_KEY_EMBEDDED
+#include "rootfskey.h"
+#endif
 
 /** Maximum length of a string generated by mbedtls_strerror() **/
 #define COMINIT_MBEDTLS_ERR_MAX_LEN 64
@@ -17,7 +25,7 @@
 
 #define cominitMbedtlsVerify(ctx, mdAlg, hashlen, hash, sig) \
     mbedtls_rsa_rsassa_pss_verify((ctx), NULL, NULL, MBEDTLS_RSA_PUBLIC, (mdAlg), (hashlen), (hash), (sig))
-#define cominitComputeSHA256(data, dataLen, dataHash) mbedtls_sha256_ret(data, dataLen, dataHash, 0);
+#define cominitEcGroupId(pkCtx) (mbedtls_pk_ec(pkCtx)->grp.id)
 #define cominitRsaSetPadding(pkCtx, err)                                                         \
     do {                                                                                         \
         mbedtls_rsa_set_padding(mbedtls_pk_rsa(pkCtx), MBEDTLS_RSA_PKCS_V21, MBEDTLS_MD_SHA256); \
@@ -28,7 +36,7 @@
 
 #define cominitMbedtlsVerify(ctx, mdAlg, hashlen, hash, sig) \
     mbedtls_rsa_rsassa_pss_verify((ctx), (mdAlg), (hashlen), (hash), (sig))
-#define cominitComputeSHA256(data, dataLen, dataHash) mbedtls_sha256(data, dataLen, dataHash, 0);
+#define cominitEcGroupId(pkCtx) (mbedtls_pk_ec(pkCtx)->MBEDTLS_PRIVATE(grp).id)
 #define cominitRsaSetPadding(pkCtx, err)                                                                 \
     do {                                                                                                 \
         (err) = mbedtls_rsa_set_padding(mbedtls_pk_rsa(pkCtx), MBEDTLS_RSA_PKCS_V21, MBEDTLS_MD_SHA256); \
@@ -39,82 +47,252 @@
 
 #endif
 
+/**
+ * Structure holding a parsed public key, so it is only loaded once per boot.
+ */
+typedef struct {
+    char keyfile[PATH_MAX];               ///< The PEM file the key has been loaded from, empty if none is cached.
+    mbedtls_pk_context pkCtx;             ///< The parsed public key.
+    bool derDigestValid;                  ///< True if derDigest has already been computed.
+    unsigned char derDigest[SHA256_LEN];  ///< SHA-256 digest of the DER encoded public key.
+} cominitCryptoKey_t;
+
 /** String buffer for mbedtls_strerror **/
 static char cominitMbedtlsErrbuf[COMINIT_MBEDTLS_ERR_MAX_LEN];
+/** The public key used by the last operation. **/
+static cominitCryptoKey_t cominitCryptoKeyCache;
 
-int cominitCryptoVerifySignature(const uint8_t *data, size_t dataLen, const uint8_t *signature, const char *keyfile) {
-    int err = 0;
-    mbedtls_pk_context pkCtx;
-    mbedtls_pk_init(&pkCtx);
-    err = mbedtls_pk_parse_public_keyfile(&pkCtx, keyfile);
+/**
+ * Sets up the public key compiled in via `-DROOTFS_KEY_EMBED=<pem>` from its raw RSA parameters.
+ *
+ * @param key  The key structure to set up. Its pkCtx member must have been initialized.
+ *
+ * @return  0 on success, -1 otherwise
+ */
+static int cominitCryptoSetupEmbeddedKey(cominitCryptoKey_t *key) {
+#ifdef COMINIT_ROOTFS_KEY_EMBEDDED
+    int err = mbedtls_pk_setup(&key->pkCtx, mbedtls_pk_info_from_type(MBEDTLS_PK_RSA));
+    if (err == 0) {
+        err = mbedtls_rsa_import_raw(mbedtls_pk_rsa(key->pkCtx), cominitRootfsKeyModulus, cominitRootfsKeyModulusLen,
+                                     NULL, 0, NULL, 0, NULL, 0, cominitRootfsKeyExponent, cominitRootfsKeyExponentLen);
+    }
+    if (err == 0) {
+        err = mbedtls_rsa_complete(mbedtls_pk_rsa(key->pkCtx));
+    }
+    if (err == 0) {
+        err = mbedtls_rsa_check_pubkey(mbedtls_pk_rsa(key->pkCtx));
+    }
     if (err != 0) {
         mbedtls_strerror(err, cominitMbedtlsErrbuf, sizeof(cominitMbedtlsErrbuf));
-        cominitErrPrint("Parsing of public key \'%s\' failed. %s", keyfile, cominitMbedtlsErrbuf);
-        mbedtls_pk_free(&pkCtx);
+        cominitErrPrint("Setup of built-in public key failed. %s", cominitMbedtlsErrbuf);
         return -1;
     }
-    mbedtls_pk_type_t keyType = mbedtls_pk_get_type(&pkCtx);
-    if (keyType == MBEDTLS_PK_NONE) {
+    memcpy(key->derDigest, cominitRootfsKeyDerDigest, SHA256_LEN);
+    key->derDigestValid = true;
+    return 0;
+#else
+    COMINIT_PARAM_UNUSED(key);
+    cominitErrPrint("cominit has been built without a built-in public key.");
+    return -1;
+#endif
+}
+
+/**
+ * Gets the parsed public key from a PEM file or the built-in key if \a keyfile is #COMINIT_CRYPTO_EMBEDDED_KEY.
+ *
+ * The file is only read and parsed on first use, later calls for the same file return the cached key until
+ * cominitCryptoReleaseKey() is called.
+ *
+ * @param keyfile  The path to the public key PEM-file.
+ *
+ * @return  Pointer to the cached key on success, NULL otherwise
+ */
+static cominitCryptoKey_t *cominitCryptoLoadKey(const char *keyfile) {
+    cominitCryptoKey_t *key = &cominitCryptoKeyCache;
+
+    if (key->keyfile[0] != '\0' && strcmp(key->keyfile, keyfile) == 0) {
+        return key;
+    }
+    if (strlen(keyfile) >= sizeof(key->keyfile)) {
+        cominitErrPrint("Path of public key \'%s\' too long.", keyfile);
+        return NULL;
+    }
+    cominitCryptoReleaseKey();
+
+    mbedtls_pk_init(&key->pkCtx);
+    key->derDigestValid = false;
+    if (strcmp(keyfile, COMINIT_CRYPTO_EMBEDDED_KEY) == 0) {
+        if (cominitCryptoSetupEmbeddedKey(key) == -1) {
+            mbedtls_pk_free(&key->pkCtx);
+            return NULL;
+        }
+    } else {
+        int err = mbedtls_pk_parse_public_keyfile(&key->pkCtx, keyfile);
+        if (err != 0) {
+            mbedtls_strerror(err, cominitMbedtlsErrbuf, sizeof(cominitMbedtlsErrbuf));
+            cominitErrPrint("Parsing of public key \'%s\' failed. %s", keyfile, cominitMbedtlsErrbuf);
+            mbedtls_pk_free(&key->pkCtx);
+            return NULL;
+        }
+    }
+    if (mbedtls_pk_get_type(&key->pkCtx) == MBEDTLS_PK_NONE) {
         cominitErrPrint("Could not get type of public key \'%s\'.", keyfile);
-        mbedtls_pk_free(&pkCtx);
-        return -1;
+        mbedtls_pk_free(&key->pkCtx);
+        return NULL;
     }
     cominitInfoPrint("Keyfile \'%s\' successfully loaded.", keyfile);
-    if (mbedtls_pk_can_do(&pkCtx, MBEDTLS_PK_RSA) == 0) {
-        cominitErrPrint("The keyfile \'%s\' did not contain a valid RSA public key.", keyfile);
-        mbedtls_pk_free(&pkCtx);
+    strcpy(key->keyfile, keyfile);
+
+    return key;
+}
+
+void cominitCryptoReleaseKey(void) {
+    cominitCryptoKey_t *key = &cominitCryptoKeyCache;
+
+    if (key->keyfile[0] != '\0') {
+        mbedtls_pk_free(&key->pkCtx);
+        key->keyfile[0] = '\0';
+        key->derDigestValid = false;
+    }
+}
+
+/**
+ * Verifies a sha256/RSASSA-PSS signature with a cached RSA public key.
+ *
+ * @param key        The public key.
+ * @param dataHash   The SHA-256 digest of the signed data.
+ * @param signature  The signature.
+ * @param sigLen     The amount of Bytes available in \a signature, must be at least the length of the key.
+ *
+ * @return  0 on verification success, -1 otherwise
+ */
+static int cominitCryptoVerifyRsaPss(cominitCryptoKey_t *key, const uint8_t *dataHash, const uint8_t *signature,
+                                     size_t sigLen) {
+    int err = 0;
+    if (mbedtls_pk_can_do(&key->pkCtx, MBEDTLS_PK_RSA) == 0) {
+        cominitErrPrint("The keyfile \'%s\' did not contain a valid RSA public key.", key->keyfile);
+        return -1;
+    }
+    if (sigLen < mbedtls_pk_get_len(&key->pkCtx)) {
+        cominitErrPrint("Signature is shorter than the %zu Bytes of RSA public key \'%s\'.",
+                        mbedtls_pk_get_len(&key->pkCtx), key->keyfile);
         return -1;
     }
 
-    cominitRsaSetPadding(pkCtx, err);
+    cominitRsaSetPadding(key->pkCtx, err);
     if (err != 0) {
         mbedtls_strerror(err, cominitMbedtlsErrbuf, sizeof(cominitMbedtlsErrbuf));
         cominitErrPrint("Could not set RSASSA-PSS-compatible padding for RSA context. %s", cominitMbedtlsErrbuf);
-        mbedtls_pk_free(&pkCtx);
         return -1;
     }
 
-    uint8_t dataHash[32];
-    err = cominitComputeSHA256(data, dataLen, dataHash);
-
+    err = cominitMbedtlsVerify(mbedtls_pk_rsa(key->pkCtx), MBEDTLS_MD_SHA256, SHA256_LEN, dataHash, signature);
     if (err != 0) {
         mbedtls_strerror(err, cominitMbedtlsErrbuf, sizeof(cominitMbedtlsErrbuf));
-        cominitErrPrint("Could not calculate sha256 hash of input data. %s", cominitMbedtlsErrbuf);
-        mbedtls_pk_free(&pkCtx);
+        cominitErrPrint("Signature verification failed. %s", cominitMbedtlsErrbuf);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Verifies a DER encoded sha256/ECDSA signature with a cached P-256 public key.
+ *
+ * @param key        The public key.
+ * @param dataHash   The SHA-256 digest of the signed data.
+ * @param signature  The DER encoded signature. Trailing Bytes after the DER structure are ignored.
+ * @param sigLen     The amount of Bytes available in \a signature.
+ *
+ * @return  0 on verification success, -1 otherwise
+ */
+static int cominitCryptoVerifyEcdsaP256(cominitCryptoKey_t *key, const uint8_t *dataHash, const uint8_t *signature,
+                                        size_t sigLen) {
+    if (mbedtls_pk_can_do(&key->pkCtx, MBEDTLS_PK_ECDSA) == 0 ||
+        cominitEcGroupId(key->pkCtx) != MBEDTLS_ECP_DP_SECP256R1) {
+        cominitErrPrint("The keyfile \'%s\' did not contain a valid ECDSA P-256 public key.", key->keyfile);
         return -1;
     }
-    err = cominitMbedtlsVerify(mbedtls_pk_rsa(pkCtx), MBEDTLS_MD_SHA256, sizeof(dataHash), dataHash, signature);
+    // A P-256 signature is a SEQUENCE of two INTEGERs short enough to always use the short length form.
+    if (sigLen < 2 || signature[0] != 0x30 || signature[1] >= 0x80 || signature[1] > sigLen - 2) {
+        cominitErrPrint("Malformed ECDSA signature.");
+        return -1;
+    }
+
+    int err = mbedtls_pk_verify(&key->pkCtx, MBEDTLS_MD_SHA256, dataHash, SHA256_LEN, signature,
+                                (size_t)signature[1] + 2);
     if (err != 0) {
         mbedtls_strerror(err, cominitMbedtlsErrbuf, sizeof(cominitMbedtlsErrbuf));
         cominitErrPrint("Signature verification failed. %s", cominitMbedtlsErrbuf);
-        mbedtls_pk_free(&pkCtx);
         return -1;
     }
-    mbedtls_pk_free(&pkCtx);
     return 0;
 }
 
+int cominitCryptoComputeSHA256(const uint8_t *data, size_t dataLen, uint8_t *digest) {
+    if ((data == NULL && dataLen > 0) || digest == NULL) {
+        cominitErrPrint("Invalid parameters");
+        return -1;
+    }
+    cominitSha256(data, dataLen, digest);
+    return 0;
+}
+
+int cominitCryptoVerifyDigestAlg(const uint8_t *dataHash, const uint8_t *signature, size_t sigLen,
+                                 cominitCryptoSigAlgE_t sigAlg, const char *keyfile) {
+    cominitCryptoKey_t *key = cominitCryptoLoadKey(keyfile);
+    if (key == NULL) {
+        return -1;
+    }
+
+    switch (sigAlg) {
+        case COMINIT_CRYPTO_SIGALG_RSA_PSS:
+            return cominitCryptoVerifyRsaPss(key, dataHash, signature, sigLen);
+        case COMINIT_CRYPTO_SIGALG_ECDSA_P256:
+            return cominitCryptoVerifyEcdsaP256(key, dataHash, signature, sigLen);
+        default:
+            cominitErrPrint("Unsupported signature algorithm %d.", (int)sigAlg);
+            return -1;
+    }
+}
+
+int cominitCryptoVerifySignatureAlg(const uint8_t *data, size_t dataLen, const uint8_t *signature, size_t sigLen,
+                                    cominitCryptoSigAlgE_t sigAlg, const char *keyfile) {
+    uint8_t dataHash[SHA256_LEN];
+    if (cominitCryptoComputeSHA256(data, dataLen, dataHash) == -1) {
+        return -1;
+    }
+    return cominitCryptoVerifyDigestAlg(dataHash, signature, sigLen, sigAlg, keyfile);
+}
+
+int cominitCryptoVerifySignature(const uint8_t *data, size_t dataLen, const uint8_t *signature, const char *keyfile) {
+    cominitCryptoKey_t *key = cominitCryptoLoadKey(keyfile);
+    if (key == NULL) {
+        return -1;
+    }
+    return cominitCryptoVerifySignatureAlg(data, dataLen, signature, mbedtls_pk_get_len(&key->pkCtx),
+                                           COMINIT_CRYPTO_SIGALG_RSA_PSS, keyfile);
+}
+
 int cominitCreateSHA256DigestfromKeyfile(const char *keyfile, unsigned char *digest, size_t digestLen) {
     int result = EXIT_FAILURE;
 
     if (keyfile == NULL || digest == NULL || digestLen < SHA256_LEN) {
         cominitErrPrint("Invalid parameters");
     } else {
-        mbedtls_pk_context pkCtx;
-        mbedtls_pk_init(&pkCtx);
-        int err = mbedtls_pk_parse_public_keyfile(&pkCtx, keyfile);
-        if (err == 0) {
+        cominitCryptoKey_t *key = cominitCryptoLoadKey(keyfile);
+        if (key != NULL && !key->derDigestValid) {
             unsigned char der[DER_BUFFER_SIZE] = {0};
-            int derLen = mbedtls_pk_write_pubkey_der(&pkCtx, der, sizeof(der));
+            int derLen = mbedtls_pk_write_pubkey_der(&key->pkCtx, der, sizeof(der));
             if (derLen > 0) {
                 const unsigned char *pubKeyDer = der + sizeof(der) - derLen;
-                err = cominitComputeSHA256(pubKeyDer, (size_t)derLen, digest);
-                if (err == 0) {
-                    result = EXIT_SUCCESS;
-                }
+                cominitSha256(pubKeyDer, (size_t)derLen, key->derDigest);
+                key->derDigestValid = true;
             }
         }
-        mbedtls_pk_free(&pkCtx);
+        if (key != NULL && key->derDigestValid) {
+            memcpy(digest, key->derDigest, SHA256_LEN);
+            result = EXIT_SUCCESS;
+        }
     }
 
     return result;
@@ -139,10 +317,8 @@ static int cominitCryptoCreateUniqueString(unsigned char *uniqueString) {
         if (fgets(buffer, sizeof(buffer), file)) {
             size_t n = strcspn(buffer, "\r\n");
             buffer[n] = '\0';
-            int err = cominitComputeSHA256((const unsigned char *)buffer, strlen(buffer), uniqueString);
-            if (err == 0) {
-                result = EXIT_SUCCESS;
-            }
+            cominitSha256(buffer, strlen(buffer), uniqueString);
+            result = EXIT_SUCCESS;
         }
         fclose(file);
     }
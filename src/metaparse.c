@@ -0,0 +1,829 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file metaparse.c
+ * @brief Implementation of parsing the partition metadata string.
+ */
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "keyring.h"
+#include "meta.h"
+#include "output.h"
+
+#define COMINIT_ROOTFS_FEATURE_NONE "none"  ///< Human-readable string indicating no use of device mapper features.
+#define COMINIT_ROOTFS_FEATURE_VERITY "dm-verity"        ///< Human-readable string indicating use of dm-verity.
+#define COMINIT_ROOTFS_FEATURE_INTEGRITY "dm-integrity"  ///< Human-readable string indicating use of dm-integrity.
+#define COMINIT_ROOTFS_FEATURE_CRYPT "dm-crypt"          ///< Human-readable string indicating use of dm-crypt.
+
+/** Number of `\xFF` separated blocks in the data part of the metadata: settings, verity/integrity and crypt. **/
+#define COMINIT_META_BLOCK_COUNT 3
+/** Index of the settings block. **/
+#define COMINIT_META_BLOCK_SETTINGS 0
+/** Index of the dm-verity/dm-integrity table block. **/
+#define COMINIT_META_BLOCK_VERINT 1
+/** Maximum number of space separated fields in one block. **/
+#define COMINIT_META_FIELDS_MAX 64
+
+/**
+ * A field of the metadata string, pointing into the string without copying it.
+ */
+typedef struct {
+    const char *str;  ///< Start of the field, not null-terminated.
+    size_t len;       ///< Length of the field in Bytes.
+} cominitMetaField_t;
+
+/**
+ * Position and length of all fields of the metadata string, recorded in a single pass by cominitIndexMetadata().
+ */
+typedef struct {
+    cominitMetaField_t field[COMINIT_META_BLOCK_COUNT][COMINIT_META_FIELDS_MAX];  ///< The fields of each block.
+    size_t count[COMINIT_META_BLOCK_COUNT];                                       ///< Number of fields of each block.
+} cominitMetaIndex_t;
+
+/**
+ * A record of binary metadata, pointing into the data block without copying it.
+ */
+typedef struct {
+    uint16_t type;         ///< The record type, see cominitMetaRecordE_t.
+    uint16_t len;          ///< Length of the value in Bytes.
+    const uint8_t *value;  ///< Start of the value.
+} cominitMetaRecord_t;
+
+/**
+ * The records of binary metadata, collected in a single pass by cominitIndexMetadataBin().
+ */
+typedef struct {
+    cominitMetaRecord_t first[COMINIT_META_REC_COUNT];  ///< The first record of each type, len and value are 0 if
+                                                        ///< there is none.
+    size_t count[COMINIT_META_REC_COUNT];               ///< Number of records of each type.
+    const uint8_t *records;                             ///< Start of the records after the header.
+    size_t len;                                         ///< Size of all records in Bytes.
+} cominitMetaRecordIndex_t;
+
+/**
+ * Mapping of the crypt field values to the device mapper features.
+ */
+static const struct {
+    const char *name;          ///< Value of the crypt field.
+    cominitCryptOpt_t crypt;   ///< The features to use.
+} cominitMetaCryptOpts[] = {
+    {"plain", COMINIT_CRYPTOPT_NONE},
+    {"verity", COMINIT_CRYPTOPT_VERITY},
+    {"integrity", COMINIT_CRYPTOPT_INTEGRITY},
+    {"crypt", COMINIT_CRYPTOPT_CRYPT},
+    {"crypt-integrity", COMINIT_CRYPTOPT_CRYPT | COMINIT_CRYPTOPT_INTEGRITY},
+    {"crypt-verity", COMINIT_CRYPTOPT_CRYPT | COMINIT_CRYPTOPT_VERITY},
+};
+
+/** The dm-integrity options which may reference a key from the Kernel keyring. **/
+static const char *const cominitMetaKeyOpts[] = {"internal_hash:", "journal_crypt:", "journal_mac:"};
+
+/**
+ * Record the position and length of all fields of a metadata string.
+ *
+ * Blocks are separated by `\xFF`, fields within a block by one or more spaces. The string is not modified.
+ *
+ * @param idx      The index to fill.
+ * @param metaStr  The null-terminated metadata string.
+ *
+ * @return  0 on success, -1 otherwise
+ */
+static int cominitIndexMetadata(cominitMetaIndex_t *idx, const char *metaStr);
+/**
+ * Check if a field is equal to a null-terminated string.
+ *
+ * @param field  The field to compare.
+ * @param str    The string to compare to.
+ *
+ * @return  true if equal, false otherwise
+ */
+static inline bool cominitMetaFieldEquals(const cominitMetaField_t *field, const char *str);
+/**
+ * Append Bytes to a null-terminated device mapper table.
+ *
+ * @param tbl   The device mapper table of #COMINIT_DM_TABLE_SIZE_MAX Bytes.
+ * @param pos   Current length of \a tbl, is increased by \a len.
+ * @param str   The Bytes to append.
+ * @param len   The amount of Bytes to append.
+ *
+ * @return  0 on success, -1 if \a tbl is too small
+ */
+static int cominitMetaTblAppend(char *tbl, size_t *pos, const char *str, size_t len);
+/**
+ * Generate a device mapper table from dm-verity partition metadata.
+ *
+ * Given the fields of the first device mapper table part of the partition metadata (see README.md), construct
+ * cominitRfsMetaData_t::dmTableVerint in \a meta accordingly. Called by cominitParseMetadata() if the partition uses
+ * dm-verity.
+ *
+ * @param meta    The metadata structure to hold the device mapper table string to be generated.
+ * @param fields  The fields of the first device mapper table part from the metadata string.
+ * @param count   The number of elements in \a fields.
+ *
+ * @return  0 on success, -1 otherwise
+ */
+static int cominitGenVerityDmTbl(cominitRfsMetaData_t *meta, const cominitMetaField_t *fields, size_t count);
+/**
+ * Generate a device mapper table from dm-integrity partition metadata.
+ *
+ * Given the fields of the first device mapper table part of the partition metadata (see README.md), construct
+ * cominitRfsMetaData_t::dmTableVerint in \a meta accordingly. Called by cominitParseMetadata() if the partition uses
+ * dm-integrity.
+ *
+ * @param meta    The metadata structure to hold the device mapper table string to be generated.
+ * @param fields  The fields of the first device mapper table part from the metadata string.
+ * @param count   The number of elements in \a fields.
+ *
+ * @return  0 on success, -1 otherwise
+ */
+static int cominitGenIntegrityDmTbl(cominitRfsMetaData_t *meta, const cominitMetaField_t *fields, size_t count);
+/**
+ * Check the combination of device mapper features and print the settings of the rootfs.
+ *
+ * @param meta  The metadata structure filled from the settings of the metadata.
+ *
+ * @return  0 on success, -1 otherwise
+ */
+static int cominitMetaCheckSettings(const cominitRfsMetaData_t *meta);
+/**
+ * Append a key from the Kernel keyring in hexadecimal to a null-terminated device mapper table.
+ *
+ * @param tbl         The device mapper table of #COMINIT_DM_TABLE_SIZE_MAX Bytes.
+ * @param pos         Current length of \a tbl, is increased by the length of the key in hexadecimal.
+ * @param keyDesc     The description of the key, not null-terminated.
+ * @param keyDescLen  The length of \a keyDesc in Bytes.
+ *
+ * @return  0 on success, -1 otherwise
+ */
+static int cominitMetaTblAppendKey(char *tbl, size_t *pos, const char *keyDesc, size_t keyDescLen);
+/**
+ * Read an unsigned little-endian integer.
+ *
+ * @param p  The first Byte of the integer.
+ * @param n  The size of the integer in Bytes, at most 8.
+ *
+ * @return  The integer value
+ */
+static inline uint64_t cominitMetaGetLe(const uint8_t *p, size_t n);
+/**
+ * Check if a string value of binary metadata can be used as a device mapper table argument.
+ *
+ * @param str  The string, not null-terminated.
+ * @param len  The length of \a str in Bytes.
+ *
+ * @return  true if \a str is non-empty and only consists of printable ASCII characters except space, false otherwise
+ */
+static bool cominitMetaIsArg(const uint8_t *str, size_t len);
+/**
+ * Get the next record of binary metadata.
+ *
+ * @param rec      Return pointer for the record.
+ * @param records  The records of the binary metadata.
+ * @param len      The size of \a records in Bytes.
+ * @param pos      Offset of the next record in \a records, is advanced behind it.
+ *
+ * @return  1 if a record has been returned, 0 at the end of the records, -1 if the record is truncated
+ */
+static int cominitMetaNextRecord(cominitMetaRecord_t *rec, const uint8_t *records, size_t len, size_t *pos);
+/**
+ * Collect the records of binary metadata and check their sizes.
+ *
+ * Apart from the option records, every record type may only occur once.
+ *
+ * @param idx   The index to fill.
+ * @param data  The data block starting with the binary metadata header.
+ * @param len   The size of \a data in Bytes.
+ *
+ * @return  0 on success, -1 otherwise
+ */
+static int cominitIndexMetadataBin(cominitMetaRecordIndex_t *idx, const uint8_t *data, size_t len);
+/**
+ * Generate a device mapper table from dm-verity records of binary metadata.
+ *
+ * @param meta  The metadata structure to hold the device mapper table string to be generated.
+ * @param idx   The records of the binary metadata.
+ *
+ * @return  0 on success, -1 otherwise
+ */
+static int cominitGenVerityDmTblBin(cominitRfsMetaData_t *meta, const cominitMetaRecordIndex_t *idx);
+/**
+ * Generate a device mapper table from dm-integrity records of binary metadata.
+ *
+ * @param meta  The metadata structure to hold the device mapper table string to be generated.
+ * @param idx   The records of the binary metadata.
+ *
+ * @return  0 on success, -1 otherwise
+ */
+static int cominitGenIntegrityDmTblBin(cominitRfsMetaData_t *meta, const cominitMetaRecordIndex_t *idx);
+
+int cominitParseMetadata(cominitRfsMetaData_t *meta, const char *metaStr) {
+    cominitMetaIndex_t idx;
+
+    if (meta == NULL || metaStr == NULL) {
+        cominitErrPrint("Input parameters must not be NULL.");
+        return -1;
+    }
+    if (cominitIndexMetadata(&idx, metaStr) == -1) {
+        return -1;
+    }
+
+    const cominitMetaField_t *settings = idx.field[COMINIT_META_BLOCK_SETTINGS];
+    size_t settingsCount = idx.count[COMINIT_META_BLOCK_SETTINGS];
+    size_t pos = 0;
+
+    // Check metadata version, jump over it and the signature algorithm (checked before verification)
+    if (settingsCount == 0) {
+        cominitErrPrint("Unexpected end of metadata string.");
+        return -1;
+    }
+    if (cominitMetaFieldEquals(&settings[0], COMINIT_PART_META_DATA_VERSION)) {
+        pos = 2;
+    } else if (cominitMetaFieldEquals(&settings[0], COMINIT_PART_META_DATA_VERSION_V1)) {
+        pos = 1;
+    } else {
+        cominitErrPrint("Wrong format of partition metadata.");
+        return -1;
+    }
+    if (settingsCount < pos + 3) {
+        cominitErrPrint("Unexpected end of metadata string.");
+        return -1;
+    }
+    const cominitMetaField_t *fsType = &settings[pos];
+    const cominitMetaField_t *mode = &settings[pos + 1];
+    const cominitMetaField_t *crypt = &settings[pos + 2];
+
+    size_t fsTypeLen = (fsType->len < sizeof(meta->fsType)) ? fsType->len : sizeof(meta->fsType) - 1;
+    memcpy(meta->fsType, fsType->str, fsTypeLen);
+    meta->fsType[fsTypeLen] = '\0';
+
+    if (cominitMetaFieldEquals(mode, "ro")) {
+        meta->ro = true;
+    } else if (cominitMetaFieldEquals(mode, "rw")) {
+        meta->ro = false;
+    } else {
+        cominitErrPrint("Unsupported value for filesystem mode: \'%.*s\'. Must be 'ro' or 'rw'.", (int)mode->len,
+                        mode->str);
+        return -1;
+    }
+
+    size_t i = 0;
+    while (i < ARRAY_SIZE(cominitMetaCryptOpts) && !cominitMetaFieldEquals(crypt, cominitMetaCryptOpts[i].name)) {
+        i++;
+    }
+    if (i == ARRAY_SIZE(cominitMetaCryptOpts)) {
+        cominitErrPrint("Unsupported value for crypt type: \'%.*s\'.", (int)crypt->len, crypt->str);
+        return -1;
+    }
+    meta->crypt = cominitMetaCryptOpts[i].crypt;
+
+    if (cominitMetaCheckSettings(meta) == -1) {
+        return -1;
+    }
+
+    // Default case (plain) means two empty strings as device mapper tables.
+    meta->dmTableVerint[0] = '\0';
+    meta->dmTableCrypt[0] = '\0';
+
+    const cominitMetaField_t *verint = idx.field[COMINIT_META_BLOCK_VERINT];
+    size_t verintCount = idx.count[COMINIT_META_BLOCK_VERINT];
+    if (meta->crypt == COMINIT_CRYPTOPT_VERITY && cominitGenVerityDmTbl(meta, verint, verintCount) == -1) {
+        cominitErrPrint("Could not generate device mapper table for dm-verity rootfs.");
+        return -1;
+    }
+
+    if (meta->crypt == COMINIT_CRYPTOPT_INTEGRITY && cominitGenIntegrityDmTbl(meta, verint, verintCount) == -1) {
+        cominitErrPrint("Could not generate device mapper table for dm-integrity rootfs.");
+        return -1;
+    }
+
+    if (meta->crypt & COMINIT_CRYPTOPT_CRYPT) {
+        cominitErrPrint("Support for dm-crypt not yet available.");
+        return -1;
+    }
+    return 0;
+}
+
+static int cominitIndexMetadata(cominitMetaIndex_t *idx, const char *metaStr) {
+    size_t block = 0;
+    const char *c = metaStr;
+
+    memset(idx->count, 0, sizeof(idx->count));
+    for (;;) {
+        // further `\xFF` are kept within the last block, which is not interpreted yet
+        const char *delim = (block < COMINIT_META_BLOCK_COUNT - 1) ? " \xFF" : " ";
+        c += strspn(c, " ");
+        size_t len = strcspn(c, delim);
+        if (len > 0) {
+            if (idx->count[block] == COMINIT_META_FIELDS_MAX) {
+                cominitErrPrint("Too many fields in metadata string.");
+                return -1;
+            }
+            idx->field[block][idx->count[block]].str = c;
+            idx->field[block][idx->count[block]].len = len;
+            idx->count[block]++;
+            c += len;
+        }
+        if (*c == '\0') {
+            break;
+        }
+        if (*c == (char)0xFF) {
+            block++;
+        }
+        c++;
+    }
+
+    if (block < COMINIT_META_BLOCK_COUNT - 1) {
+        cominitErrPrint("Unexpected end of metadata string.");
+        return -1;
+    }
+    return 0;
+}
+
+static inline bool cominitMetaFieldEquals(const cominitMetaField_t *field, const char *str) {
+    return strncmp(field->str, str, field->len) == 0 && str[field->len] == '\0';
+}
+
+static int cominitMetaTblAppend(char *tbl, size_t *pos, const char *str, size_t len) {
+    if (len >= COMINIT_DM_TABLE_SIZE_MAX - *pos) {
+        cominitErrPrint("Device mapper table size too large.");
+        return -1;
+    }
+    memcpy(tbl + *pos, str, len);
+    *pos += len;
+    tbl[*pos] = '\0';
+    return 0;
+}
+
+static int cominitGenVerityDmTbl(cominitRfsMetaData_t *meta, const cominitMetaField_t *fields, size_t count) {
+    size_t devPathLen = strlen(meta->devicePath);
+    size_t pos = 0;
+
+    // <version> <data_block_size> <hash_block_size> <num_data_blocks> <hash_start_block> <algorithm> ...
+    if (count < 6) {
+        cominitErrPrint("Unexpected end of metadata string.");
+        return -1;
+    }
+
+    // the version is followed by the data and hash device
+    if (cominitMetaTblAppend(meta->dmTableVerint, &pos, fields[0].str, fields[0].len) == -1 ||
+        cominitMetaTblAppend(meta->dmTableVerint, &pos, " ", 1) == -1 ||
+        cominitMetaTblAppend(meta->dmTableVerint, &pos, meta->devicePath, devPathLen) == -1 ||
+        cominitMetaTblAppend(meta->dmTableVerint, &pos, " ", 1) == -1 ||
+        cominitMetaTblAppend(meta->dmTableVerint, &pos, meta->devicePath, devPathLen) == -1) {
+        return -1;
+    }
+    for (size_t i = 1; i < count; i++) {
+        if (cominitMetaTblAppend(meta->dmTableVerint, &pos, " ", 1) == -1 ||
+            cominitMetaTblAppend(meta->dmTableVerint, &pos, fields[i].str, fields[i].len) == -1) {
+            return -1;
+        }
+    }
+
+    // data block size times number of data blocks is the dm volume data size
+    meta->dmVerintDataSizeBytes = strtoull(fields[1].str, NULL, 10) * strtoull(fields[3].str, NULL, 10);
+
+    cominitInfoPrint("dm-verity hash algorithm: %.*s", (int)fields[5].len, fields[5].str);
+    return 0;
+}
+
+static int cominitGenIntegrityDmTbl(cominitRfsMetaData_t *meta, const cominitMetaField_t *fields, size_t count) {
+    char numArgs[24];
+    size_t pos = 0;
+
+    // <num_data_blocks> <data_block_size> <num_additional_args> <additional> [<arguments> ... ]
+    if (count < 4) {
+        cominitErrPrint("Unexpected end of metadata string.");
+        return -1;
+    }
+    const cominitMetaField_t *blksize = &fields[1];
+    meta->dmVerintDataSizeBytes = strtoull(fields[0].str, NULL, 10) * strtoull(blksize->str, NULL, 10);
+
+    // the data_blocks option is generated in addition to the ones from the metadata
+    int n = snprintf(numArgs, sizeof(numArgs), " 0 - J %lu block_size:", strtoul(fields[2].str, NULL, 10) + 1);
+    if (n < 0 || (size_t)n >= sizeof(numArgs)) {
+        cominitErrPrint("Could not format number of dm-integrity arguments.");
+        return -1;
+    }
+    if (cominitMetaTblAppend(meta->dmTableVerint, &pos, meta->devicePath, strlen(meta->devicePath)) == -1 ||
+        cominitMetaTblAppend(meta->dmTableVerint, &pos, numArgs, (size_t)n) == -1 ||
+        cominitMetaTblAppend(meta->dmTableVerint, &pos, blksize->str, blksize->len) == -1 ||
+        cominitMetaTblAppend(meta->dmTableVerint, &pos, " ", 1) == -1) {
+        return -1;
+    }
+
+    // the additional options may reference keys from the keyring, which are inserted in hexadecimal
+    for (size_t i = 3; i < count; i++) {
+        const cominitMetaField_t *opt = &fields[i];
+        size_t optLen = opt->len;
+        const char *keyDesc = NULL;
+        size_t keyDescLen = 0;
+
+        for (size_t k = 0; k < ARRAY_SIZE(cominitMetaKeyOpts); k++) {
+            size_t prefixLen = strlen(cominitMetaKeyOpts[k]);
+            if (opt->len >= prefixLen && strncmp(opt->str, cominitMetaKeyOpts[k], prefixLen) == 0) {
+                const char *alg = opt->str + prefixLen;
+                size_t algLen = 0;
+                while (prefixLen + algLen < opt->len && alg[algLen] != ':') {
+                    algLen++;
+                }
+                cominitInfoPrint("Dm-integrity algorithm for %s %.*s", cominitMetaKeyOpts[k], (int)algLen, alg);
+                for (size_t j = prefixLen; j + 1 < opt->len; j++) {
+                    if (opt->str[j] == ':' && opt->str[j + 1] == ':') {
+                        keyDesc = opt->str + j + 2;
+                        keyDescLen = opt->len - j - 2;
+                        optLen = j + 1;
+                        break;
+                    }
+                }
+                break;
+            }
+        }
+
+        if (keyDescLen > 0) {
+            if (cominitMetaTblAppend(meta->dmTableVerint, &pos, opt->str, optLen) == -1 ||
+                cominitMetaTblAppendKey(meta->dmTableVerint, &pos, keyDesc, keyDescLen) == -1) {
+                return -1;
+            }
+        } else if (cominitMetaTblAppend(meta->dmTableVerint, &pos, opt->str, opt->len) == -1) {
+            return -1;
+        }
+        if (cominitMetaTblAppend(meta->dmTableVerint, &pos, " ", 1) == -1) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int cominitMetaCheckSettings(const cominitRfsMetaData_t *meta) {
+    if ((meta->crypt & (COMINIT_CRYPTOPT_VERITY | COMINIT_CRYPTOPT_INTEGRITY)) ==
+        (COMINIT_CRYPTOPT_VERITY | COMINIT_CRYPTOPT_INTEGRITY)) {
+        cominitErrPrint("Dm-verity and dm-integrity cannot be combined.");
+        return -1;
+    }
+
+    cominitInfoPrint("Using rootfs \'%s\' with filesystem \"%s\"%s.", meta->devicePath, meta->fsType,
+                     (meta->ro) ? ", read-only" : ", read-write");
+
+    cominitInfoPrint("Rootfs cryptographic features: %s%s%s%s",
+                     (meta->crypt == COMINIT_CRYPTOPT_NONE) ? COMINIT_ROOTFS_FEATURE_NONE " " : "",
+                     (meta->crypt & COMINIT_CRYPTOPT_VERITY) ? COMINIT_ROOTFS_FEATURE_VERITY " " : "",
+                     (meta->crypt & COMINIT_CRYPTOPT_INTEGRITY) ? COMINIT_ROOTFS_FEATURE_INTEGRITY " " : "",
+                     (meta->crypt & COMINIT_CRYPTOPT_CRYPT) ? COMINIT_ROOTFS_FEATURE_CRYPT : "");
+    return 0;
+}
+
+static int cominitMetaTblAppendKey(char *tbl, size_t *pos, const char *keyDesc, size_t keyDescLen) {
+    uint8_t keyBytes[COMINIT_KEYRING_PAYLOAD_MAX_SIZE];
+    char keyHex[2 * COMINIT_KEYRING_PAYLOAD_MAX_SIZE + 1];
+    char keyDescStr[COMINIT_DM_TABLE_SIZE_MAX];
+
+    if (keyDescLen >= sizeof(keyDescStr)) {
+        cominitErrPrint("Key description \'%.*s\' is too long.", (int)keyDescLen, keyDesc);
+        return -1;
+    }
+    memcpy(keyDescStr, keyDesc, keyDescLen);
+    keyDescStr[keyDescLen] = '\0';
+
+    cominitInfoPrint("Dm-integrity will use key \'%s\' from Kernel keyring.", keyDescStr);
+    ssize_t keyLen = cominitKeyringGetKey(keyBytes, COMINIT_KEYRING_PAYLOAD_MAX_SIZE, keyDescStr);
+    if (keyLen < 1) {
+        cominitErrPrint("Could not get key payload for key \'%s\'.", keyDescStr);
+        return -1;
+    }
+    if (cominitCommonBytesToHex(keyHex, keyBytes, keyLen) == -1) {
+        cominitErrPrint("Could not convert key payload to hexadecimal format.");
+        return -1;
+    }
+    return cominitMetaTblAppend(tbl, pos, keyHex, 2 * (size_t)keyLen);
+}
+
+int cominitParseMetadataBin(cominitRfsMetaData_t *meta, const uint8_t *data, size_t len) {
+    cominitMetaRecordIndex_t idx;
+
+    if (meta == NULL || data == NULL) {
+        cominitErrPrint("Input parameters must not be NULL.");
+        return -1;
+    }
+    if (cominitIndexMetadataBin(&idx, data, len) == -1) {
+        return -1;
+    }
+
+    const cominitMetaRecord_t *fsType = &idx.first[COMINIT_META_REC_FSTYPE];
+    const cominitMetaRecord_t *mode = &idx.first[COMINIT_META_REC_MODE];
+    const cominitMetaRecord_t *crypt = &idx.first[COMINIT_META_REC_CRYPT];
+    if (fsType->len == 0 || mode->len == 0 || crypt->len == 0) {
+        cominitErrPrint("Binary metadata needs to contain filesystem type, mode and crypt type.");
+        return -1;
+    }
+
+    if (fsType->len >= sizeof(meta->fsType) || !cominitMetaIsArg(fsType->value, fsType->len)) {
+        cominitErrPrint("Invalid filesystem type in binary metadata.");
+        return -1;
+    }
+    memcpy(meta->fsType, fsType->value, fsType->len);
+    meta->fsType[fsType->len] = '\0';
+
+    if (mode->value[0] > 1) {
+        cominitErrPrint("Unsupported value for filesystem mode: %u. Must be 1 (ro) or 0 (rw).", mode->value[0]);
+        return -1;
+    }
+    meta->ro = (mode->value[0] == 1);
+
+    if ((crypt->value[0] & ~(COMINIT_CRYPTOPT_VERITY | COMINIT_CRYPTOPT_INTEGRITY | COMINIT_CRYPTOPT_CRYPT)) != 0) {
+        cominitErrPrint("Unsupported value for crypt type: 0x%02x.", crypt->value[0]);
+        return -1;
+    }
+    meta->crypt = (cominitCryptOpt_t)crypt->value[0];
+
+    if (cominitMetaCheckSettings(meta) == -1) {
+        return -1;
+    }
+
+    // Default case (plain) means two empty strings as device mapper tables.
+    meta->dmTableVerint[0] = '\0';
+    meta->dmTableCrypt[0] = '\0';
+
+    if (meta->crypt == COMINIT_CRYPTOPT_VERITY && cominitGenVerityDmTblBin(meta, &idx) == -1) {
+        cominitErrPrint("Could not generate device mapper table for dm-verity rootfs.");
+        return -1;
+    }
+
+    if (meta->crypt == COMINIT_CRYPTOPT_INTEGRITY && cominitGenIntegrityDmTblBin(meta, &idx) == -1) {
+        cominitErrPrint("Could not generate device mapper table for dm-integrity rootfs.");
+        return -1;
+    }
+
+    if (meta->crypt & COMINIT_CRYPTOPT_CRYPT) {
+        cominitErrPrint("Support for dm-crypt not yet available.");
+        return -1;
+    }
+    return 0;
+}
+
+static inline uint64_t cominitMetaGetLe(const uint8_t *p, size_t n) {
+    uint64_t v = 0;
+    while (n > 0) {
+        v = (v << 8) | p[--n];
+    }
+    return v;
+}
+
+static bool cominitMetaIsArg(const uint8_t *str, size_t len) {
+    if (len == 0) {
+        return false;
+    }
+    for (size_t i = 0; i < len; i++) {
+        if (str[i] <= ' ' || str[i] > '~') {
+            return false;
+        }
+    }
+    return true;
+}
+
+static int cominitMetaNextRecord(cominitMetaRecord_t *rec, const uint8_t *records, size_t len, size_t *pos) {
+    if (*pos == len) {
+        return 0;
+    }
+    if (len - *pos < COMINIT_PART_META_BIN_RECORD_HEADER_SIZE) {
+        cominitErrPrint("Truncated record header in binary metadata.");
+        return -1;
+    }
+    rec->type = (uint16_t)cominitMetaGetLe(records + *pos, 2);
+    rec->len = (uint16_t)cominitMetaGetLe(records + *pos + 2, 2);
+    *pos += COMINIT_PART_META_BIN_RECORD_HEADER_SIZE;
+    if (len - *pos < rec->len) {
+        cominitErrPrint("Truncated value of record %u in binary metadata.", rec->type);
+        return -1;
+    }
+    rec->value = records + *pos;
+    *pos += rec->len;
+    return 1;
+}
+
+static int cominitIndexMetadataBin(cominitMetaRecordIndex_t *idx, const uint8_t *data, size_t len) {
+    cominitMetaRecord_t rec;
+    size_t pos = 0;
+    int ret;
+
+    if (len < COMINIT_PART_META_BIN_HEADER_SIZE || data[0] != COMINIT_PART_META_DATA_VERSION_BIN ||
+        COMINIT_PART_META_BIN_HEADER_SIZE + cominitMetaGetLe(data + 2, 2) != len) {
+        cominitErrPrint("Wrong format of binary partition metadata.");
+        return -1;
+    }
+    memset(idx, 0, sizeof(*idx));
+    idx->records = data + COMINIT_PART_META_BIN_HEADER_SIZE;
+    idx->len = len - COMINIT_PART_META_BIN_HEADER_SIZE;
+
+    while ((ret = cominitMetaNextRecord(&rec, idx->records, idx->len, &pos)) == 1) {
+        size_t sizeMin = 1;
+        size_t sizeMax = UINT16_MAX;
+        bool repeatable = false;
+
+        switch (rec.type) {
+            case COMINIT_META_REC_MODE:
+            case COMINIT_META_REC_CRYPT:
+                sizeMax = 1;
+                break;
+            case COMINIT_META_REC_VERITY_PARAMS:
+                sizeMin = sizeMax = COMINIT_PART_META_BIN_VERITY_PARAMS_SIZE;
+                break;
+            case COMINIT_META_REC_INTEGRITY_PARAMS:
+                sizeMin = sizeMax = COMINIT_PART_META_BIN_INTEGRITY_PARAMS_SIZE;
+                break;
+            case COMINIT_META_REC_VERITY_SALT:
+                sizeMin = 0;
+                break;
+            case COMINIT_META_REC_VERITY_OPT:
+            case COMINIT_META_REC_INTEGRITY_OPT:
+                repeatable = true;
+                break;
+            case COMINIT_META_REC_INTEGRITY_KEY:
+                // option, length of the algorithm, algorithm and at least one character of the key description
+                if (rec.len < 2 || rec.len < 3 + rec.value[1]) {
+                    cominitErrPrint("Invalid size of record %u in binary metadata.", rec.type);
+                    return -1;
+                }
+                repeatable = true;
+                break;
+            case COMINIT_META_REC_FSTYPE:
+            case COMINIT_META_REC_VERITY_ALG:
+            case COMINIT_META_REC_VERITY_DIGEST:
+                break;
+            default:
+                cominitErrPrint("Unknown record type %u in binary metadata.", rec.type);
+                return -1;
+        }
+        if (rec.len < sizeMin || rec.len > sizeMax) {
+            cominitErrPrint("Invalid size of record %u in binary metadata.", rec.type);
+            return -1;
+        }
+        if (idx->count[rec.type] > 0 && !repeatable) {
+            cominitErrPrint("Duplicate record %u in binary metadata.", rec.type);
+            return -1;
+        }
+        if (idx->count[rec.type] == 0) {
+            idx->first[rec.type] = rec;
+        }
+        idx->count[rec.type]++;
+    }
+    return ret;
+}
+
+static int cominitGenVerityDmTblBin(cominitRfsMetaData_t *meta, const cominitMetaRecordIndex_t *idx) {
+    const cominitMetaRecord_t *params = &idx->first[COMINIT_META_REC_VERITY_PARAMS];
+    const cominitMetaRecord_t *alg = &idx->first[COMINIT_META_REC_VERITY_ALG];
+    const cominitMetaRecord_t *digest = &idx->first[COMINIT_META_REC_VERITY_DIGEST];
+    const cominitMetaRecord_t *salt = &idx->first[COMINIT_META_REC_VERITY_SALT];
+    char hex[2 * UINT8_MAX + 1];
+    char nums[128];
+    size_t pos = 0;
+
+    if (params->len == 0 || alg->len == 0 || digest->len == 0) {
+        cominitErrPrint("Binary metadata needs to contain dm-verity parameters, algorithm and root digest.");
+        return -1;
+    }
+    if (!cominitMetaIsArg(alg->value, alg->len) || digest->len > UINT8_MAX || salt->len > UINT8_MAX) {
+        cominitErrPrint("Invalid dm-verity algorithm, root digest or salt in binary metadata.");
+        return -1;
+    }
+
+    // <version> <dev> <hash_dev> <data_block_size> <hash_block_size> <num_data_blocks> <hash_start_block>
+    uint32_t version = (uint32_t)cominitMetaGetLe(params->value, 4);
+    uint32_t dataBlockSize = (uint32_t)cominitMetaGetLe(params->value + 4, 4);
+    uint32_t hashBlockSize = (uint32_t)cominitMetaGetLe(params->value + 8, 4);
+    uint64_t numDataBlocks = cominitMetaGetLe(params->value + 12, 8);
+    uint64_t hashStartBlock = cominitMetaGetLe(params->value + 20, 8);
+    int n = snprintf(nums, sizeof(nums), " %" PRIu32 " %" PRIu32 " %" PRIu64 " %" PRIu64 " ", dataBlockSize,
+                     hashBlockSize, numDataBlocks, hashStartBlock);
+    if (n < 0 || (size_t)n >= sizeof(nums)) {
+        cominitErrPrint("Could not format dm-verity parameters.");
+        return -1;
+    }
+    meta->dmVerintDataSizeBytes = (uint64_t)dataBlockSize * numDataBlocks;
+
+    int m = snprintf(meta->dmTableVerint, COMINIT_DM_TABLE_SIZE_MAX, "%" PRIu32 " %s %s", version, meta->devicePath,
+                     meta->devicePath);
+    if (m < 0 || m >= COMINIT_DM_TABLE_SIZE_MAX) {
+        cominitErrPrint("Device mapper table size too large.");
+        return -1;
+    }
+    pos = (size_t)m;
+    if (cominitMetaTblAppend(meta->dmTableVerint, &pos, nums, (size_t)n) == -1 ||
+        cominitMetaTblAppend(meta->dmTableVerint, &pos, (const char *)alg->value, alg->len) == -1 ||
+        cominitMetaTblAppend(meta->dmTableVerint, &pos, " ", 1) == -1) {
+        return -1;
+    }
+
+    // <digest> <salt>, both in hexadecimal, an empty salt is written as '-'
+    if (cominitCommonBytesToHex(hex, digest->value, digest->len) == -1 ||
+        cominitMetaTblAppend(meta->dmTableVerint, &pos, hex, strlen(hex)) == -1 ||
+        cominitMetaTblAppend(meta->dmTableVerint, &pos, " ", 1) == -1) {
+        return -1;
+    }
+    if (salt->len > 0) {
+        if (cominitCommonBytesToHex(hex, salt->value, salt->len) == -1) {
+            return -1;
+        }
+    } else {
+        strcpy(hex, "-");
+    }
+    if (cominitMetaTblAppend(meta->dmTableVerint, &pos, hex, strlen(hex)) == -1) {
+        return -1;
+    }
+
+    // [<#opt_params> <opt_params>]
+    size_t optCount = idx->count[COMINIT_META_REC_VERITY_OPT];
+    if (optCount > 0) {
+        n = snprintf(nums, sizeof(nums), " %zu", optCount);
+        if (n < 0 || (size_t)n >= sizeof(nums) ||
+            cominitMetaTblAppend(meta->dmTableVerint, &pos, nums, (size_t)n) == -1) {
+            return -1;
+        }
+        cominitMetaRecord_t rec;
+        size_t recPos = 0;
+        while (cominitMetaNextRecord(&rec, idx->records, idx->len, &recPos) == 1) {
+            if (rec.type != COMINIT_META_REC_VERITY_OPT) {
+                continue;
+            }
+            if (!cominitMetaIsArg(rec.value, rec.len)) {
+                cominitErrPrint("Invalid dm-verity option in binary metadata.");
+                return -1;
+            }
+            if (cominitMetaTblAppend(meta->dmTableVerint, &pos, " ", 1) == -1 ||
+                cominitMetaTblAppend(meta->dmTableVerint, &pos, (const char *)rec.value, rec.len) == -1) {
+                return -1;
+            }
+        }
+    }
+
+    cominitInfoPrint("dm-verity hash algorithm: %.*s", (int)alg->len, (const char *)alg->value);
+    return 0;
+}
+
+static int cominitGenIntegrityDmTblBin(cominitRfsMetaData_t *meta, const cominitMetaRecordIndex_t *idx) {
+    const cominitMetaRecord_t *params = &idx->first[COMINIT_META_REC_INTEGRITY_PARAMS];
+    size_t pos = 0;
+
+    if (params->len == 0) {
+        cominitErrPrint("Binary metadata needs to contain dm-integrity parameters.");
+        return -1;
+    }
+    uint64_t numDataBlocks = cominitMetaGetLe(params->value, 8);
+    uint32_t blockSize = (uint32_t)cominitMetaGetLe(params->value + 8, 4);
+    meta->dmVerintDataSizeBytes = numDataBlocks * blockSize;
+
+    // the block_size option is generated in addition to the ones from the metadata
+    size_t numArgs = idx->count[COMINIT_META_REC_INTEGRITY_OPT] + idx->count[COMINIT_META_REC_INTEGRITY_KEY] + 1;
+    int n = snprintf(meta->dmTableVerint, COMINIT_DM_TABLE_SIZE_MAX, "%s 0 - J %zu block_size:%" PRIu32 " ",
+                     meta->devicePath, numArgs, blockSize);
+    if (n < 0 || n >= COMINIT_DM_TABLE_SIZE_MAX) {
+        cominitErrPrint("Device mapper table size too large.");
+        return -1;
+    }
+    pos = (size_t)n;
+
+    cominitMetaRecord_t rec;
+    size_t recPos = 0;
+    while (cominitMetaNextRecord(&rec, idx->records, idx->len, &recPos) == 1) {
+        if (rec.type == COMINIT_META_REC_INTEGRITY_OPT) {
+            if (!cominitMetaIsArg(rec.value, rec.len)) {
+                cominitErrPrint("Invalid dm-integrity option in binary metadata.");
+                return -1;
+            }
+            if (cominitMetaTblAppend(meta->dmTableVerint, &pos, (const char *)rec.value, rec.len) == -1) {
+                return -1;
+            }
+        } else if (rec.type == COMINIT_META_REC_INTEGRITY_KEY) {
+            // <option>:<algorithm>:<key in hexadecimal>
+            uint8_t opt = rec.value[0];
+            size_t algLen = rec.value[1];
+            const uint8_t *alg = rec.value + 2;
+            const uint8_t *keyDesc = alg + algLen;
+            size_t keyDescLen = rec.len - 2 - algLen;
+            if (opt >= ARRAY_SIZE(cominitMetaKeyOpts) || !cominitMetaIsArg(alg, algLen) ||
+                !cominitMetaIsArg(keyDesc, keyDescLen)) {
+                cominitErrPrint("Invalid dm-integrity key reference in binary metadata.");
+                return -1;
+            }
+            cominitInfoPrint("Dm-integrity algorithm for %s %.*s", cominitMetaKeyOpts[opt], (int)algLen,
+                             (const char *)alg);
+            if (cominitMetaTblAppend(meta->dmTableVerint, &pos, cominitMetaKeyOpts[opt],
+                                     strlen(cominitMetaKeyOpts[opt])) == -1 ||
+                cominitMetaTblAppend(meta->dmTableVerint, &pos, (const char *)alg, algLen) == -1 ||
+                cominitMetaTblAppend(meta->dmTableVerint, &pos, ":", 1) == -1 ||
+                cominitMetaTblAppendKey(meta->dmTableVerint, &pos, (const char *)keyDesc, keyDescLen) == -1) {
+                return -1;
+            }
+        } else {
+            continue;
+        }
+        if (cominitMetaTblAppend(meta->dmTableVerint, &pos, " ", 1) == -1) {
+            return -1;
+        }
+    }
+    return 0;
+}
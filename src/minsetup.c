@@ -17,10 +17,19 @@
 #include "common.h"
 #include "dmctl.h"
 #include "output.h"
+#include "timing.h"
 
 #define __USE_XOPEN_EXTENDED 1  // needed so glibc has nftw(), actually not needed for musl
 #include <ftw.h>
 
+/**
+ * Mount options of the tmpfs on /run.
+ *
+ * The same as systemd uses for its own /run mount. systemd keeps an already mounted /run, so the limits must not be
+ * tighter than the ones it would set itself.
+ **/
+#define COMINIT_RUNFS_MOUNT_OPTIONS "mode=0755,size=20%,nr_inodes=800k"
+
 /**
  * Macro for error state in minsetup.c functions.
  *
@@ -48,7 +57,8 @@
  */
 static int cominitNftwRemove(const char *fpath, const struct stat *sb, int tflag, struct FTW *ftwbuf);
 
-/* Setup of minimal environment we need in initramfs. For now, devtmpfs and proc are enough for us. */
+/* Setup of minimal environment we need in initramfs. For now, devtmpfs, proc, sysfs and efivarfs (if available) are
+ * enough for us. */
 int cominitSetupSysfiles(void) {
     umask(0);
 
@@ -80,6 +90,32 @@ int cominitSetupSysfiles(void) {
         cominitInfoPrint("/proc is already mounted. Skipping.");
     }
 
+    if (mkdir("/sys", 0555) == -1) {
+        if (errno != EEXIST) {
+            cominitErrnoPrint("Could not create /sys directory: ");
+            return -1;
+        }
+    }
+    if (mount("none", "/sys", "sysfs", MS_NODEV | MS_NOEXEC | MS_NOSUID, NULL) == -1) {
+        if (errno != EBUSY) {
+            cominitErrnoPrint("Could not mount sysfs.");
+            return -1;
+        }
+        cominitInfoPrint("/sys is already mounted. Skipping.");
+    }
+
+    /* EFI variables are only used as hints, so a system without them is no error. */
+    if (mount("none", "/sys/firmware/efi/efivars", "efivarfs", MS_RDONLY | MS_NODEV | MS_NOEXEC | MS_NOSUID,
+              NULL) == -1) {
+        if (errno == EBUSY) {
+            cominitInfoPrint("/sys/firmware/efi/efivars is already mounted. Skipping.");
+        } else if (errno == ENOENT || errno == ENODEV) {
+            cominitDebugPrint("No EFI variables available.");
+        } else {
+            cominitErrnoPrint("Could not mount efivarfs, continuing without EFI variables.");
+        }
+    }
+
     umask(0022);
     return 0;
 }
@@ -115,10 +151,11 @@ int cominitSetupSysSelinuxfiles(void) {
     return 0;
 }
 
-/* Perform 'lazy' unmount of devtmpfs as it may be busy, this will result in a proper unmount during execve to rootfs
- * init at the latest. (Even if that wasn't the case remounting at /newroot/dev is not a problem) */
+/* Perform 'lazy' unmount of devtmpfs and sysfs as they may be busy, this will result in a proper unmount during execve
+ * to rootfs init at the latest. (Even if that wasn't the case remounting at /newroot/dev is not a problem) */
 int cominitCleanupSysfiles(void) {
     cominitFailIf(umount2("/dev", MNT_DETACH) == -1);
+    cominitFailIf(umount2("/sys", MNT_DETACH) == -1);
     return 0;
 }
 
@@ -138,9 +175,13 @@ int cominitSetupRootfs(cominitRfsMetaData_t *rfsMeta) {
         return -1;
     }
 
-    if (rfsMeta->crypt != COMINIT_CRYPTOPT_NONE && cominitSetupDmDevice(rfsMeta) == -1) {
-        cominitErrPrint("Could not set up rootfs using the device mapper.");
-        return -1;
+    if (rfsMeta->crypt != COMINIT_CRYPTOPT_NONE) {
+        cominitTimingStart(COMINIT_TIMING_DM_SETUP);
+        if (cominitSetupDmDevice(rfsMeta) == -1) {
+            cominitErrPrint("Could not set up rootfs using the device mapper.");
+            return -1;
+        }
+        cominitTimingStop(COMINIT_TIMING_DM_SETUP);
     }
 
     if (mkdir("/newroot", 0755) == -1) {
@@ -150,7 +191,9 @@ int cominitSetupRootfs(cominitRfsMetaData_t *rfsMeta) {
         }
     }
 
+    cominitTimingStart(COMINIT_TIMING_MOUNT_ROOTFS);
     cominitFailIf(mount(rfsMeta->devicePath, "/newroot", rfsMeta->fsType, (rfsMeta->ro) ? MS_RDONLY : 0, NULL) == -1);
+    cominitTimingStop(COMINIT_TIMING_MOUNT_ROOTFS);
     return 0;
 }
 
@@ -188,10 +231,13 @@ static int cominitNftwRemove(const char *fpath, const struct stat *sb, int tflag
 
 int cominitSwitchIntoRootfs(void) {
     cominitInfoPrint("Freeing up initramfs...");
+    cominitTimingStart(COMINIT_TIMING_CLEANUP_INITRAMFS);
     if (nftw("/", cominitNftwRemove, 32, FTW_DEPTH | FTW_PHYS | FTW_MOUNT) == -1) {
         cominitInfoPrint("Warning: Some parts of initramfs could not be deleted.");
     }
+    cominitTimingStop(COMINIT_TIMING_CLEANUP_INITRAMFS);
     cominitInfoPrint("Switching root to /newroot...");
+    cominitTimingStart(COMINIT_TIMING_SWITCH_ROOT);
     if (chdir("/newroot") == -1) {
         cominitErrnoPrint("Could not cd to /newroot.");
         return -1;
@@ -208,5 +254,21 @@ int cominitSwitchIntoRootfs(void) {
         cominitErrnoPrint("Could not cd after chroot.");
         return -1;
     }
+    cominitTimingStop(COMINIT_TIMING_SWITCH_ROOT);
+    return 0;
+}
+
+int cominitSetupRunfs(void) {
+    struct stat root, run;
+    if (stat("/", &root) == -1 || stat("/run", &run) == -1) {
+        cominitErrnoPrint("Could not stat /run.");
+        return -1;
+    }
+    if (root.st_dev != run.st_dev) {
+        cominitDebugPrint("/run already mounted. Skipping.");
+        return 0;
+    }
+    unsigned long flags = MS_NODEV | MS_NOSUID | MS_STRICTATIME;
+    cominitFailIf(mount("tmpfs", "/run", "tmpfs", flags, COMINIT_RUNFS_MOUNT_OPTIONS) == -1);
     return 0;
 }
@@ -0,0 +1,309 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file sha256.c
+ * @brief Implementation of computing SHA-256 digests.
+ */
+#include "sha256.h"
+
+#include <pthread.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <immintrin.h>
+/** The SHA-NI implementation can be compiled in. **/
+#define COMINIT_SHA256_HAVE_SHA_NI
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#include <sys/auxv.h>
+/** The ARMv8 Cryptographic Extension implementation can be compiled in, independent of the -march baseline. **/
+#define COMINIT_SHA256_HAVE_ARMV8_CE
+#ifndef HWCAP_SHA2
+#define HWCAP_SHA2 (1 << 6)  ///< AT_HWCAP bit for the SHA-256 instructions, see asm/hwcap.h.
+#endif
+#endif
+
+/**
+ * Function processing a number of complete 64 Byte input blocks.
+ *
+ * @param state       The intermediate hash value to update.
+ * @param data        The input blocks.
+ * @param blockCount  The number of blocks in @p data.
+ */
+typedef void (*cominitSha256CompressFunc_t)(uint32_t state[8], const uint8_t *data, size_t blockCount);
+
+/** The SHA-256 round constants. **/
+static const uint32_t cominitSha256K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+/** The initial hash value. **/
+static const uint32_t cominitSha256Init32[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                                0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+/** The selected implementation, set once by cominitSha256SelectBackend(). **/
+static cominitSha256CompressFunc_t cominitSha256Compress;
+/** Human-readable name of the selected implementation. **/
+static const char *cominitSha256Backend;
+/** Makes sure the implementation is selected once, even if hashing starts on several threads concurrently. **/
+static pthread_once_t cominitSha256BackendOnce = PTHREAD_ONCE_INIT;
+
+/**
+ * Rotates a 32 bit value to the right.
+ *
+ * @param x  The value to rotate.
+ * @param n  The number of bits to rotate by, 1 to 31.
+ *
+ * @return  The rotated value
+ */
+static inline uint32_t cominitSha256Ror(uint32_t x, unsigned n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+/**
+ * Processes complete input blocks in portable C.
+ *
+ * @param state       The intermediate hash value to update.
+ * @param data        The input blocks.
+ * @param blockCount  The number of blocks in @p data.
+ */
+static void cominitSha256CompressPortable(uint32_t state[8], const uint8_t *data, size_t blockCount) {
+    uint32_t w[64];
+
+    while (blockCount-- > 0) {
+        for (size_t i = 0; i < 16; i++) {
+            w[i] = (uint32_t)data[4 * i] << 24 | (uint32_t)data[4 * i + 1] << 16 | (uint32_t)data[4 * i + 2] << 8 |
+                   (uint32_t)data[4 * i + 3];
+        }
+        for (size_t i = 16; i < 64; i++) {
+            uint32_t s0 = cominitSha256Ror(w[i - 15], 7) ^ cominitSha256Ror(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = cominitSha256Ror(w[i - 2], 17) ^ cominitSha256Ror(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (size_t i = 0; i < 64; i++) {
+            uint32_t s1 = cominitSha256Ror(e, 6) ^ cominitSha256Ror(e, 11) ^ cominitSha256Ror(e, 25);
+            uint32_t ch = (e & f) ^ (~e & g);
+            uint32_t t1 = h + s1 + ch + cominitSha256K[i] + w[i];
+            uint32_t s0 = cominitSha256Ror(a, 2) ^ cominitSha256Ror(a, 13) ^ cominitSha256Ror(a, 22);
+            uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+            uint32_t t2 = s0 + maj;
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+
+        data += COMINIT_SHA256_BLOCK_SIZE;
+    }
+}
+
+#ifdef COMINIT_SHA256_HAVE_SHA_NI
+/**
+ * Processes complete input blocks using the x86 SHA extensions.
+ *
+ * @param state       The intermediate hash value to update.
+ * @param data        The input blocks.
+ * @param blockCount  The number of blocks in @p data.
+ */
+__attribute__((target("sha,sse4.1,ssse3"))) static void cominitSha256CompressShaNi(uint32_t state[8],
+                                                                                   const uint8_t *data,
+                                                                                   size_t blockCount) {
+    const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+
+    // The instructions expect the state as ABEF and CDGH.
+    __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[0]), 0xb1);
+    __m128i cdgh = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[4]), 0x1b);
+    __m128i abef = _mm_alignr_epi8(tmp, cdgh, 8);
+    cdgh = _mm_blend_epi16(cdgh, tmp, 0xf0);
+
+    while (blockCount-- > 0) {
+        __m128i abefSave = abef;
+        __m128i cdghSave = cdgh;
+        __m128i msg[4];
+
+        for (size_t i = 0; i < 4; i++) {
+            msg[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 16 * i)), byteSwap);
+        }
+        for (size_t r = 0; r < 16; r++) {
+            __m128i wk = _mm_add_epi32(msg[r & 3], _mm_loadu_si128((const __m128i *)&cominitSha256K[4 * r]));
+            cdgh = _mm_sha256rnds2_epu32(cdgh, abef, wk);
+            abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(wk, 0x0e));
+            if (r < 12) {
+                // Message schedule for rounds 4 * (r + 4) to 4 * (r + 4) + 3.
+                tmp = _mm_sha256msg1_epu32(msg[r & 3], msg[(r + 1) & 3]);
+                tmp = _mm_add_epi32(tmp, _mm_alignr_epi8(msg[(r + 3) & 3], msg[(r + 2) & 3], 4));
+                msg[r & 3] = _mm_sha256msg2_epu32(tmp, msg[(r + 3) & 3]);
+            }
+        }
+
+        abef = _mm_add_epi32(abef, abefSave);
+        cdgh = _mm_add_epi32(cdgh, cdghSave);
+        data += COMINIT_SHA256_BLOCK_SIZE;
+    }
+
+    tmp = _mm_shuffle_epi32(abef, 0x1b);
+    cdgh = _mm_shuffle_epi32(cdgh, 0xb1);
+    _mm_storeu_si128((__m128i *)&state[0], _mm_blend_epi16(tmp, cdgh, 0xf0));
+    _mm_storeu_si128((__m128i *)&state[4], _mm_alignr_epi8(cdgh, tmp, 8));
+}
+#endif
+
+#ifdef COMINIT_SHA256_HAVE_ARMV8_CE
+/**
+ * Processes complete input blocks using the ARMv8 Cryptographic Extension.
+ *
+ * @param state       The intermediate hash value to update.
+ * @param data        The input blocks.
+ * @param blockCount  The number of blocks in @p data.
+ */
+__attribute__((target("+crypto"))) static void cominitSha256CompressArmCe(uint32_t state[8], const uint8_t *data,
+                                                                         size_t blockCount) {
+    uint32x4_t abcd = vld1q_u32(&state[0]);
+    uint32x4_t efgh = vld1q_u32(&state[4]);
+
+    while (blockCount-- > 0) {
+        uint32x4_t abcdSave = abcd;
+        uint32x4_t efghSave = efgh;
+        uint32x4_t msg[4];
+
+        for (size_t i = 0; i < 4; i++) {
+            msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16 * i)));
+        }
+        for (size_t r = 0; r < 16; r++) {
+            uint32x4_t wk = vaddq_u32(msg[r & 3], vld1q_u32(&cominitSha256K[4 * r]));
+            if (r < 12) {
+                // Message schedule for rounds 4 * (r + 4) to 4 * (r + 4) + 3.
+                msg[r & 3] = vsha256su1q_u32(vsha256su0q_u32(msg[r & 3], msg[(r + 1) & 3]), msg[(r + 2) & 3],
+                                             msg[(r + 3) & 3]);
+            }
+            uint32x4_t abcdPrev = abcd;
+            abcd = vsha256hq_u32(abcd, efgh, wk);
+            efgh = vsha256h2q_u32(efgh, abcdPrev, wk);
+        }
+
+        abcd = vaddq_u32(abcd, abcdSave);
+        efgh = vaddq_u32(efgh, efghSave);
+        data += COMINIT_SHA256_BLOCK_SIZE;
+    }
+
+    vst1q_u32(&state[0], abcd);
+    vst1q_u32(&state[4], efgh);
+}
+#endif
+
+/**
+ * Selects the fastest implementation supported by the CPU.
+ */
+static void cominitSha256SelectBackend(void) {
+    cominitSha256Compress = cominitSha256CompressPortable;
+    cominitSha256Backend = "portable";
+
+#ifdef COMINIT_SHA256_HAVE_SHA_NI
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_SSSE3) && (ecx & bit_SSE4_1) &&
+        __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ebx & bit_SHA)) {
+        cominitSha256Compress = cominitSha256CompressShaNi;
+        cominitSha256Backend = "x86-sha-ni";
+    }
+#endif
+#ifdef COMINIT_SHA256_HAVE_ARMV8_CE
+    if (getauxval(AT_HWCAP) & HWCAP_SHA2) {
+        cominitSha256Compress = cominitSha256CompressArmCe;
+        cominitSha256Backend = "armv8-ce";
+    }
+#endif
+}
+
+void cominitSha256Init(cominitSha256Context_t *ctx) {
+    pthread_once(&cominitSha256BackendOnce, cominitSha256SelectBackend);
+
+    memcpy(ctx->state, cominitSha256Init32, sizeof(ctx->state));
+    ctx->length = 0;
+    ctx->bufferLen = 0;
+}
+
+void cominitSha256Update(cominitSha256Context_t *ctx, const void *data, size_t len) {
+    const uint8_t *p = data;
+
+    ctx->length += len;
+    if (ctx->bufferLen > 0) {
+        size_t fill = COMINIT_SHA256_BLOCK_SIZE - ctx->bufferLen;
+        if (len < fill) {
+            memcpy(ctx->buffer + ctx->bufferLen, p, len);
+            ctx->bufferLen += len;
+            return;
+        }
+        memcpy(ctx->buffer + ctx->bufferLen, p, fill);
+        cominitSha256Compress(ctx->state, ctx->buffer, 1);
+        ctx->bufferLen = 0;
+        p += fill;
+        len -= fill;
+    }
+    if (len >= COMINIT_SHA256_BLOCK_SIZE) {
+        size_t blockCount = len / COMINIT_SHA256_BLOCK_SIZE;
+        cominitSha256Compress(ctx->state, p, blockCount);
+        p += blockCount * COMINIT_SHA256_BLOCK_SIZE;
+        len -= blockCount * COMINIT_SHA256_BLOCK_SIZE;
+    }
+    if (len > 0) {
+        memcpy(ctx->buffer, p, len);
+        ctx->bufferLen = len;
+    }
+}
+
+void cominitSha256Final(cominitSha256Context_t *ctx, uint8_t *digest) {
+    uint64_t bitLength = ctx->length * 8;
+
+    ctx->buffer[ctx->bufferLen++] = 0x80;
+    if (ctx->bufferLen > COMINIT_SHA256_BLOCK_SIZE - sizeof(bitLength)) {
+        memset(ctx->buffer + ctx->bufferLen, 0, COMINIT_SHA256_BLOCK_SIZE - ctx->bufferLen);
+        cominitSha256Compress(ctx->state, ctx->buffer, 1);
+        ctx->bufferLen = 0;
+    }
+    memset(ctx->buffer + ctx->bufferLen, 0, COMINIT_SHA256_BLOCK_SIZE - sizeof(bitLength) - ctx->bufferLen);
+    for (size_t i = 0; i < sizeof(bitLength); i++) {
+        ctx->buffer[COMINIT_SHA256_BLOCK_SIZE - 1 - i] = (uint8_t)(bitLength >> (8 * i));
+    }
+    cominitSha256Compress(ctx->state, ctx->buffer, 1);
+
+    for (size_t i = 0; i < 8; i++) {
+        digest[4 * i] = (uint8_t)(ctx->state[i] >> 24);
+        digest[4 * i + 1] = (uint8_t)(ctx->state[i] >> 16);
+        digest[4 * i + 2] = (uint8_t)(ctx->state[i] >> 8);
+        digest[4 * i + 3] = (uint8_t)ctx->state[i];
+    }
+}
+
+void cominitSha256(const void *data, size_t len, uint8_t *digest) {
+    cominitSha256Context_t ctx;
+
+    cominitSha256Init(&ctx);
+    cominitSha256Update(&ctx, data, len);
+    cominitSha256Final(&ctx, digest);
+}
+
+const char *cominitSha256GetBackend(void) {
+    pthread_once(&cominitSha256BackendOnce, cominitSha256SelectBackend);
+    return cominitSha256Backend;
+}
@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file timing.c
+ * @brief Implementation of measuring the duration of the boot phases of cominit.
+ */
+#include "timing.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#include "common.h"
+#include "output.h"
+
+/**
+ * Structure holding the timestamps of a phase.
+ */
+typedef struct {
+    unsigned long long start;  ///< Start of the phase in microseconds of CLOCK_BOOTTIME, 0 if not started.
+    unsigned long long stop;   ///< End of the phase in microseconds of CLOCK_BOOTTIME, 0 if not stopped.
+} cominitTimingStamp_t;
+
+/** Names of the phases in the report, indexed by cominitTimingPhaseE_t. **/
+static const char *const cominitTimingPhaseNames[COMINIT_TIMING_PHASE_COUNT] = {
+    [COMINIT_TIMING_SETUP_SYSFILES] = "setup-sysfiles",
+    [COMINIT_TIMING_DISCOVER_ROOTFS] = "discover-rootfs",
+    [COMINIT_TIMING_VERIFY_METADATA] = "verify-metadata",
+    [COMINIT_TIMING_VERITY_CHECK] = "verity-check",
+    [COMINIT_TIMING_TPM_INIT] = "tpm-init",
+    [COMINIT_TIMING_TPM_SELFTEST] = "tpm-selftest",
+    [COMINIT_TIMING_TPM] = "tpm",
+    [COMINIT_TIMING_DM_SETUP] = "dm-setup",
+    [COMINIT_TIMING_MOUNT_ROOTFS] = "mount-rootfs",
+    [COMINIT_TIMING_LOAD_SELINUX] = "load-selinux",
+    [COMINIT_TIMING_CLEANUP_SYSFILES] = "cleanup-sysfiles",
+    [COMINIT_TIMING_CLEANUP_INITRAMFS] = "cleanup-initramfs",
+    [COMINIT_TIMING_SWITCH_ROOT] = "switch-root",
+};
+
+/** Names of the values in the report, indexed by cominitTimingValueE_t. **/
+static const char *const cominitTimingValueNames[COMINIT_TIMING_VALUE_COUNT] = {
+    [COMINIT_TIMING_ROOT_WAIT] = "root-wait-ms",
+    [COMINIT_TIMING_ROOT_DELAY] = "root-delay-ms",
+    [COMINIT_TIMING_ROOT_TRIES] = "root-tries",
+};
+
+/** Time cominitTimingInit() has been called in microseconds of CLOCK_BOOTTIME. **/
+static unsigned long long cominitTimingStartMicros;
+/** Timestamps of all phases. **/
+static cominitTimingStamp_t cominitTimingStamps[COMINIT_TIMING_PHASE_COUNT];
+/** Values set with cominitTimingSetValue(). **/
+static unsigned long cominitTimingValues[COMINIT_TIMING_VALUE_COUNT];
+/** Flags which of #cominitTimingValues have been set. **/
+static bool cominitTimingValuesSet[COMINIT_TIMING_VALUE_COUNT];
+
+/**
+ * Gets the current time of the boot clock in microseconds.
+ *
+ * @return  The current time, 0 if the clock could not be read
+ */
+static unsigned long long cominitTimingNow(void) {
+    struct timespec t;
+    if (clock_gettime(CLOCK_BOOTTIME, &t) == -1) {
+        cominitErrnoPrint("Could not get current time from boot clock.");
+        return 0;
+    }
+    return (unsigned long long)t.tv_sec * 1000000uLL + (unsigned long long)t.tv_nsec / 1000uLL;
+}
+
+/**
+ * Creates all missing parent directories of a file.
+ *
+ * @param path  The path of the file.
+ *
+ * @return  0 on success, -1 otherwise
+ */
+static int cominitTimingCreateParents(const char *path) {
+    char dir[PATH_MAX];
+
+    if (strlen(path) >= sizeof(dir)) {
+        cominitErrPrint("Path \'%s\' too long.", path);
+        return -1;
+    }
+    strcpy(dir, path);
+    for (char *sep = strchr(dir + 1, '/'); sep != NULL; sep = strchr(sep + 1, '/')) {
+        *sep = '\0';
+        if (mkdir(dir, 0755) == -1 && errno != EEXIST) {
+            cominitErrnoPrint("Could not create directory \'%s\'.", dir);
+            return -1;
+        }
+        *sep = '/';
+    }
+    return 0;
+}
+
+void cominitTimingInit(void) {
+    memset(cominitTimingStamps, 0, sizeof(cominitTimingStamps));
+    memset(cominitTimingValuesSet, 0, sizeof(cominitTimingValuesSet));
+    cominitTimingStartMicros = cominitTimingNow();
+}
+
+void cominitTimingStart(cominitTimingPhaseE_t phase) {
+    if (phase < COMINIT_TIMING_PHASE_COUNT) {
+        cominitTimingStamps[phase].start = cominitTimingNow();
+        cominitTimingStamps[phase].stop = 0;
+    }
+}
+
+void cominitTimingStop(cominitTimingPhaseE_t phase) {
+    if (phase < COMINIT_TIMING_PHASE_COUNT && cominitTimingStamps[phase].start != 0) {
+        cominitTimingStamps[phase].stop = cominitTimingNow();
+        cominitDebugPrint("Phase %s took %lluus.", cominitTimingPhaseNames[phase],
+                          cominitTimingStamps[phase].stop - cominitTimingStamps[phase].start);
+    }
+}
+
+void cominitTimingSetValue(cominitTimingValueE_t value, unsigned long n) {
+    if (value < COMINIT_TIMING_VALUE_COUNT) {
+        cominitTimingValues[value] = n;
+        cominitTimingValuesSet[value] = true;
+    }
+}
+
+int cominitTimingWriteReport(const char *path) {
+    if (path == NULL) {
+        cominitErrPrint("Invalid parameters");
+        return -1;
+    }
+    if (cominitTimingCreateParents(path) == -1) {
+        return -1;
+    }
+    FILE *report = fopen(path, "we");
+    if (report == NULL) {
+        cominitErrnoPrint("Could not open timing report \'%s\'.", path);
+        return -1;
+    }
+
+    unsigned long long end = cominitTimingNow();
+    fprintf(report, "{\"clock\":\"boottime\",\"unit\":\"us\",\"start\":%llu,\"end\":%llu,\"phases\":[",
+            cominitTimingStartMicros, end);
+    const char *sep = "";
+    for (size_t i = 0; i < COMINIT_TIMING_PHASE_COUNT; i++) {
+        const cominitTimingStamp_t *stamp = &cominitTimingStamps[i];
+        if (stamp->start == 0 || stamp->stop < stamp->start) {
+            continue;
+        }
+        fprintf(report, "%s{\"name\":\"%s\",\"start\":%llu,\"duration\":%llu}", sep, cominitTimingPhaseNames[i],
+                stamp->start, stamp->stop - stamp->start);
+        sep = ",";
+    }
+    fprintf(report, "],\"values\":{");
+    sep = "";
+    for (size_t i = 0; i < COMINIT_TIMING_VALUE_COUNT; i++) {
+        if (cominitTimingValuesSet[i]) {
+            fprintf(report, "%s\"%s\":%lu", sep, cominitTimingValueNames[i], cominitTimingValues[i]);
+            sep = ",";
+        }
+    }
+    fprintf(report, "}}\n");
+
+    bool failed = (ferror(report) != 0);
+    if (fclose(report) == EOF || failed) {
+        cominitErrnoPrint("Could not write timing report \'%s\'.", path);
+        return -1;
+    }
+    cominitInfoPrint("Cominit took %lluus, timing report written to \'%s\'.", end - cominitTimingStartMicros, path);
+    return 0;
+}
@@ -9,15 +9,16 @@
 #include <ctype.h>
 #include <errno.h>
 #include <fcntl.h>
-#include <libgen.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/mount.h>
 #include <sys/stat.h>
 #include <sys/wait.h>
+#include <tss2/tss2_mu.h>
 #include <unistd.h>
 
+#include "crc32.h"
 #include "crypto.h"
 #include "cryptsetup.h"
 #include "dmctl.h"
@@ -26,16 +27,26 @@
 #include "output.h"
 #include "securememory.h"
 #include "subprocess.h"
+#include "timing.h"
 
 /**
  * Result codes on checking the current state of the blob partition.
  */
 typedef enum {
-    BlobIsEmpty,   ///< There is no file at #COMINIT_TPM_BLOB_LOCATION.
-    BlobExists,    ///< A file at location #COMINIT_TPM_BLOB_LOCATION can be accessed.
-    BlobNotFound,  ///< An error occurred while accessing the file at location #COMINIT_TPM_BLOB_LOCATION.
+    BlobIsEmpty,   ///< The start of the partition is erased or it is an ext4 file system without a blob file.
+    BlobExists,    ///< The partition starts with a raw blob.
+    BlobLegacy,    ///< The partition is an ext4 file system mounted at #COMINIT_TPM_MNT_PT holding a blob file.
+    BlobNotFound,  ///< An error occurred while accessing the partition or its content is not recognized.
 } cominitBlobState_t;
 
+/**
+ * The start of the blob partition, read once by cominitTpmSetupBlob().
+ */
+typedef struct {
+    uint8_t data[COMINIT_TPM_BLOB_SIZE_MAX];  ///< The data read from the partition.
+    size_t len;                               ///< The amount of valid Bytes in data.
+} cominitTpmBlob_t;
+
 /**
  * Checks whether the TPM driver module is loaded and loads it if needed.
  *
@@ -47,19 +58,222 @@ static int cominitTpmLoadDriver() {
     return EXIT_SUCCESS;
 }
 
+/**
+ * Gets the TCTI configuration to use.
+ *
+ * @param tcti  The TCTI configuration given on the command line, NULL or empty if none.
+ * @return  @p tcti if given, the device TCTI for #COMINIT_TPM_DEVICE_RM if present or #COMINIT_TPM_DEVICE otherwise
+ */
+static const char *cominitTpmGetTctiConf(const char *tcti) {
+    const char *tctiConf = COMINIT_TPM_TCTI_DEVICE_PREFIX COMINIT_TPM_DEVICE;
+
+    if (tcti != NULL && tcti[0] != '\0') {
+        tctiConf = tcti;
+    } else if (access(COMINIT_TPM_DEVICE_RM, F_OK) == 0) {
+        tctiConf = COMINIT_TPM_TCTI_DEVICE_PREFIX COMINIT_TPM_DEVICE_RM;
+    }
+
+    return tctiConf;
+}
+
+#ifdef COMINIT_TPM_TCTI_DIRECT
+/**
+ * Initializes the device TCTI directly, without the dlopen() of the TCTI loader.
+ *
+ * @param tctiConf  The TCTI configuration, either `device:<path>` or a plain device node.
+ * @param tctiCtx   Pointer to the TCTI context handle that receives the newly allocated context.
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitTpmTctiInit(const char *tctiConf, TSS2_TCTI_CONTEXT **tctiCtx) {
+    int result = EXIT_FAILURE;
+    const char *device = tctiConf;
+    size_t size = 0;
+
+    if (strncmp(device, COMINIT_TPM_TCTI_DEVICE_PREFIX, strlen(COMINIT_TPM_TCTI_DEVICE_PREFIX)) == 0) {
+        device += strlen(COMINIT_TPM_TCTI_DEVICE_PREFIX);
+    }
+    *tctiCtx = NULL;
+    if (strchr(device, ':') != NULL) {
+        cominitErrPrint("Only the device TCTI is built in, \'%s\' is not supported.", tctiConf);
+    } else if (Tss2_Tcti_Device_Init(NULL, &size, device) == TSS2_RC_SUCCESS) {
+        *tctiCtx = calloc(1, size);
+        if (*tctiCtx == NULL) {
+            cominitErrnoPrint("Could not allocate TCTI context");
+        } else if (Tss2_Tcti_Device_Init(*tctiCtx, &size, device) != TSS2_RC_SUCCESS) {
+            free(*tctiCtx);
+            *tctiCtx = NULL;
+        } else {
+            result = EXIT_SUCCESS;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Finalizes and frees a TCTI context allocated by cominitTpmTctiInit().
+ *
+ * @param tctiCtx  Pointer to the TCTI context handle, set to NULL afterwards.
+ */
+static void cominitTpmTctiFinalize(TSS2_TCTI_CONTEXT **tctiCtx) {
+    Tss2_Tcti_Finalize(*tctiCtx);
+    free(*tctiCtx);
+    *tctiCtx = NULL;
+}
+#else
+/**
+ * Initializes a TCTI through the TCTI loader.
+ *
+ * @param tctiConf  The TCTI configuration in the syntax of the TCTI loader.
+ * @param tctiCtx   Pointer to the TCTI context handle that receives the newly allocated context.
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitTpmTctiInit(const char *tctiConf, TSS2_TCTI_CONTEXT **tctiCtx) {
+    return (Tss2_TctiLdr_Initialize(tctiConf, tctiCtx) == TSS2_RC_SUCCESS) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * Finalizes and frees a TCTI context allocated by cominitTpmTctiInit().
+ *
+ * @param tctiCtx  Pointer to the TCTI context handle, set to NULL afterwards.
+ */
+static void cominitTpmTctiFinalize(TSS2_TCTI_CONTEXT **tctiCtx) {
+    Tss2_TctiLdr_Finalize(tctiCtx);
+}
+#endif
+
+#ifdef COMINIT_TPM_SRK_RSA
+/** The type of the storage root key. **/
+#define COMINIT_TPM_SRK_TYPE TPM2_ALG_RSA
+/** The algorithms of the storage root key. **/
+#define COMINIT_TPM_SRK_ALGS TPM2_ALG_RSA
+#else
+/** The type of the storage root key. **/
+#define COMINIT_TPM_SRK_TYPE TPM2_ALG_ECC
+/** The algorithms of the storage root key, ECDH is used to protect the seeds of its children. **/
+#define COMINIT_TPM_SRK_ALGS TPM2_ALG_ECC, TPM2_ALG_ECDH
+#endif
+
+/** The symmetric algorithm protecting the children of the storage root key. **/
+#define COMINIT_TPM_SRK_SYMMETRIC {.algorithm = TPM2_ALG_AES, .keyBits.aes = 128, .mode.aes = TPM2_ALG_CFB}
+
+/** The attributes a persistent storage root key needs to have to be used. **/
+#define COMINIT_TPM_SRK_ATTRIBUTES_REQUIRED                                                          \
+    (TPMA_OBJECT_RESTRICTED | TPMA_OBJECT_DECRYPT | TPMA_OBJECT_FIXEDTPM | TPMA_OBJECT_FIXEDPARENT | \
+     TPMA_OBJECT_SENSITIVEDATAORIGIN)
+
+/**
+ * The algorithms cominit uses with the TPM, tested by cominitTpmSelftest() if the TPM did not complete its self-test
+ * yet: SHA-256 for PCRs and policies, #COMINIT_TPM_SRK_ALGS for the storage root key, AES-CFB for its symmetric
+ * protection and KEYEDHASH for the sealed data object.
+ */
+static const TPM2_ALG_ID cominitTpmSelftestAlgs[] = {TPM2_ALG_SHA256, COMINIT_TPM_SRK_ALGS, TPM2_ALG_AES, TPM2_ALG_CFB,
+                                                     TPM2_ALG_KEYEDHASH};
+
+/**
+ * Structure describing a persistent storage root key.
+ */
+typedef struct cominitTpmSrk {
+    TPM2_HANDLE handle;    ///< The persistent handle of the SRK.
+    TPMI_ALG_PUBLIC type;  ///< The type the SRK needs to have.
+} cominitTpmSrk_t;
+
+/**
+ * Persistent storage root keys a blob may have been sealed with, searched in order. Earlier versions of cominit always
+ * used RSA.
+ */
+static const cominitTpmSrk_t cominitTpmSrks[] = {
+    {.handle = COMINIT_TPM_SRK_HANDLE, .type = COMINIT_TPM_SRK_TYPE},
+    {.handle = COMINIT_TPM_SRK_HANDLE_LEGACY, .type = TPM2_ALG_RSA},
+};
+
+/**
+ * Template of the storage root key (SRK).
+ *
+ * This is the SRK template of the TCG TPM v2.0 Provisioning Guidance, using ECC NIST P-256 or, if cominit is built with
+ * `TPM_SRK_RSA`, RSA-2048. Generating an ECC key takes milliseconds, while RSA key generation may take seconds on
+ * discrete TPMs.
+ */
+static const TPM2B_PUBLIC cominitTpmSrkTemplate = {
+    .size = 0,
+    .publicArea =
+        {
+            .type = COMINIT_TPM_SRK_TYPE,
+            .nameAlg = TPM2_ALG_SHA256,
+            .objectAttributes = (TPMA_OBJECT_USERWITHAUTH | TPMA_OBJECT_RESTRICTED | TPMA_OBJECT_DECRYPT |
+                                 TPMA_OBJECT_FIXEDTPM | TPMA_OBJECT_FIXEDPARENT | TPMA_OBJECT_SENSITIVEDATAORIGIN |
+                                 TPMA_OBJECT_NODA),
+            .authPolicy =
+                {
+                    .size = 0,
+                },
+#ifdef COMINIT_TPM_SRK_RSA
+            .parameters.rsaDetail =
+                {
+                    .symmetric = COMINIT_TPM_SRK_SYMMETRIC,
+                    .scheme = {.scheme = TPM2_ALG_NULL},
+                    .keyBits = 2048,
+                    .exponent = 0,
+                },
+#else
+            .parameters.eccDetail =
+                {
+                    .symmetric = COMINIT_TPM_SRK_SYMMETRIC,
+                    .scheme = {.scheme = TPM2_ALG_NULL},
+                    .curveID = TPM2_ECC_NIST_P256,
+                    .kdf = {.scheme = TPM2_ALG_NULL},
+                },
+#endif
+        },
+};
+
 /**
  * Checks whether the TPM driver module is functional.
  *
+ * If the firmware already had the TPM test itself (e.g. during POST), testing is skipped. Otherwise only the
+ * algorithms in #cominitTpmSelftestAlgs are tested by TPM2_IncrementalSelfTest. A full self-test is only done if the
+ * TPM does not support either command. The mode used is logged, the time spent is recorded as
+ * #COMINIT_TIMING_TPM_SELFTEST.
+ *
  * @param tpmCtx   The TPM context.
  *
  * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
  */
 static int cominitTpmSelftest(cominitTpmContext_t *tpmCtx) {
     int result = EXIT_FAILURE;
-    TSS2_RC rc = Esys_SelfTest(tpmCtx->esysCtx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, TPM2_YES);
-    if (rc != TSS2_RC_SUCCESS) {
-        cominitErrPrint("Selftest failed");
+    const char *mode = NULL;
+    TPM2B_MAX_BUFFER *outData = NULL;
+    TPM2_RC testResult = TPM2_RC_NEEDS_TEST;
+
+    cominitTimingStart(COMINIT_TIMING_TPM_SELFTEST);
+    TSS2_RC rc = Esys_GetTestResult(tpmCtx->esysCtx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, &outData, &testResult);
+    Esys_Free(outData);
+    if (rc == TSS2_RC_SUCCESS && testResult == TPM2_RC_SUCCESS) {
+        mode = "skipped, already done by firmware";
+    } else if (rc == TSS2_RC_SUCCESS && testResult == TPM2_RC_FAILURE) {
+        cominitErrPrint("TPM is in failure mode");
     } else {
+        TPML_ALG toTest = {.count = ARRAY_SIZE(cominitTpmSelftestAlgs)};
+        TPML_ALG *toDoList = NULL;
+        memcpy(toTest.algorithms, cominitTpmSelftestAlgs, sizeof(cominitTpmSelftestAlgs));
+        rc = Esys_IncrementalSelfTest(tpmCtx->esysCtx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, &toTest, &toDoList);
+        Esys_Free(toDoList);
+        if (rc == TSS2_RC_SUCCESS) {
+            mode = "incremental";
+        } else {
+            cominitDebugPrint("Incremental selftest failed (0x%x), doing a full selftest.", rc);
+            rc = Esys_SelfTest(tpmCtx->esysCtx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, TPM2_YES);
+            if (rc == TSS2_RC_SUCCESS) {
+                mode = "full";
+            } else {
+                cominitErrPrint("Selftest failed");
+            }
+        }
+    }
+    cominitTimingStop(COMINIT_TIMING_TPM_SELFTEST);
+
+    if (mode != NULL) {
+        cominitInfoPrint("TPM selftest: %s.", mode);
         result = EXIT_SUCCESS;
     }
 
@@ -110,72 +324,170 @@ static int cominitMkdir(const char *dirPath, mode_t mode) {
 }
 
 /**
- * Mounts the partition on which the sealed blob is saved to and checks whether the partition is empty.
+ * Reads a little-endian 32 bit value.
+ *
+ * @param p  The first Byte of the value.
+ * @return  The value
+ */
+static uint32_t cominitTpmGetLe32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * Writes a little-endian 32 bit value.
+ *
+ * @param p  The first Byte of the value.
+ * @param v  The value.
+ */
+static void cominitTpmPutLe32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/**
+ * Mounts a legacy ext4 blob partition and checks whether it holds a blob file.
+ *
+ * @param argCtx Pointer to the structure that holds the parsed options.
+ * @return  BlobLegacy if the blob file exists, BlobIsEmpty if not, BlobNotFound on error
+ */
+static cominitBlobState_t cominitTpmSetupLegacyBlob(cominitCliArgs_t *argCtx) {
+    cominitBlobState_t state = BlobNotFound;
+
+    if (cominitMkdir(COMINIT_TPM_MNT_PT, S_IRWXU) == EXIT_FAILURE) {
+        cominitErrPrint("Could not create mount directory /'%s/' for device /'%s/'.", COMINIT_TPM_MNT_PT,
+                        argCtx->devNodeBlob);
+    } else {
+        if (mount(argCtx->devNodeBlob, COMINIT_TPM_MNT_PT, "ext4", MS_NOEXEC | MS_RDONLY, "") != 0) {
+            cominitErrPrint("Mount for device /'%s/' failed", argCtx->devNodeBlob);
+        } else if (access(COMINIT_TPM_MNT_PT "/" COMINIT_TPM_BLOB_LOCATION, F_OK) == 0) {
+            state = BlobLegacy;
+        } else {
+            umount(COMINIT_TPM_MNT_PT);
+            state = BlobIsEmpty;
+        }
+    }
+
+    return state;
+}
+
+/**
+ * Checks whether the start of the blob partition has been erased, i.e. holds only zeros or, as erased flash does, only
+ * 0xff.
+ *
+ * @param blob The start of the blob partition.
+ * @return  true if the start of the partition is erased, false otherwise
+ */
+static bool cominitTpmBlobIsErased(const cominitTpmBlob_t *blob) {
+    if (blob->len < COMINIT_TPM_BLOB_HEADER_SIZE || (blob->data[0] != 0x00 && blob->data[0] != 0xff)) {
+        return false;
+    }
+    for (size_t i = 1; i < blob->len; i++) {
+        if (blob->data[i] != blob->data[0]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Reads the start of the partition on which the sealed blob is saved and checks whether it holds a blob.
+ *
+ * A raw blob is recognized by #COMINIT_TPM_BLOB_MAGIC. Only if the partition holds an ext4 file system instead, it is
+ * mounted to look for a blob file written by earlier versions of cominit. The partition is only considered empty, and
+ * thus overwritten with a new blob, if its start has been erased. Any other content, e.g. of a wrong partition or a
+ * damaged magic, is left alone.
  *
  * @param argCtx Pointer to the structure that holds the parsed options.
- * @return  BlobIsEmpty=0 or BlobExists=1 on success, BlobNotFound=3 otherwise
+ * @param blob Pointer to the structure that receives the start of the partition.
+ * @return  BlobIsEmpty, BlobExists or BlobLegacy on success, BlobNotFound otherwise
  */
-static cominitBlobState_t cominitTpmSetupBlob(cominitCliArgs_t *argCtx) {
+static cominitBlobState_t cominitTpmSetupBlob(cominitCliArgs_t *argCtx, cominitTpmBlob_t *blob) {
     cominitBlobState_t state = BlobNotFound;
 
+    blob->len = 0;
     if (argCtx->devNodeBlob[0] != '\0') {
-        if (cominitMkdir(COMINIT_TPM_MNT_PT, S_IRWXU) == EXIT_FAILURE) {
-            cominitErrPrint("Could not create mount directory /'%s/' for device /'%s/'.", COMINIT_TPM_MNT_PT,
-                            argCtx->devNodeBlob);
+        int fd = open(argCtx->devNodeBlob, O_RDONLY | O_CLOEXEC);
+        if (fd == -1) {
+            cominitErrnoPrint("Could not open blob device \'%s\'.", argCtx->devNodeBlob);
         } else {
-            if (mount(argCtx->devNodeBlob, COMINIT_TPM_MNT_PT, "ext4", MS_NOEXEC, "") != 0) {
-                cominitErrPrint("Mount for device /'%s/' failed", argCtx->devNodeBlob);
+            ssize_t bytesRead = pread(fd, blob->data, sizeof(blob->data), 0);
+            if (bytesRead == -1) {
+                cominitErrnoPrint("Could not read blob device \'%s\'.", argCtx->devNodeBlob);
             } else {
-                char fullpath[256];
-                snprintf(fullpath, sizeof fullpath, "%s/%s", COMINIT_TPM_MNT_PT, COMINIT_TPM_BLOB_LOCATION);
-
-                if (access(fullpath, F_OK) == 0) {
+                blob->len = (size_t)bytesRead;
+                if (blob->len >= COMINIT_TPM_BLOB_HEADER_SIZE &&
+                    memcmp(blob->data, COMINIT_TPM_BLOB_MAGIC, COMINIT_TPM_BLOB_MAGIC_SIZE) == 0) {
                     state = BlobExists;
-                } else if (errno == ENOENT) {
-                    char *dirPath = dirname(fullpath);
-                    int result = cominitMkdir(dirPath, S_IRWXU);
-                    if (result != EXIT_SUCCESS) {
-                        cominitErrPrint("Create directory for blob failed");
-                    } else {
-                        state = BlobIsEmpty;
-                    }
+                } else if (blob->len >= COMINIT_TPM_EXT4_MAGIC_OFFSET + 2 &&
+                           (blob->data[COMINIT_TPM_EXT4_MAGIC_OFFSET] |
+                            (blob->data[COMINIT_TPM_EXT4_MAGIC_OFFSET + 1] << 8)) == COMINIT_TPM_EXT4_MAGIC) {
+                    state = cominitTpmSetupLegacyBlob(argCtx);
+                } else if (cominitTpmBlobIsErased(blob)) {
+                    state = BlobIsEmpty;
                 } else {
-                    cominitErrPrint("no valid blob device given");
+                    cominitErrPrint("Blob device \'%s\' holds neither a blob nor erased data, not overwriting it.",
+                                    argCtx->devNodeBlob);
                 }
             }
+            close(fd);
         }
+    } else {
+        cominitErrPrint("no valid blob device given");
     }
 
     return state;
 }
 
 /**
- * Saves the sealed blob to the given path on the blob partition.
+ * Saves the sealed blob as raw blob to the start of the blob partition.
+ *
+ * The raw blob consists of a header (#COMINIT_TPM_BLOB_MAGIC, the little-endian length and CRC32 of the payload) and
+ * the payload, the marshalled public and private part of the sealed object.
  *
+ * @param argCtx Pointer to the structure that holds the parsed options.
+ * @param blob Pointer to the structure that receives the written raw blob.
  * @param outPublic     The Pointer to the structure that holds the public meta data.
  * @param outPrivate    The Pointer to the structure that holds the private data.
  * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
  */
-static int cominitTpmSaveBlob(TPM2B_PUBLIC *outPublic, TPM2B_PRIVATE *outPrivate) {
+static int cominitTpmSaveBlob(cominitCliArgs_t *argCtx, cominitTpmBlob_t *blob, TPM2B_PUBLIC *outPublic,
+                              TPM2B_PRIVATE *outPrivate) {
     int result = EXIT_FAILURE;
-    FILE *fp = NULL;
+    size_t offset = COMINIT_TPM_BLOB_HEADER_SIZE;
 
-    fp = fopen(COMINIT_TPM_MNT_PT "/" COMINIT_TPM_BLOB_LOCATION, "wb");
-    if (fp) {
-        fwrite(outPublic, 1, sizeof *outPublic, fp);
-        fwrite(outPrivate, 1, sizeof *outPrivate, fp);
-        result = EXIT_SUCCESS;
-    }
-
-    if (fp) {
-        fclose(fp);
+    blob->len = 0;
+    if (Tss2_MU_TPM2B_PUBLIC_Marshal(outPublic, blob->data, sizeof(blob->data), &offset) != TSS2_RC_SUCCESS ||
+        Tss2_MU_TPM2B_PRIVATE_Marshal(outPrivate, blob->data, sizeof(blob->data), &offset) != TSS2_RC_SUCCESS) {
+        cominitErrPrint("Could not marshal the sealed blob.");
+    } else {
+        size_t payloadLen = offset - COMINIT_TPM_BLOB_HEADER_SIZE;
+        memcpy(blob->data, COMINIT_TPM_BLOB_MAGIC, COMINIT_TPM_BLOB_MAGIC_SIZE);
+        cominitTpmPutLe32(blob->data + COMINIT_TPM_BLOB_MAGIC_SIZE, (uint32_t)payloadLen);
+        cominitTpmPutLe32(blob->data + COMINIT_TPM_BLOB_MAGIC_SIZE + 4,
+                          cominitCrc32(0, blob->data + COMINIT_TPM_BLOB_HEADER_SIZE, payloadLen));
+
+        int fd = open(argCtx->devNodeBlob, O_WRONLY | O_CLOEXEC);
+        if (fd == -1) {
+            cominitErrnoPrint("Could not open blob device \'%s\'.", argCtx->devNodeBlob);
+        } else {
+            if (pwrite(fd, blob->data, offset, 0) != (ssize_t)offset || fsync(fd) == -1) {
+                cominitErrnoPrint("Could not write blob device \'%s\'.", argCtx->devNodeBlob);
+            } else {
+                blob->len = offset;
+                result = EXIT_SUCCESS;
+            }
+            close(fd);
+        }
     }
 
     return result;
 }
 
 /**
- * Makes the primary key persistent on TPM.
+ * Makes the primary key persistent on TPM at #COMINIT_TPM_SRK_HANDLE.
  *
  * @param ectx The Pointer to the initialized ESYS_CONTEXT handle.
  * @param primaryHandle Pointer to an ESYS_TR holding a transient primary key handle.
@@ -186,7 +498,7 @@ static int cominitTpmSavePrimaryHandle(ESYS_CONTEXT *ectx, ESYS_TR *primaryHandl
     ESYS_TR savedHandle = ESYS_TR_NONE;
 
     TSS2_RC rc = Esys_EvictControl(ectx, ESYS_TR_RH_OWNER, *primaryHandle, ESYS_TR_PASSWORD, ESYS_TR_NONE, ESYS_TR_NONE,
-                                   TPM2_PERSISTENT_FIRST, &savedHandle);
+                                   COMINIT_TPM_SRK_HANDLE, &savedHandle);
 
     if (rc != TSS2_RC_SUCCESS) {
         cominitErrPrint("could not save handle");
@@ -213,6 +525,101 @@ static void cominitTpmSelectPcr(cominitCliArgs_t *argCtx, TPML_PCR_SELECTION *pc
     }
 }
 
+int cominitTpmCheckSrk(ESYS_CONTEXT *ectx, ESYS_TR srkHandle, TPMI_ALG_PUBLIC type) {
+    int result = EXIT_FAILURE;
+    TPM2B_PUBLIC *outPublic = NULL;
+    const TPMT_SYM_DEF_OBJECT symmetric = COMINIT_TPM_SRK_SYMMETRIC;
+
+    if (ectx == NULL) {
+        cominitErrPrint("Invalid parameters");
+        return result;
+    }
+
+    TSS2_RC rc = Esys_ReadPublic(ectx, srkHandle, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, &outPublic, NULL, NULL);
+    if (rc != TSS2_RC_SUCCESS || outPublic == NULL) {
+        cominitErrPrint("Reading the public area of the SRK failed");
+    } else {
+        const TPMT_PUBLIC *srkPublic = &outPublic->publicArea;
+        const TPMT_SYM_DEF_OBJECT *srkSymmetric = NULL;
+        if (srkPublic->type == TPM2_ALG_RSA) {
+            srkSymmetric = &srkPublic->parameters.rsaDetail.symmetric;
+        } else if (srkPublic->type == TPM2_ALG_ECC) {
+            srkSymmetric = &srkPublic->parameters.eccDetail.symmetric;
+        }
+
+        if (srkPublic->type != type || srkSymmetric == NULL) {
+            cominitErrPrint("SRK has type 0x%04x, expected 0x%04x.", srkPublic->type, type);
+        } else if ((srkPublic->objectAttributes & COMINIT_TPM_SRK_ATTRIBUTES_REQUIRED) !=
+                   COMINIT_TPM_SRK_ATTRIBUTES_REQUIRED) {
+            cominitErrPrint("SRK has attributes 0x%08x, missing 0x%08x.", (unsigned int)srkPublic->objectAttributes,
+                            (unsigned int)(COMINIT_TPM_SRK_ATTRIBUTES_REQUIRED & ~srkPublic->objectAttributes));
+        } else if (srkSymmetric->algorithm != symmetric.algorithm ||
+                   srkSymmetric->keyBits.sym != symmetric.keyBits.sym || srkSymmetric->mode.sym != symmetric.mode.sym) {
+            cominitErrPrint("SRK does not use AES-128-CFB to protect its children.");
+        } else {
+            result = EXIT_SUCCESS;
+        }
+    }
+
+    Esys_Free(outPublic);
+
+    return result;
+}
+
+/**
+ * Gets the storage root key (SRK) to seal a key with.
+ *
+ * An SRK already persisted at #COMINIT_TPM_SRK_HANDLE, e.g. by an earlier boot or another provisioning tool, is only
+ * reused if cominitTpmCheckSrk() accepts it, otherwise sealing fails. If there is no persistent SRK, a transient SRK is
+ * created from #cominitTpmSrkTemplate.
+ *
+ * @param ectx  The Pointer to the initialized ESYS_CONTEXT handle.
+ * @param srkHandle Pointer to an ESYS_TR that receives the handle of the SRK.
+ * @param created Pointer to a flag that is set to true if the SRK was created and is transient.
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitTpmGetSrk(ESYS_CONTEXT *ectx, ESYS_TR *srkHandle, bool *created) {
+    int result = EXIT_FAILURE;
+
+    *created = false;
+    TSS2_RC rc =
+        Esys_TR_FromTPMPublic(ectx, COMINIT_TPM_SRK_HANDLE, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, srkHandle);
+    if (rc == TSS2_RC_SUCCESS) {
+        if (cominitTpmCheckSrk(ectx, *srkHandle, COMINIT_TPM_SRK_TYPE) != EXIT_SUCCESS) {
+            cominitErrPrint("Refusing to use the SRK at 0x%08x.", COMINIT_TPM_SRK_HANDLE);
+        } else {
+            cominitInfoPrint("Using persistent SRK at 0x%08x.", COMINIT_TPM_SRK_HANDLE);
+            result = EXIT_SUCCESS;
+        }
+    } else {
+        TPM2B_SENSITIVE_CREATE inSensitivePrimary = {.size = 0};
+        TPM2B_DATA outsideInfo = {.size = 0};
+        TPML_PCR_SELECTION creationPCR = {.count = 0};
+        TPM2B_PUBLIC *outPublicPrimary = NULL;
+        TPM2B_CREATION_DATA *creationData = NULL;
+        TPM2B_DIGEST *creationHash = NULL;
+        TPMT_TK_CREATION *creationTicket = NULL;
+
+        cominitInfoPrint("No SRK at 0x%08x, creating one.", COMINIT_TPM_SRK_HANDLE);
+        rc = Esys_CreatePrimary(ectx, ESYS_TR_RH_OWNER, ESYS_TR_PASSWORD, ESYS_TR_NONE, ESYS_TR_NONE,
+                                &inSensitivePrimary, &cominitTpmSrkTemplate, &outsideInfo, &creationPCR, srkHandle,
+                                &outPublicPrimary, &creationData, &creationHash, &creationTicket);
+        if (rc != TSS2_RC_SUCCESS) {
+            cominitErrPrint("Create primary failed");
+        } else {
+            *created = true;
+            result = EXIT_SUCCESS;
+        }
+
+        Esys_Free(creationData);
+        Esys_Free(creationHash);
+        Esys_Free(creationTicket);
+        Esys_Free(outPublicPrimary);
+    }
+
+    return result;
+}
+
 /**
  * Seals a key to a blob and save the used primary key.
  *
@@ -226,63 +633,15 @@ static int cominitTpmSeal(ESYS_CONTEXT *ectx, TPM2B_PUBLIC **outPublic, TPM2B_PR
                           cominitCliArgs_t *argCtx) {
     int result = EXIT_FAILURE;
     TPM2B_DIGEST *policyDigest = NULL;
-    ESYS_TR sess;
+    ESYS_TR sess = ESYS_TR_NONE;
     ESYS_TR primaryHandle = ESYS_TR_NONE;
-    TPM2B_PUBLIC *outPublicPrimary = NULL;
-
-    TPM2B_CREATION_DATA *creationData = NULL;
-    TPM2B_DIGEST *creationHash = NULL;
-    TPMT_TK_CREATION *creationTicket = NULL;
-
-    TPM2B_SENSITIVE_CREATE inSensitivePrimary = {.size = 0};
-
-    TPM2B_PUBLIC inPublic = {
-        .size = 0,
-        .publicArea =
-            {
-                .type = TPM2_ALG_RSA,
-                .nameAlg = TPM2_ALG_SHA256,
-                .objectAttributes = (TPMA_OBJECT_USERWITHAUTH | TPMA_OBJECT_RESTRICTED | TPMA_OBJECT_DECRYPT |
-                                     TPMA_OBJECT_FIXEDTPM | TPMA_OBJECT_FIXEDPARENT | TPMA_OBJECT_SENSITIVEDATAORIGIN),
-                .authPolicy =
-                    {
-                        .size = 0,
-                    },
-                .parameters.rsaDetail =
-                    {
-                        .symmetric = {.algorithm = TPM2_ALG_AES, .keyBits.aes = 128, .mode.aes = TPM2_ALG_CFB},
-                        .scheme = {.scheme = TPM2_ALG_NULL},
-                        .keyBits = 2048,
-                        .exponent = 0,
-                    },
-                .unique.rsa =
-                    {
-                        .size = 0,
-                        .buffer = {0},
-                    },
-            },
-    };
-
-    TPM2B_DATA outsideInfo = {
-        .size = 0,
-        .buffer = {0},
-    };
-
-    TPML_PCR_SELECTION creationPCR = {
-        .count = 0,
-    };
-
-    TSS2_RC rc = Esys_CreatePrimary(ectx, ESYS_TR_RH_OWNER, ESYS_TR_PASSWORD, ESYS_TR_NONE, ESYS_TR_NONE,
-                                    &inSensitivePrimary, &inPublic, &outsideInfo, &creationPCR, &primaryHandle,
-                                    &outPublicPrimary, &creationData, &creationHash, &creationTicket);
+    bool primaryCreated = false;
 
-    if (rc != TSS2_RC_SUCCESS) {
-        cominitErrPrint("Create primary failed");
-    } else {
+    if (cominitTpmGetSrk(ectx, &primaryHandle, &primaryCreated) == EXIT_SUCCESS) {
         TPMT_SYM_DEF symmetric = {.algorithm = TPM2_ALG_NULL};
 
-        rc = Esys_StartAuthSession(ectx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, NULL,
-                                   TPM2_SE_TRIAL, &symmetric, TPM2_ALG_SHA256, &sess);
+        TSS2_RC rc = Esys_StartAuthSession(ectx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE,
+                                           NULL, TPM2_SE_TRIAL, &symmetric, TPM2_ALG_SHA256, &sess);
 
         if (rc != TSS2_RC_SUCCESS) {
             cominitErrPrint("Start Session failed");
@@ -301,9 +660,9 @@ static int cominitTpmSeal(ESYS_CONTEXT *ectx, TPM2B_PUBLIC **outPublic, TPM2B_PR
                     cominitErrPrint("Get policy digest failed");
                 } else {
                     result = cominitSecurememoryEsysCreate(ectx, &primaryHandle, outPublic, outPrivate, policyDigest);
-                    if (rc != EXIT_SUCCESS) {
+                    if (result != EXIT_SUCCESS) {
                         cominitErrPrint("Creation of blob failed");
-                    } else {
+                    } else if (primaryCreated == true) {
                         result = cominitTpmSavePrimaryHandle(ectx, &primaryHandle);
                     }
                 }
@@ -312,12 +671,10 @@ static int cominitTpmSeal(ESYS_CONTEXT *ectx, TPM2B_PUBLIC **outPublic, TPM2B_PR
     }
 
     Esys_FlushContext(ectx, sess);
-    Esys_FlushContext(ectx, primaryHandle);
-    Esys_Free(creationData);
-    Esys_Free(creationHash);
-    Esys_Free(creationTicket);
+    if (primaryCreated == true) {
+        Esys_FlushContext(ectx, primaryHandle);
+    }
     Esys_Free(policyDigest);
-    Esys_Free(outPublicPrimary);
 
     return result;
 }
@@ -379,9 +736,10 @@ static int cominitTpmSetupSecureStorage(cominitCliArgs_t *argCtx, bool isFirstBo
  *
  * @param ectx  The Pointer to the initialized ESYS_CONTEXT handle.
  * @param argCtx Pointer to the structure that holds the parsed options.
+ * @param blob Pointer to the structure that receives the saved raw blob.
  * @return  Sealed=3 on success, TpmFailure=0 otherwise
  */
-static cominitTpmState_t cominitTpmSealBlob(ESYS_CONTEXT *ectx, cominitCliArgs_t *argCtx) {
+static cominitTpmState_t cominitTpmSealBlob(ESYS_CONTEXT *ectx, cominitCliArgs_t *argCtx, cominitTpmBlob_t *blob) {
     TPM2B_PUBLIC *outPublic = NULL;
     TPM2B_PRIVATE *outPrivate = NULL;
     cominitTpmState_t state = TpmFailure;
@@ -391,7 +749,7 @@ static cominitTpmState_t cominitTpmSealBlob(ESYS_CONTEXT *ectx, cominitCliArgs_t
     if (result != EXIT_SUCCESS) {
         cominitErrPrint("Could not seal the data.");
     } else {
-        result = cominitTpmSaveBlob(outPublic, outPrivate);
+        result = cominitTpmSaveBlob(argCtx, blob, outPublic, outPrivate);
         if (result != EXIT_SUCCESS) {
             cominitErrPrint("Could not save the sealed blob.");
         }
@@ -417,51 +775,88 @@ static void cominitTpmUnmountBlob() {
 }
 
 /**
- * Loads the primary key for unsealing.
+ * Loads the sealed blob from the raw blob read from the blob partition, or from the blob file of a legacy blob
+ * partition.
  *
- * @param ectx  The Pointer to the initialized ESYS_CONTEXT handle.
- * @param primaryHandle Pointer to a ESYS_TR structure that receives the primary key handle.
+ * @param blob The start of the blob partition read by cominitTpmSetupBlob().
+ * @param outPublic The Pointer to the structure that receives the public meta data.
+ * @param outPrivate    The Pointer to the structure that receives the private data.
  * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
  */
-static int cominitTpmLoadPrimaryHandle(ESYS_CONTEXT *ectx, ESYS_TR *primaryHandle) {
+static int cominitTpmLoadBlob(const cominitTpmBlob_t *blob, TPM2B_PUBLIC *outPublic, TPM2B_PRIVATE *outPrivate) {
     int result = EXIT_FAILURE;
 
-    TSS2_RC rc =
-        Esys_TR_FromTPMPublic(ectx, TPM2_PERSISTENT_FIRST, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, primaryHandle);
-
-    if (rc != TSS2_RC_SUCCESS) {
-        cominitErrPrint("Could not open primary handle");
+    if (blob->len >= COMINIT_TPM_BLOB_HEADER_SIZE &&
+        memcmp(blob->data, COMINIT_TPM_BLOB_MAGIC, COMINIT_TPM_BLOB_MAGIC_SIZE) == 0) {
+        size_t payloadLen = cominitTpmGetLe32(blob->data + COMINIT_TPM_BLOB_MAGIC_SIZE);
+        uint32_t crc = cominitTpmGetLe32(blob->data + COMINIT_TPM_BLOB_MAGIC_SIZE + 4);
+        const uint8_t *payload = blob->data + COMINIT_TPM_BLOB_HEADER_SIZE;
+        size_t offset = 0;
+
+        if (payloadLen > blob->len - COMINIT_TPM_BLOB_HEADER_SIZE || cominitCrc32(0, payload, payloadLen) != crc) {
+            cominitErrPrint("The raw blob is corrupted.");
+        } else if (Tss2_MU_TPM2B_PUBLIC_Unmarshal(payload, payloadLen, &offset, outPublic) != TSS2_RC_SUCCESS ||
+                   Tss2_MU_TPM2B_PRIVATE_Unmarshal(payload, payloadLen, &offset, outPrivate) != TSS2_RC_SUCCESS ||
+                   offset != payloadLen) {
+            cominitErrPrint("Could not unmarshal the raw blob.");
+        } else {
+            result = EXIT_SUCCESS;
+        }
     } else {
-        result = EXIT_SUCCESS;
+        FILE *fp = fopen(COMINIT_TPM_MNT_PT "/" COMINIT_TPM_BLOB_LOCATION, "rb");
+        if (fp) {
+            size_t want = sizeof *outPublic;
+            if (fread(outPublic, 1, want, fp) == want) {
+                want = sizeof *outPrivate;
+                if (fread(outPrivate, 1, want, fp) == want) {
+                    result = EXIT_SUCCESS;
+                }
+            }
+            fclose(fp);
+        }
     }
 
     return result;
 }
 
 /**
- * Loads the sealed blob from a given path on the blob partition.
+ * Loads the sealed blob into the TPM.
  *
- * @param outPublic The Pointer to the structure that receives the public meta data.
- * @param outPrivate    The Pointer to the structure that receives the private data.
+ * The blob is loaded under the first storage root key of #cominitTpmSrks that is present, passes cominitTpmCheckSrk()
+ * and accepts it, so blobs sealed by earlier versions of cominit under #COMINIT_TPM_SRK_HANDLE_LEGACY can still be
+ * unsealed.
+ *
+ * @param ectx  The Pointer to the initialized ESYS_CONTEXT handle.
+ * @param outPublic The Pointer to the structure that holds the public meta data.
+ * @param outPrivate    The Pointer to the structure that holds the private data.
+ * @param blobHandle Pointer to an ESYS_TR that receives the handle of the loaded blob.
  * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
  */
-static int cominitTpmLoadBlob(TPM2B_PUBLIC *outPublic, TPM2B_PRIVATE *outPrivate) {
+static int cominitTpmLoadSealedObject(ESYS_CONTEXT *ectx, TPM2B_PUBLIC *outPublic, TPM2B_PRIVATE *outPrivate,
+                                      ESYS_TR *blobHandle) {
     int result = EXIT_FAILURE;
-    FILE *fp = NULL;
-
-    fp = fopen(COMINIT_TPM_MNT_PT "/" COMINIT_TPM_BLOB_LOCATION, "rb");
-    if (fp) {
-        size_t want = sizeof *outPublic;
-        if (fread(outPublic, 1, want, fp) == want) {
-            want = sizeof *outPrivate;
-            if (fread(outPrivate, 1, want, fp) == want) {
+
+    for (size_t i = 0; i < ARRAY_SIZE(cominitTpmSrks) && result != EXIT_SUCCESS; i++) {
+        ESYS_TR primaryHandle = ESYS_TR_NONE;
+        TSS2_RC rc = Esys_TR_FromTPMPublic(ectx, cominitTpmSrks[i].handle, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE,
+                                           &primaryHandle);
+        if (rc != TSS2_RC_SUCCESS) {
+            cominitDebugPrint("No SRK at 0x%08x.", cominitTpmSrks[i].handle);
+        } else if (cominitTpmCheckSrk(ectx, primaryHandle, cominitTpmSrks[i].type) != EXIT_SUCCESS) {
+            cominitErrPrint("Refusing to use the SRK at 0x%08x.", cominitTpmSrks[i].handle);
+        } else {
+            rc = Esys_Load(ectx, primaryHandle, ESYS_TR_PASSWORD, ESYS_TR_NONE, ESYS_TR_NONE, outPrivate, outPublic,
+                           blobHandle);
+            if (rc != TSS2_RC_SUCCESS) {
+                cominitDebugPrint("Blob has not been sealed with SRK at 0x%08x.", cominitTpmSrks[i].handle);
+            } else {
                 result = EXIT_SUCCESS;
             }
         }
     }
 
-    if (fp) {
-        fclose(fp);
+    if (result != EXIT_SUCCESS) {
+        cominitErrPrint("Load of handle failed");
     }
 
     return result;
@@ -471,41 +866,30 @@ static int cominitTpmLoadBlob(TPM2B_PUBLIC *outPublic, TPM2B_PRIVATE *outPrivate
  * Unseals the key.
  *
  * @param ectx  The Pointer to the initialized ESYS_CONTEXT handle.
- * @param primaryHandle Pointer to an ESYS_TR holding a transient primary key handle.
- * @param outPublic The Pointer to the structure that holds the public meta data.
- * @param outPrivate    The Pointer to the structure that holds the private data.
+ * @param blobHandle The handle of the blob loaded by cominitTpmLoadSealedObject(), flushed afterwards.
  * @param argCtx Pointer to the structure that holds the parsed options.
  * @return  Unsealed=2 on success, TpmPolicyFailure=1 or TpmFailure=0 otherwise
  */
-static cominitTpmState_t cominitTpmUnseal(ESYS_CONTEXT *ectx, ESYS_TR *primaryHandle, TPM2B_PUBLIC *outPublic,
-                                          TPM2B_PRIVATE *outPrivate, cominitCliArgs_t *argCtx) {
-    ESYS_TR blobHandle = ESYS_TR_NONE;
+static cominitTpmState_t cominitTpmUnseal(ESYS_CONTEXT *ectx, ESYS_TR blobHandle, cominitCliArgs_t *argCtx) {
     ESYS_TR sess = ESYS_TR_NONE;
     cominitTpmState_t state = TpmFailure;
+    TPMT_SYM_DEF symmetric = {.algorithm = TPM2_ALG_NULL};
 
-    TSS2_RC rc = Esys_Load(ectx, *primaryHandle, ESYS_TR_PASSWORD, ESYS_TR_NONE, ESYS_TR_NONE, outPrivate, outPublic,
-                           &blobHandle);
-
+    TSS2_RC rc = Esys_StartAuthSession(ectx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, NULL,
+                                       TPM2_SE_POLICY, &symmetric, TPM2_ALG_SHA256, &sess);
     if (rc != TSS2_RC_SUCCESS) {
-        cominitErrPrint("Load of handle failed");
+        cominitErrPrint("Starting session failed");
     } else {
-        TPMT_SYM_DEF symmetric = {.algorithm = TPM2_ALG_NULL};
-        rc = Esys_StartAuthSession(ectx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, NULL,
-                                   TPM2_SE_POLICY, &symmetric, TPM2_ALG_SHA256, &sess);
-        if (rc != TSS2_RC_SUCCESS) {
-            cominitErrPrint("Starting session failed");
-        } else {
-            TPML_PCR_SELECTION psel = {
-                .count = 1, .pcrSelections = {{.hash = TPM2_ALG_SHA256, .sizeofSelect = 3, .pcrSelect = {0, 0, 0}}}};
-            cominitTpmSelectPcr(argCtx, &psel);
+        TPML_PCR_SELECTION psel = {
+            .count = 1, .pcrSelections = {{.hash = TPM2_ALG_SHA256, .sizeofSelect = 3, .pcrSelect = {0, 0, 0}}}};
+        cominitTpmSelectPcr(argCtx, &psel);
 
-            rc = Esys_PolicyPCR(ectx, sess, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, NULL, &psel);
+        rc = Esys_PolicyPCR(ectx, sess, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, NULL, &psel);
 
-            if (rc != TSS2_RC_SUCCESS) {
-                cominitErrPrint("Creating policy failed");
-            } else {
-                state = cominitSecurememoryEsysUnseal(ectx, &blobHandle, &sess);
-            }
+        if (rc != TSS2_RC_SUCCESS) {
+            cominitErrPrint("Creating policy failed");
+        } else {
+            state = cominitSecurememoryEsysUnseal(ectx, &blobHandle, &sess);
         }
     }
 
@@ -516,37 +900,37 @@ static cominitTpmState_t cominitTpmUnseal(ESYS_CONTEXT *ectx, ESYS_TR *primaryHa
 }
 
 /**
- * Loads the primary key and the private data to unseal the key.
+ * Loads the private data and the storage root key to unseal the key.
  *
  * @param ectx  The Pointer to the initialized ESYS_CONTEXT handle.
  * @param argCtx Pointer to the structure that holds the parsed options.
+ * @param blob The start of the blob partition read by cominitTpmSetupBlob().
  * @return  Unsealed=2 on success, TpmPolicyFailure=1 or TpmFailure=0 otherwise
  */
-static cominitTpmState_t cominitTpmUnsealBlob(ESYS_CONTEXT *ectx, cominitCliArgs_t *argCtx) {
+static cominitTpmState_t cominitTpmUnsealBlob(ESYS_CONTEXT *ectx, cominitCliArgs_t *argCtx,
+                                              const cominitTpmBlob_t *blob) {
     TPM2B_PUBLIC outPublic = {0};
     TPM2B_PRIVATE outPrivate = {0};
-    ESYS_TR primaryHandle = ESYS_TR_NONE;
+    ESYS_TR blobHandle = ESYS_TR_NONE;
     int result = EXIT_FAILURE;
     cominitTpmState_t tpmState = TpmFailure;
 
-    result = cominitTpmLoadPrimaryHandle(ectx, &primaryHandle);
-
+    result = cominitTpmLoadBlob(blob, &outPublic, &outPrivate);
     if (result != EXIT_SUCCESS) {
-        cominitErrPrint("Could not retrieve handle.");
+        cominitErrPrint("Could not retrieve blob.");
     } else {
-        result = cominitTpmLoadBlob(&outPublic, &outPrivate);
+        result = cominitTpmLoadSealedObject(ectx, &outPublic, &outPrivate, &blobHandle);
         if (result != EXIT_SUCCESS) {
-            cominitErrPrint("Could not retrieve blob.");
+            cominitErrPrint("Could not retrieve handle.");
         } else {
-            tpmState = cominitTpmUnseal(ectx, &primaryHandle, &outPublic, &outPrivate, argCtx);
+            tpmState = cominitTpmUnseal(ectx, blobHandle, argCtx);
         }
     }
 
     return tpmState;
 }
 
-int cominitInitTpm(cominitTpmContext_t *tpmCtx) {
-    const char *tctiConf = "device:/dev/tpm0";
+int cominitInitTpm(cominitTpmContext_t *tpmCtx, const char *tcti) {
     int result = EXIT_FAILURE;
 
     if (tpmCtx == NULL) {
@@ -554,16 +938,24 @@ int cominitInitTpm(cominitTpmContext_t *tpmCtx) {
     } else {
         result = cominitTpmLoadDriver();
         if (result == EXIT_SUCCESS) {
-            result = EXIT_FAILURE;
-            TSS2_RC rc = Tss2_TctiLdr_Initialize(tctiConf, &tpmCtx->tctiCtx);
-            if (rc != TSS2_RC_SUCCESS) {
+            const char *tctiConf = cominitTpmGetTctiConf(tcti);
+            cominitDebugPrint("Using TCTI \'%s\'.", tctiConf);
+            result = cominitTpmTctiInit(tctiConf, &tpmCtx->tctiCtx);
+            if (result != EXIT_SUCCESS) {
                 cominitErrPrint("Initializing TCTI context failed");
             } else {
-                rc = Esys_Initialize(&tpmCtx->esysCtx, tpmCtx->tctiCtx, NULL);
+                result = EXIT_FAILURE;
+                TSS2_RC rc = Esys_Initialize(&tpmCtx->esysCtx, tpmCtx->tctiCtx, NULL);
                 if (rc != TSS2_RC_SUCCESS) {
                     cominitErrPrint("Initializing ESYS context failed");
                 } else {
                     result = cominitTpmSelftest(tpmCtx);
+                    if (result != EXIT_SUCCESS) {
+                        Esys_Finalize(&tpmCtx->esysCtx);
+                    }
+                }
+                if (result != EXIT_SUCCESS) {
+                    cominitTpmTctiFinalize(&tpmCtx->tctiCtx);
                 }
             }
         }
@@ -572,6 +964,103 @@ int cominitInitTpm(cominitTpmContext_t *tpmCtx) {
     return result;
 }
 
+/**
+ * Runs cominitInitTpm() for a cominitTpmInit_t synchronously.
+ *
+ * @param init  The cominitTpmInit_t to initialize.
+ */
+static void cominitTpmInitRun(cominitTpmInit_t *init) {
+    cominitTimingStart(COMINIT_TIMING_TPM_INIT);
+    init->result = cominitInitTpm(&init->tpmCtx, init->tcti);
+    cominitTimingStop(COMINIT_TIMING_TPM_INIT);
+}
+
+/**
+ * Runs cominitInitTpm() for a cominitTpmInit_t as worker thread.
+ *
+ * The thread is started right after /dev has been mounted, possibly before the TPM driver created its device node. In
+ * that case nothing is done, so the initialization is only tried by cominitTpmInitJoin() once the TPM is needed.
+ *
+ * @param arg  The cominitTpmInit_t to initialize.
+ * @return  NULL
+ */
+static void *cominitTpmInitThread(void *arg) {
+    cominitTpmInit_t *init = arg;
+
+    if ((init->tcti == NULL || init->tcti[0] == '\0') && access(COMINIT_TPM_DEVICE_RM, F_OK) != 0 &&
+        access(COMINIT_TPM_DEVICE, F_OK) != 0) {
+        cominitDebugPrint("No TPM device available yet, initializing the TPM when it is needed.");
+        init->result = EXIT_FAILURE;
+    } else {
+        cominitTpmInitRun(init);
+    }
+
+    return NULL;
+}
+
+/**
+ * Waits for the worker thread of a TPM initialization to finish, if it is running.
+ *
+ * @param init  The state of the initialization.
+ * @return  true if the worker thread has been joined, false if none was running
+ */
+static bool cominitTpmInitWait(cominitTpmInit_t *init) {
+    bool joined = false;
+
+    if (init->threadStarted == true) {
+        pthread_join(init->thread, NULL);
+        init->threadStarted = false;
+        joined = true;
+    }
+
+    return joined;
+}
+
+void cominitTpmInitStart(cominitTpmInit_t *init, const char *tcti) {
+    if (init == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else if (init->started == false) {
+        init->started = true;
+        init->tcti = tcti;
+        init->result = EXIT_FAILURE;
+        if (pthread_create(&init->thread, NULL, cominitTpmInitThread, init) == 0) {
+            init->threadStarted = true;
+        } else {
+            cominitErrPrint("Could not start TPM initialization in the background, initializing now.");
+            cominitTpmInitRun(init);
+        }
+    }
+}
+
+int cominitTpmInitJoin(cominitTpmInit_t *init) {
+    int result = EXIT_FAILURE;
+
+    if (init == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        if (init->started == false) {
+            init->started = true;
+            cominitTpmInitRun(init);
+        } else if (cominitTpmInitWait(init) == true && init->result != EXIT_SUCCESS) {
+            cominitDebugPrint("TPM initialization in the background did not succeed, retrying.");
+            cominitTpmInitRun(init);
+        }
+        result = init->result;
+    }
+
+    return result;
+}
+
+void cominitTpmInitRelease(cominitTpmInit_t *init) {
+    if (init != NULL && init->started == true) {
+        cominitTpmInitWait(init);
+        if (init->result == EXIT_SUCCESS) {
+            cominitDeleteTpm(&init->tpmCtx);
+            init->result = EXIT_FAILURE;
+        }
+    }
+}
+
 int cominitTpmExtendPCR(cominitTpmContext_t *tpmCtx, const char *keyfile, unsigned long pcrIndex) {
     int result = EXIT_FAILURE;
     unsigned char digest[SHA256_LEN];
@@ -604,7 +1093,7 @@ int cominitDeleteTpm(cominitTpmContext_t *tpmCtx) {
     if (tpmCtx == NULL || tpmCtx->tctiCtx == NULL || tpmCtx->esysCtx == NULL) {
         cominitErrPrint("Invalid parameters");
     } else {
-        Tss2_TctiLdr_Finalize(&tpmCtx->tctiCtx);
+        cominitTpmTctiFinalize(&tpmCtx->tctiCtx);
         Esys_Finalize(&tpmCtx->esysCtx);
         result = EXIT_SUCCESS;
     }
@@ -666,6 +1155,22 @@ int cominitTpmParsePcrIndexes(cominitCliArgs_t *argCtx, const char *argValue) {
     return result;
 }
 
+int cominitTpmParseTcti(cominitCliArgs_t *argCtx, const char *argValue) {
+    int result = EXIT_FAILURE;
+
+    if (argCtx == NULL || argValue == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        size_t len = strnlen(argValue, sizeof(argCtx->tcti));
+        if (len > 0 && len < sizeof(argCtx->tcti)) {
+            memcpy(argCtx->tcti, argValue, len + 1);
+            result = EXIT_SUCCESS;
+        }
+    }
+
+    return result;
+}
+
 int cominitTpmMountSecureStorage() {
     int result = cominitMkdir(COMINIT_TPM_SECURE_STORAGE_MNT, S_IRWXU);
     if (result != EXIT_SUCCESS) {
@@ -726,15 +1231,16 @@ bool cominitTpmExtendEnabled(cominitCliArgs_t *argCtx) {
 cominitTpmState_t cominitTpmProtectData(cominitTpmContext_t *tpmCtx, cominitCliArgs_t *argCtx) {
     cominitBlobState_t blobState = BlobNotFound;
     cominitTpmState_t tpmState = TpmFailure;
+    cominitTpmBlob_t blob;
 
-    blobState = cominitTpmSetupBlob(argCtx);
+    blobState = cominitTpmSetupBlob(argCtx, &blob);
 
     switch (blobState) {
         case BlobIsEmpty:
             cominitInfoPrint("Blob is empty: sealing");
-            tpmState = cominitTpmSealBlob(tpmCtx->esysCtx, argCtx);
+            tpmState = cominitTpmSealBlob(tpmCtx->esysCtx, argCtx, &blob);
             if (tpmState == Sealed) {
-                tpmState = cominitTpmUnsealBlob(tpmCtx->esysCtx, argCtx);
+                tpmState = cominitTpmUnsealBlob(tpmCtx->esysCtx, argCtx, &blob);
             }
             if (tpmState == Unsealed) {
                 if (cominitTpmSetupSecureStorage(argCtx, true) != EXIT_SUCCESS) {
@@ -744,8 +1250,9 @@ cominitTpmState_t cominitTpmProtectData(cominitTpmContext_t *tpmCtx, cominitCliA
             }
             break;
         case BlobExists:
+        case BlobLegacy:
             cominitInfoPrint("Blob exists: unsealing");
-            tpmState = cominitTpmUnsealBlob(tpmCtx->esysCtx, argCtx);
+            tpmState = cominitTpmUnsealBlob(tpmCtx->esysCtx, argCtx, &blob);
             if (tpmState == Unsealed) {
                 if (cominitTpmSetupSecureStorage(argCtx, false) != EXIT_SUCCESS) {
                     cominitErrPrint("Secure storage could not be set up.");
@@ -760,7 +1267,9 @@ cominitTpmState_t cominitTpmProtectData(cominitTpmContext_t *tpmCtx, cominitCliA
             break;
     }
 
-    cominitTpmUnmountBlob(argCtx->devNodeBlob);
+    if (blobState == BlobLegacy) {
+        cominitTpmUnmountBlob();
+    }
 
     return tpmState;
 }
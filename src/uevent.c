@@ -0,0 +1,169 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file uevent.c
+ * @brief Implementation of listening for Kernel uevents.
+ */
+#include "uevent.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <linux/netlink.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "output.h"
+
+/** Netlink multicast group the Kernel sends its uevents to (udev rebroadcasts on group 2). **/
+#define COMINIT_UEVENT_GROUP_KERNEL 1u
+
+/**
+ * Gets the current time of the monotonic clock in milliseconds.
+ *
+ * @param millis  Return pointer for the time in milliseconds.
+ *
+ * @return  0 on success, -1 otherwise
+ */
+static int cominitUeventGetMillis(unsigned long long *millis) {
+    struct timespec t;
+    if (clock_gettime(CLOCK_MONOTONIC, &t) == -1) {
+        cominitErrnoPrint("Could not get current time from monotonic clock.");
+        return -1;
+    }
+    *millis = (unsigned long long)t.tv_sec * 1000uLL + (unsigned long long)t.tv_nsec / 1000000uLL;
+    return 0;
+}
+
+/**
+ * Searches for a `KEY=value` pair in the environment part of a uevent message.
+ *
+ * @param msg  The message as received from the netlink socket.
+ * @param len  The length of \a msg in Bytes.
+ * @param key  The key to look for including the trailing `=`.
+ *
+ * @return  Pointer to the null-terminated value if \a key is found, NULL otherwise
+ */
+static const char *cominitUeventGetValue(const char *msg, size_t len, const char *key) {
+    size_t keyLen = strlen(key);
+    size_t pos = strnlen(msg, len) + 1;  // jump over the <action>@<devpath> header
+
+    while (pos < len) {
+        const char *field = msg + pos;
+        size_t fieldLen = strnlen(field, len - pos);
+        if (pos + fieldLen >= len) {
+            break;  // last field is not null-terminated
+        }
+        if (fieldLen > keyLen && strncmp(field, key, keyLen) == 0) {
+            return field + keyLen;
+        }
+        pos += fieldLen + 1;
+    }
+
+    return NULL;
+}
+
+int cominitUeventOpen(void) {
+    struct sockaddr_nl addr = {.nl_family = AF_NETLINK, .nl_pid = 0, .nl_groups = COMINIT_UEVENT_GROUP_KERNEL};
+    int rcvBufSize = COMINIT_UEVENT_RCVBUF_SIZE;
+
+    int fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_KOBJECT_UEVENT);
+    if (fd == -1) {
+        cominitErrnoPrint("Could not open uevent netlink socket.");
+        return -1;
+    }
+    if (setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvBufSize, sizeof(rcvBufSize)) == -1) {
+        cominitDebugPrint("Could not enlarge receive buffer of uevent socket, using default size.");
+    }
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) == -1) {
+        cominitErrnoPrint("Could not bind uevent netlink socket.");
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+void cominitUeventClose(int fd) {
+    if (fd != -1) {
+        close(fd);
+    }
+}
+
+bool cominitUeventIsBlockDeviceAdd(const char *msg, size_t len) {
+    if (msg == NULL || len == 0) {
+        return false;
+    }
+    if (len < 4 || strncmp(msg, "add@", 4) != 0) {
+        return false;  // also filters messages from udev which start with "libudev"
+    }
+
+    const char *action = cominitUeventGetValue(msg, len, "ACTION=");
+    const char *subsystem = cominitUeventGetValue(msg, len, "SUBSYSTEM=");
+
+    return (action != NULL && strcmp(action, "add") == 0 && subsystem != NULL && strcmp(subsystem, "block") == 0);
+}
+
+int cominitUeventWaitForBlockDevice(int fd, unsigned long timeoutMillis) {
+    char msg[COMINIT_UEVENT_MSG_SIZE_MAX];
+    unsigned long long now = 0, deadline = 0;
+
+    if (fd < 0) {
+        cominitErrPrint("Invalid parameters");
+        return -1;
+    }
+    if (cominitUeventGetMillis(&now) == -1) {
+        return -1;
+    }
+    deadline = (timeoutMillis > ULLONG_MAX - now) ? ULLONG_MAX : now + timeoutMillis;
+
+    while (now < deadline) {
+        struct pollfd pfd = {.fd = fd, .events = POLLIN, .revents = 0};
+        unsigned long long remaining = deadline - now;
+        int ret = poll(&pfd, 1, (remaining > INT_MAX) ? INT_MAX : (int)remaining);
+        if (ret == -1 && errno != EINTR) {
+            cominitErrnoPrint("Could not poll uevent netlink socket.");
+            return -1;
+        }
+
+        bool blockDeviceAdded = false;
+        while (ret > 0) {
+            struct sockaddr_nl sender = {0};
+            socklen_t senderLen = sizeof(sender);
+            ssize_t len = recvfrom(fd, msg, sizeof(msg) - 1, 0, (struct sockaddr *)&sender, &senderLen);
+            if (len == -1) {
+                if (errno == ENOBUFS) {
+                    cominitDebugPrint("Uevent socket buffer overflowed, events may have been lost.");
+                    blockDeviceAdded = true;
+                    continue;
+                }
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                    cominitErrnoPrint("Could not receive from uevent netlink socket.");
+                    return -1;
+                }
+                break;
+            }
+            if (sender.nl_pid != 0) {
+                continue;  // only trust messages sent by the Kernel
+            }
+            msg[len] = '\0';
+            if (cominitUeventIsBlockDeviceAdd(msg, (size_t)len)) {
+                cominitDebugPrint("Kernel announced new block device: %s", msg + 4);
+                blockDeviceAdded = true;
+            }
+        }
+        if (blockDeviceAdded) {
+            return 1;
+        }
+
+        if (cominitUeventGetMillis(&now) == -1) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,336 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file verity.c
+ * @brief Implementation of checking a dm-verity hash tree before setting up the device mapper.
+ */
+#define _GNU_SOURCE  // for O_DIRECT
+#include "verity.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "output.h"
+#include "sha256.h"
+
+/** Maximum number of levels of a hash tree, same limit as in the Kernel. **/
+#define COMINIT_VERITY_LEVELS_MAX 63
+/** Maximum size (in Bytes) of the salt. **/
+#define COMINIT_VERITY_SALT_MAX 256
+/** Smallest data or hash block size (in Bytes) accepted by the Kernel. **/
+#define COMINIT_VERITY_BLOCK_SIZE_MIN 512uLL
+/** Largest data or hash block size (in Bytes) supported by the pre-check. **/
+#define COMINIT_VERITY_BLOCK_SIZE_MAX 65536uLL
+
+/**
+ * Structure holding the layout of a dm-verity hash tree and the buffers to check it.
+ */
+typedef struct {
+    int fd;                                                     ///< The opened data and hash device.
+    bool ownFd;                                                 ///< If fd has been opened by the pre-check.
+    unsigned long version;                                      ///< The hash format version, 0 or 1.
+    unsigned long long dataBlockSize;                           ///< The size of a data block in Bytes.
+    unsigned long long hashBlockSize;                           ///< The size of a hash block in Bytes.
+    unsigned long long dataBlocks;                              ///< The number of data blocks.
+    unsigned int hashPerBlockBits;                              ///< Binary logarithm of the digests per hash block.
+    size_t entrySize;                                           ///< Space taken by a digest in a hash block.
+    unsigned int levels;                                        ///< The number of levels of the hash tree.
+    unsigned long long levelStart[COMINIT_VERITY_LEVELS_MAX];   ///< The first hash block of each level, level 0
+                                                                ///< holds the digests of the data blocks.
+    unsigned long long levelBlocks[COMINIT_VERITY_LEVELS_MAX];  ///< The number of hash blocks of each level.
+    uint8_t rootDigest[COMINIT_SHA256_DIGEST_LEN];              ///< The root digest from the metadata.
+    uint8_t salt[COMINIT_VERITY_SALT_MAX];                      ///< The salt from the metadata.
+    size_t saltLen;                                             ///< The size of the salt in Bytes.
+    uint8_t *block;                                             ///< Buffer for the block currently hashed.
+    uint8_t *parent;                                            ///< Buffer for the hash block with its digest.
+} cominitVerityTree_t;
+
+/**
+ * Parses a block size from the dm-verity table.
+ *
+ * @param size  Return pointer for the block size.
+ * @param str   The table field.
+ *
+ * @return  0 on success, -1 if the field is not a power of two the pre-check can handle
+ */
+static int cominitVerityParseBlockSize(unsigned long long *size, const char *str) {
+    *size = strtoull(str, NULL, 10);
+    if (*size < COMINIT_VERITY_BLOCK_SIZE_MIN || *size > COMINIT_VERITY_BLOCK_SIZE_MAX || (*size & (*size - 1)) != 0) {
+        cominitErrPrint("Invalid dm-verity block size \'%s\'.", str);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Parses the dm-verity table generated from the metadata and computes the layout of the hash tree.
+ *
+ * @param tree   The structure to fill.
+ * @param table  The device mapper table as in cominitRfsMetaData_t::dmTableVerint.
+ *
+ * @return  1 if the table has been parsed, 0 if the hash algorithm is not supported, -1 on error
+ */
+static int cominitVerityParseTable(cominitVerityTree_t *tree, const char *table) {
+    char tbl[COMINIT_DM_TABLE_SIZE_MAX];
+    char *field[10];
+    char *strtokState = NULL;
+
+    strncpy(tbl, table, sizeof(tbl) - 1);
+    tbl[sizeof(tbl) - 1] = '\0';
+    // <version> <dev> <hash_dev> <data_block_size> <hash_block_size> <num_data_blocks> <hash_start_block>
+    // <algorithm> <digest> <salt>
+    for (size_t i = 0; i < ARRAY_SIZE(field); i++) {
+        field[i] = strtok_r((i == 0) ? tbl : NULL, " ", &strtokState);
+        if (field[i] == NULL) {
+            cominitErrPrint("Unexpected end of dm-verity table.");
+            return -1;
+        }
+    }
+
+    if (strcmp(field[7], "sha256") != 0) {
+        cominitInfoPrint("dm-verity hash algorithm \'%s\' is not supported by the pre-check.", field[7]);
+        return 0;
+    }
+    tree->version = strtoul(field[0], NULL, 10);
+    if (tree->version > 1) {
+        cominitErrPrint("Unsupported dm-verity version \'%s\'.", field[0]);
+        return -1;
+    }
+    if (cominitVerityParseBlockSize(&tree->dataBlockSize, field[3]) == -1 ||
+        cominitVerityParseBlockSize(&tree->hashBlockSize, field[4]) == -1) {
+        return -1;
+    }
+    tree->dataBlocks = strtoull(field[5], NULL, 10);
+    if (tree->dataBlocks == 0) {
+        cominitErrPrint("Invalid dm-verity data block count \'%s\'.", field[5]);
+        return -1;
+    }
+    if (cominitCommonHexToBytes(tree->rootDigest, sizeof(tree->rootDigest), field[8], strlen(field[8])) !=
+        COMINIT_SHA256_DIGEST_LEN) {
+        cominitErrPrint("Invalid dm-verity root digest.");
+        return -1;
+    }
+    ssize_t saltLen = 0;
+    if (strcmp(field[9], "-") != 0 &&
+        (saltLen = cominitCommonHexToBytes(tree->salt, sizeof(tree->salt), field[9], strlen(field[9]))) < 0) {
+        cominitErrPrint("Invalid dm-verity salt.");
+        return -1;
+    }
+    tree->saltLen = (size_t)saltLen;
+
+    // same layout as computed by the Kernel in verity_ctr(), the top level is stored first
+    tree->hashPerBlockBits = 0;
+    while ((2uLL << tree->hashPerBlockBits) * COMINIT_SHA256_DIGEST_LEN <= tree->hashBlockSize) {
+        tree->hashPerBlockBits++;
+    }
+    tree->entrySize = (tree->version == 0) ? COMINIT_SHA256_DIGEST_LEN
+                                           : (size_t)(tree->hashBlockSize >> tree->hashPerBlockBits);
+    tree->levels = 0;
+    while (tree->hashPerBlockBits * tree->levels < 64 &&
+           ((tree->dataBlocks - 1) >> (tree->hashPerBlockBits * tree->levels)) != 0) {
+        tree->levels++;
+    }
+    unsigned long long position = strtoull(field[6], NULL, 10);
+    for (unsigned int i = tree->levels; i-- > 0;) {
+        unsigned int shift = (i + 1) * tree->hashPerBlockBits;
+        tree->levelStart[i] = position;
+        tree->levelBlocks[i] = (shift >= 64) ? 1 : (tree->dataBlocks + (1uLL << shift) - 1) >> shift;
+        position += tree->levelBlocks[i];
+    }
+
+    return 1;
+}
+
+/**
+ * Reads a block from the device.
+ *
+ * @param tree    The hash tree.
+ * @param buf     Buffer receiving the block.
+ * @param offset  Offset of the block on the device in Bytes.
+ * @param size    The size of the block in Bytes.
+ *
+ * @return  0 on success, -1 otherwise
+ */
+static int cominitVerityReadBlock(const cominitVerityTree_t *tree, uint8_t *buf, unsigned long long offset,
+                                  size_t size) {
+    size_t done = 0;
+    while (done < size) {
+        ssize_t n = pread(tree->fd, buf + done, size - done, (off_t)(offset + done));
+        if (n == -1 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            cominitErrnoPrint("Could not read block at offset %llu for dm-verity pre-check.", offset);
+            return -1;
+        }
+        done += (size_t)n;
+    }
+    return 0;
+}
+
+/**
+ * Computes the salted digest of a block as done by dm-verity.
+ *
+ * @param tree    The hash tree.
+ * @param buf     The block.
+ * @param size    The size of the block in Bytes.
+ * @param digest  Buffer receiving the digest.
+ */
+static void cominitVerityHashBlock(const cominitVerityTree_t *tree, const uint8_t *buf, size_t size, uint8_t *digest) {
+    cominitSha256Context_t ctx;
+    cominitSha256Init(&ctx);
+    if (tree->version == 1) {
+        cominitSha256Update(&ctx, tree->salt, tree->saltLen);
+        cominitSha256Update(&ctx, buf, size);
+    } else {
+        cominitSha256Update(&ctx, buf, size);
+        cominitSha256Update(&ctx, tree->salt, tree->saltLen);
+    }
+    cominitSha256Final(&ctx, digest);
+}
+
+/**
+ * Verifies a data block and all hash blocks on its path up to the root digest.
+ *
+ * @param tree       The hash tree.
+ * @param dataBlock  The index of the data block.
+ *
+ * @return  0 if the path is intact, -1 otherwise
+ */
+static int cominitVerityCheckPath(cominitVerityTree_t *tree, unsigned long long dataBlock) {
+    uint8_t digest[COMINIT_SHA256_DIGEST_LEN];
+    unsigned long long position = dataBlock;
+    unsigned long long mask = (1uLL << tree->hashPerBlockBits) - 1;
+
+    if (cominitVerityReadBlock(tree, tree->block, dataBlock * tree->dataBlockSize, tree->dataBlockSize) == -1) {
+        return -1;
+    }
+    cominitVerityHashBlock(tree, tree->block, tree->dataBlockSize, digest);
+
+    for (unsigned int level = 0; level < tree->levels; level++) {
+        unsigned long long hashBlock = tree->levelStart[level] + (position >> tree->hashPerBlockBits);
+        if (cominitVerityReadBlock(tree, tree->parent, hashBlock * tree->hashBlockSize, tree->hashBlockSize) == -1) {
+            return -1;
+        }
+        if (memcmp(tree->parent + (position & mask) * tree->entrySize, digest, sizeof(digest)) != 0) {
+            cominitErrPrint("dm-verity digest mismatch at level %u for data block %llu.", level, dataBlock);
+            return -1;
+        }
+        cominitVerityHashBlock(tree, tree->parent, tree->hashBlockSize, digest);
+        position >>= tree->hashPerBlockBits;
+    }
+
+    if (memcmp(tree->rootDigest, digest, sizeof(digest)) != 0) {
+        cominitErrPrint("dm-verity root digest mismatch for data block %llu.", dataBlock);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Completely verifies one level of the hash tree against the level above, which must have been verified before.
+ *
+ * @param tree   The hash tree.
+ * @param level  The level to verify.
+ *
+ * @return  0 if all hash blocks of the level are intact, -1 otherwise
+ */
+static int cominitVerityCheckLevel(cominitVerityTree_t *tree, unsigned int level) {
+    uint8_t digest[COMINIT_SHA256_DIGEST_LEN];
+    unsigned long long mask = (1uLL << tree->hashPerBlockBits) - 1;
+
+    for (unsigned long long i = 0; i < tree->levelBlocks[level]; i++) {
+        unsigned long long block = tree->levelStart[level] + i;
+        if (cominitVerityReadBlock(tree, tree->block, block * tree->hashBlockSize, tree->hashBlockSize) == -1) {
+            return -1;
+        }
+        cominitVerityHashBlock(tree, tree->block, tree->hashBlockSize, digest);
+
+        if (level == tree->levels - 1) {
+            if (memcmp(tree->rootDigest, digest, sizeof(digest)) != 0) {
+                cominitErrPrint("dm-verity root digest mismatch.");
+                return -1;
+            }
+            continue;
+        }
+        if ((i & mask) == 0) {
+            unsigned long long parentBlock = tree->levelStart[level + 1] + (i >> tree->hashPerBlockBits);
+            if (cominitVerityReadBlock(tree, tree->parent, parentBlock * tree->hashBlockSize, tree->hashBlockSize) ==
+                -1) {
+                return -1;
+            }
+        }
+        if (memcmp(tree->parent + (i & mask) * tree->entrySize, digest, sizeof(digest)) != 0) {
+            cominitErrPrint("dm-verity digest mismatch in hash block %llu at level %u.", block, level);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int cominitVerityPreCheck(const cominitRfsMetaData_t *meta, unsigned long levels) {
+    cominitVerityTree_t tree = {.fd = -1};
+    int ret = -1;
+
+    if (meta == NULL || meta->crypt != COMINIT_CRYPTOPT_VERITY) {
+        cominitErrPrint("Invalid parameters");
+        return -1;
+    }
+
+    int parsed = cominitVerityParseTable(&tree, meta->dmTableVerint);
+    if (parsed != 1) {
+        return parsed;
+    }
+
+    // Reuse the partition opened to load the metadata. Its blocks are read through the page cache, as they are read
+    // again right after by the Kernel, and the block sizes may not be suitable for O_DIRECT.
+    if (meta->deviceFd != -1) {
+        int flags = fcntl(meta->deviceFd, F_GETFL);
+        if (flags != -1 && fcntl(meta->deviceFd, F_SETFL, flags & ~O_DIRECT) == 0) {
+            tree.fd = meta->deviceFd;
+        }
+    }
+    if (tree.fd == -1) {
+        tree.fd = open(meta->devicePath, O_RDONLY | O_CLOEXEC);
+        if (tree.fd == -1) {
+            cominitErrnoPrint("Could not open \'%s\' for dm-verity pre-check.", meta->devicePath);
+            return -1;
+        }
+        tree.ownFd = true;
+    }
+    size_t bufSize = (tree.dataBlockSize > tree.hashBlockSize) ? tree.dataBlockSize : tree.hashBlockSize;
+    tree.block = malloc(2 * bufSize);
+    if (tree.block == NULL) {
+        cominitErrnoPrint("Could not allocate memory for dm-verity pre-check.");
+        goto out;
+    }
+    tree.parent = tree.block + bufSize;
+
+    // top-down, so each level can trust the digests in the level above
+    for (unsigned long checked = 0; checked < levels && checked < tree.levels; checked++) {
+        if (cominitVerityCheckLevel(&tree, tree.levels - 1 - (unsigned int)checked) == -1) {
+            goto out;
+        }
+    }
+
+    unsigned long long sbBlocks = (COMINIT_VERITY_CHECK_SUPERBLOCK_AREA + tree.dataBlockSize - 1) / tree.dataBlockSize;
+    for (unsigned long long b = 0; b < sbBlocks && b < tree.dataBlocks; b++) {
+        if (cominitVerityCheckPath(&tree, b) == -1) {
+            goto out;
+        }
+    }
+
+    cominitInfoPrint("dm-verity pre-check of %lu hash tree level(s) and the superblock area passed.",
+                     (levels < tree.levels) ? levels : (unsigned long)tree.levels);
+    ret = 0;
+out:
+    free(tree.block);
+    if (tree.ownFd) {
+        close(tree.fd);
+    }
+    return ret;
+}
@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file bench-parse-metadata.c
+ * @brief Microbenchmark timing cominitParseMetadata() on typical metadata strings.
+ *
+ * Usage: bench-parse-metadata [iterations]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "common.h"
+#include "meta.h"
+#include "output.h"
+
+/** Default number of calls per metadata string. **/
+#define COMINIT_BENCH_ITERATIONS_DEFAULT 1000000uL
+
+/**
+ * Metadata strings to time, as found in the data part of the rootfs metadata.
+ */
+static const struct {
+    const char *name;     ///< Name printed with the result.
+    const char *metaStr;  ///< The metadata string.
+} cominitBenchCases[] = {
+    {"plain-v1", "1 ext4 rw plain\xff\xff"},
+    {"verity-v2", "2 ecdsa-p256 squashfs ro verity\xff"
+                  "1 4096 4096 26624 26625 sha256 "
+                  "8dcb37a04f6e4f38a7a1c7f46a4e4d0bd5e0d2a26b4c1a3a7c8a1c6f7e9d1b2a "
+                  "0a1b2c3d4e5f60718293a4b5c6d7e8f90a1b2c3d4e5f60718293a4b5c6d7e8f9 1 ignore_zero_blocks\xff"},
+    {"integrity-v1", "1 ext4 rw integrity\xff"
+                     "262144 4096 2 internal_hash:crc32c fix_padding\xff"},
+};
+
+/**
+ * Gets the current time of the monotonic clock in nanoseconds.
+ *
+ * @return  The current time
+ */
+static unsigned long long cominitBenchNow(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000uLL + (unsigned long long)ts.tv_nsec;
+}
+
+/**
+ * Times cominitParseMetadata() for each of cominitBenchCases and prints the average time per call.
+ *
+ * @return  EXIT_SUCCESS if all strings were parsed successfully, EXIT_FAILURE otherwise
+ */
+int main(int argc, char *argv[]) {
+    unsigned long iterations = COMINIT_BENCH_ITERATIONS_DEFAULT;
+    cominitRfsMetaData_t meta = {.devicePath = "/dev/sda1"};
+
+    if (argc > 1) {
+        iterations = strtoul(argv[1], NULL, 10);
+        if (iterations == 0) {
+            fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    cominitOutputSetVisibleLogLevel(COMINIT_LOG_LEVEL_ERR);
+
+    for (size_t i = 0; i < ARRAY_SIZE(cominitBenchCases); i++) {
+        if (cominitParseMetadata(&meta, cominitBenchCases[i].metaStr) == -1) {
+            fprintf(stderr, "Could not parse metadata of case %s.\n", cominitBenchCases[i].name);
+            return EXIT_FAILURE;
+        }
+        unsigned long long start = cominitBenchNow();
+        for (unsigned long n = 0; n < iterations; n++) {
+            cominitParseMetadata(&meta, cominitBenchCases[i].metaStr);
+        }
+        unsigned long long elapsed = cominitBenchNow() - start;
+        printf("%-14s %10.1f ns/op (%lu iterations)\n", cominitBenchCases[i].name, (double)elapsed / iterations,
+               iterations);
+    }
+
+    return EXIT_SUCCESS;
+}
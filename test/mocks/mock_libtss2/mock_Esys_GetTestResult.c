@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_Esys_GetTestResult.c
+ * @brief Implementation of a mock function for Esys_GetTestResult() using cmocka.
+ */
+#include "mock_Esys_GetTestResult.h"
+
+#include <errno.h>
+
+#include "unit_test.h"
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+TSS2_RC __wrap_Esys_GetTestResult(ESYS_CONTEXT *esysContext, ESYS_TR shandle1, ESYS_TR shandle2, ESYS_TR shandle3,
+                                  TPM2B_MAX_BUFFER **outData, TPM2_RC *testResult) {
+    assert_non_null(esysContext);
+    (void)(shandle1);
+    (void)(shandle2);
+    (void)(shandle3);
+    assert_non_null(outData);
+    assert_non_null(testResult);
+
+    TSS2_RC rc = mock_type(TSS2_RC);
+    *outData = NULL;
+    *testResult = mock_type(TPM2_RC);
+
+    return rc;
+}
@@ -0,0 +1,26 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_Esys_IncrementalSelfTest.c
+ * @brief Implementation of a mock function for Esys_IncrementalSelfTest() using cmocka.
+ */
+#include "mock_Esys_IncrementalSelfTest.h"
+
+#include <errno.h>
+
+#include "unit_test.h"
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+TSS2_RC __wrap_Esys_IncrementalSelfTest(ESYS_CONTEXT *esysContext, ESYS_TR shandle1, ESYS_TR shandle2,
+                                        ESYS_TR shandle3, const TPML_ALG *toTest, TPML_ALG **toDoList) {
+    assert_non_null(esysContext);
+    (void)(shandle1);
+    (void)(shandle2);
+    (void)(shandle3);
+    assert_non_null(toTest);
+    assert_true(toTest->count > 0);
+    assert_non_null(toDoList);
+
+    *toDoList = NULL;
+
+    return mock_type(TSS2_RC);
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_Esys_IncrementalSelfTest.h
+ * @brief Header declaring a mock function for Esys_IncrementalSelfTest().
+ */
+#ifndef __MOCK_ESYS_INCREMENTALSELFTEST_H__
+#define __MOCK_ESYS_INCREMENTALSELFTEST_H__
+
+#include <tss2/tss2_common.h>
+#include <tss2/tss2_esys.h>
+
+/**
+ * Mock function for Esys_IncrementalSelfTest().
+ *
+ * Implemented using cmocka. The return code is taken from the cmocka API, @p toDoList is set to NULL.
+ */
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+TSS2_RC __wrap_Esys_IncrementalSelfTest(ESYS_CONTEXT *esysContext, ESYS_TR shandle1, ESYS_TR shandle2,
+                                        ESYS_TR shandle3, const TPML_ALG *toTest, TPML_ALG **toDoList);
+
+#endif /* __MOCK_ESYS_INCREMENTALSELFTEST_H__ */
@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_Esys_ReadPublic.c
+ * @brief Implementation of a mock function for Esys_ReadPublic() using cmocka.
+ */
+#include "mock_Esys_ReadPublic.h"
+
+#include <errno.h>
+
+#include "unit_test.h"
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+TSS2_RC __wrap_Esys_ReadPublic(ESYS_CONTEXT *esysContext, ESYS_TR objectHandle, ESYS_TR shandle1, ESYS_TR shandle2,
+                               ESYS_TR shandle3, TPM2B_PUBLIC **outPublic, TPM2B_NAME **name,
+                               TPM2B_NAME **qualifiedName) {
+    check_expected_ptr(esysContext);
+    check_expected(objectHandle);
+    check_expected(shandle1);
+    check_expected(shandle2);
+    check_expected(shandle3);
+
+    assert_non_null(outPublic);
+
+    TSS2_RC rc = mock_type(TSS2_RC);
+    if (rc == TSS2_RC_SUCCESS) {
+        *outPublic = mock_ptr_type(TPM2B_PUBLIC *);
+        if (name != NULL) {
+            *name = NULL;
+        }
+        if (qualifiedName != NULL) {
+            *qualifiedName = NULL;
+        }
+    }
+
+    return rc;
+}
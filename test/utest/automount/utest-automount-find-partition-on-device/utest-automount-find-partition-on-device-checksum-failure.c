@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-automount-find-partition-on-device-checksum-failure.c
+ * @brief Implementation of a failure case unit test for cominitAutomountFindPartitionOnDevice() with a damaged GPT.
+ */
+
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "mock_close.h"
+#include "mock_open.h"
+#include "unit_test.h"
+#include "utest-automount-find-partition-on-device.h"
+
+void cominitAutomountFindPartitionOnDeviceTestChecksumFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitGPTDisk_t disk = {.diskName = "", .blockSize = 0, .hdr = {{0}}};
+    const cominitGuid_t guidType = COMINIT_GUID(0x11111111, 0x1111, 0x1111, 0x1111, 0x111111111111ULL);
+    char partition[1024] = {0};
+    cominitGPTLookup_t lookup = {.match = COMINIT_GPT_MATCH_TYPE,
+                                 .guid = &guidType,
+                                 .partitionName = partition,
+                                 .partitionNameSize = sizeof(partition)};
+
+    expect_string(__wrap_open, path, COMINIT_TEST_DEVICE);
+    expect_any(__wrap_open, flags);
+    will_return(__wrap_open, cominitBlockDeviceFd);
+
+    expect_value(__wrap_ioctl, fd, cominitBlockDeviceFd);
+
+    /* the primary header is fine, but the partition entries array does not match its checksum */
+    expect_value(__wrap_pread, fd, cominitBlockDeviceFd);
+    expect_value(__wrap_pread, offset, COMINIT_TEST_BLOCK_SIZE);
+    will_return(__wrap_pread, sizeof(cominitGPTHeader_t));
+
+    expect_value(__wrap_ioctl, fd, cominitBlockDeviceFd);
+
+    expect_value(__wrap_pread, fd, cominitBlockDeviceFd);
+    expect_value(__wrap_pread, offset, 2 * COMINIT_TEST_BLOCK_SIZE);
+    will_return(__wrap_pread, GPT_HEADER_DEFAULT_ENTRY_SIZE);
+
+    /* and the backup header is damaged as well */
+    expect_value(__wrap_ioctl, fd, cominitBlockDeviceFd);
+
+    expect_value(__wrap_pread, fd, cominitBlockDeviceFd);
+    expect_value(__wrap_pread, offset, COMINIT_TEST_LAST_LBA * COMINIT_TEST_BLOCK_SIZE);
+    will_return(__wrap_pread, sizeof(cominitGPTHeader_t));
+
+    expect_value(__wrap_close, fd, cominitBlockDeviceFd);
+    will_return(__wrap_close, 0);
+
+    cominitMockCorruptEntriesLba = 1;
+    cominitMockCorruptHeaderLba = COMINIT_TEST_LAST_LBA;
+    cominitMockCloseEnabled = true;
+    cominitMockOpenEnabled = true;
+    cominitMockPreadEnabled = true;
+    assert_int_equal(cominitAutomountFindPartitionOnDevice(&disk, COMINIT_TEST_DEVICE, &lookup), EXIT_FAILURE);
+    cominitMockCloseEnabled = false;
+    cominitMockOpenEnabled = false;
+    cominitMockPreadEnabled = false;
+    cominitMockCorruptEntriesLba = 0;
+    cominitMockCorruptHeaderLba = 0;
+    assert_false(lookup.found);
+    assert_string_equal(disk.diskName, "");
+    assert_null(disk.entries);
+}
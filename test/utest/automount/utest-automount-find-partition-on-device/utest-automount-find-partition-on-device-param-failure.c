@@ -0,0 +1,33 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-automount-find-partition-on-device-param-failure.c
+ * @brief Implementation of a failure case unit test for cominitAutomountFindPartitionOnDevice().
+ */
+
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <string.h>
+
+#include "common.h"
+#include "utest-automount-find-partition-on-device.h"
+
+void cominitAutomountFindPartitionOnDeviceTestParamFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    cominitGPTDisk_t disk = {.diskName = "", .blockSize = 0, .hdr = {{0}}};
+    const cominitGuid_t guidType = {{0}};
+    char partition[256] = {0};
+    char device[COMINIT_ROOTFS_DEV_PATH_MAX + 1];
+    cominitGPTLookup_t lookup = {.match = COMINIT_GPT_MATCH_TYPE,
+                                 .guid = &guidType,
+                                 .partitionName = partition,
+                                 .partitionNameSize = sizeof(partition)};
+
+    assert_int_equal(cominitAutomountFindPartitionOnDevice(NULL, "/dev/sda", &lookup), EXIT_FAILURE);
+    assert_int_equal(cominitAutomountFindPartitionOnDevice(&disk, NULL, &lookup), EXIT_FAILURE);
+    assert_int_equal(cominitAutomountFindPartitionOnDevice(&disk, "/dev/sda", NULL), EXIT_FAILURE);
+
+    /* a device node that does not fit is rejected before it is opened */
+    memset(device, 'a', sizeof(device) - 1);
+    device[sizeof(device) - 1] = '\0';
+    assert_int_equal(cominitAutomountFindPartitionOnDevice(&disk, device, &lookup), EXIT_FAILURE);
+    assert_string_equal(disk.diskName, "");
+}
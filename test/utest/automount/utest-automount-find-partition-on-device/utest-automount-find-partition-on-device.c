@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-automount-find-partition-on-device.c
+ * @brief Implementation of an cominitAutomountFindPartitionOnDevice() unit test group using cmocka.
+ */
+#include "utest-automount-find-partition-on-device.h"
+
+#include <linux/fs.h>
+#include <string.h>
+
+#include "common.h"
+#include "crc32.h"
+#include "unit_test.h"
+
+#if defined(__GLIBC__)
+#define IOCTL_REQ_T unsigned long
+#else
+#define IOCTL_REQ_T int
+#endif
+
+int cominitBlockDeviceFd = 123;
+uint64_t cominitMockCorruptHeaderLba = 0;
+uint64_t cominitMockCorruptEntriesLba = 0;
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_ioctl(int fd, unsigned long request, ...) {
+    check_expected(fd);
+
+    va_list ap;
+    va_start(ap, request);
+
+    switch (request) {
+        case BLKSSZGET: {
+            int *out = va_arg(ap, int *);
+            assert_non_null(out);
+            *out = COMINIT_TEST_BLOCK_SIZE;
+            va_end(ap);
+            return 0;
+        }
+        case BLKGETSIZE64: {
+            uint64_t *out = va_arg(ap, uint64_t *);
+            assert_non_null(out);
+            *out = COMINIT_TEST_DISK_SIZE;
+            va_end(ap);
+            return 0;
+        }
+        default:
+            va_end(ap);
+            return -1;
+    }
+}
+
+bool cominitMockPreadEnabled = false;
+ssize_t __real_pread(int fd, void *buf, size_t count, off_t offset);  // NOLINT(readability-identifier-naming)
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+ssize_t __wrap_pread(int fd, void *buf, size_t count, off_t offset) {
+    if (cominitMockPreadEnabled) {
+        check_expected(fd);
+        check_expected(offset);
+        assert_non_null(buf);
+        /* a disk with a single partition entry whose Bytes are all 0x11 */
+        uint8_t entry[GPT_HEADER_DEFAULT_ENTRY_SIZE];
+        memset(entry, 0x11, sizeof(entry));
+        if (count == sizeof(cominitGPTHeader_t)) {
+            uint64_t lba = (uint64_t)offset / COMINIT_TEST_BLOCK_SIZE;
+            cominitGPTHeader_t *hdr = buf;
+            memset(hdr, 0, sizeof(*hdr));
+            memcpy(hdr->signature, "EFI PART", sizeof(hdr->signature));
+            hdr->headerSize = sizeof(*hdr);
+            hdr->currentLba = lba;
+            hdr->backupLba = (lba == 1) ? COMINIT_TEST_LAST_LBA : 1;
+            hdr->partitionEntriesLba = (lba == 1) ? 2 : lba - 1;
+            hdr->partitionEntrySize = GPT_HEADER_DEFAULT_ENTRY_SIZE;
+            hdr->partitionEntryCount = 1;
+            hdr->partitionEntriesCrc32 = cominitCrc32(0, entry, sizeof(entry));
+            if (lba == cominitMockCorruptEntriesLba) {
+                hdr->partitionEntriesCrc32 ^= 1;
+            }
+            hdr->headerCrc32 = cominitCrc32(0, hdr, sizeof(*hdr));
+            if (lba == cominitMockCorruptHeaderLba) {
+                hdr->headerCrc32 ^= 1;
+            }
+        } else {
+            assert_int_equal(count, sizeof(entry));
+            memcpy(buf, entry, sizeof(entry));
+        }
+        return mock_type(ssize_t);
+    } else {
+        return __real_pread(fd, buf, count, offset);
+    }
+}
+
+/**
+ * Run the unit tests for cominitAutomountFindPartitionOnDevice().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitAutomountFindPartitionOnDeviceTestSuccess),
+        cmocka_unit_test(cominitAutomountFindPartitionOnDeviceTestBackupSuccess),
+        cmocka_unit_test(cominitAutomountFindPartitionOnDeviceTestChecksumFailure),
+        cmocka_unit_test(cominitAutomountFindPartitionOnDeviceTestParamFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-automount-find-partition-on-device.h
+ * @brief Header declaring cmocka unit test functions for cominitAutomountFindPartitionOnDevice().
+ */
+#ifndef __UTEST_AUTOMOUNT_FIND_PARTITION_ON_DEVICE_H__
+#define __UTEST_AUTOMOUNT_FIND_PARTITION_ON_DEVICE_H__
+
+#include "automount.h"
+
+#define COMINIT_TEST_DEVICE "/dev/sdx"                                     ///< The device node of the mocked disk.
+#define COMINIT_TEST_BLOCK_SIZE 512                                        ///< Logical block size of the mocked disk.
+#define COMINIT_TEST_DISK_SIZE (1024 * 1024)                               ///< Size of the mocked disk in Bytes.
+#define COMINIT_TEST_LAST_LBA (COMINIT_TEST_DISK_SIZE / COMINIT_TEST_BLOCK_SIZE - 1)  ///< LBA of the backup GPT.
+
+extern int cominitBlockDeviceFd;
+extern bool cominitMockPreadEnabled;
+/** LBA of the GPT header the mocked pread() returns with a wrong header checksum, 0 for none. **/
+extern uint64_t cominitMockCorruptHeaderLba;
+/** LBA of the GPT header the mocked pread() returns with a wrong partition entries checksum, 0 for none. **/
+extern uint64_t cominitMockCorruptEntriesLba;
+
+/**
+ * Unit test for cominitAutomountFindPartitionOnDevice() successful code path.
+ * @param state
+ */
+void cominitAutomountFindPartitionOnDeviceTestSuccess(void **state);
+
+/**
+ * Unit test for cominitAutomountFindPartitionOnDevice() successful code path with a damaged primary GPT.
+ * @param state
+ */
+void cominitAutomountFindPartitionOnDeviceTestBackupSuccess(void **state);
+
+/**
+ * Unit test for cominitAutomountFindPartitionOnDevice() if primary and backup GPT are damaged.
+ * @param state
+ */
+void cominitAutomountFindPartitionOnDeviceTestChecksumFailure(void **state);
+
+/**
+ * Unit test for cominitAutomountFindPartitionOnDevice() if parameters are not initialized.
+ * @param state
+ */
+void cominitAutomountFindPartitionOnDeviceTestParamFailure(void **state);
+
+#endif /* __UTEST_AUTOMOUNT_FIND_PARTITION_ON_DEVICE_H__ */
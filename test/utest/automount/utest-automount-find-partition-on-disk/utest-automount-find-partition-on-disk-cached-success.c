@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-automount-find-partition-on-disk-cached-success.c
+ * @brief Implementation of a success case unit test for cominitAutomountFindPartitionOnDisk() with cached entries.
+ */
+
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "mock_close.h"
+#include "mock_open.h"
+#include "unit_test.h"
+#include "utest-automount-find-partition-on-disk.h"
+
+#define TEST_DIR_DEV "/dev"
+#define TEST_DISK "sda"
+
+void cominitAutomountFindPartitionOnDiskTestCachedSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    uint8_t entries[2 * GPT_HEADER_DEFAULT_ENTRY_SIZE] = {0};
+    cominitGPTDisk_t disk = {.diskName = TEST_DIR_DEV "/" TEST_DISK, .blockSize = 512, .hdr = {{0}}, .entries = entries};
+    const cominitGuid_t guidType = COMINIT_ROOTFS_GUID_TYPE;
+    char partition[1024] = {0};
+    size_t partitionSize = sizeof(partition);
+
+    cominitGPTHeader_t *hdr = &disk.hdr;
+    hdr->partitionEntriesLba = 2;
+    hdr->partitionEntrySize = GPT_HEADER_DEFAULT_ENTRY_SIZE;
+    hdr->partitionEntryCount = 2;
+    /* first entry is unused, second one is looked up twice without accessing the disk */
+    static const uint8_t rootfsTypeGuidOnDisk[16] = {0x45, 0xb0, 0x21, 0xb9, 0xf0, 0x1d, 0xc3, 0x41,
+                                                     0xaf, 0x44, 0x4c, 0x6f, 0x28, 0x0d, 0x3f, 0xae};
+    memcpy(&entries[GPT_HEADER_DEFAULT_ENTRY_SIZE], rootfsTypeGuidOnDisk, sizeof(rootfsTypeGuidOnDisk));
+
+    cominitMockCloseEnabled = true;
+    cominitMockOpenEnabled = true;
+    cominitMockPreadEnabled = true;
+    assert_int_equal(cominitAutomountFindPartitionOnDisk(&disk, &guidType, partition, partitionSize), EXIT_SUCCESS);
+    assert_string_equal(partition, TEST_DIR_DEV "/" TEST_DISK "2");
+    assert_int_equal(cominitAutomountFindPartitionOnDisk(&disk, &guidType, partition, partitionSize), EXIT_SUCCESS);
+    assert_string_equal(partition, TEST_DIR_DEV "/" TEST_DISK "2");
+    cominitMockPreadEnabled = false;
+    cominitMockCloseEnabled = false;
+    cominitMockOpenEnabled = false;
+    assert_ptr_equal(disk.entries, entries);
+}
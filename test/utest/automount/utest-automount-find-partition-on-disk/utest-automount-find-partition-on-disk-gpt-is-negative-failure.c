@@ -10,14 +10,13 @@
 #include "common.h"
 #include "mock_close.h"
 #include "mock_open.h"
-#include "mock_strcasecmp.h"
 #include "utest-automount-find-partition-on-disk.h"
 
 void cominitAutomountFindPartitionOnDiskTestGptIsNegativeFailure(void **state) {
     COMINIT_PARAM_UNUSED(state);
     int negative = -1;
     cominitGPTDisk_t disk = {.diskName = "dev/sda", .blockSize = negative, .hdr = {{0}}};
-    const char guidType[37] = "GUID_TYPE_test";
+    const cominitGuid_t guidType = COMINIT_ROOTFS_GUID_TYPE;
     char partition[256] = {0};
     size_t partitionSize = sizeof(partition);
 
@@ -32,22 +31,13 @@ void cominitAutomountFindPartitionOnDiskTestGptIsNegativeFailure(void **state) {
 
     expect_value(__wrap_ioctl, fd, cominitDiskFdFailure);
 
-    expect_any_always(__wrap_pread, fd);
-
-    expect_any_always(__wrap_strcasecmp, s2);
-    expect_any_always(__wrap_strcasecmp, s1);
-    will_return_always(__wrap_strcasecmp, -1);
-
     expect_value(__wrap_close, fd, cominitDiskFdFailure);
     will_return(__wrap_close, 0);
 
     cominitMockCloseEnabled = true;
     cominitMockOpenEnabled = true;
-    cominitMockPreadEnabled = true;
-    cominitMockStrcasecmpEnabled = true;
-    assert_int_equal(cominitAutomountFindPartitionOnDisk(&disk, guidType, partition, partitionSize), EXIT_FAILURE);
-    cominitMockPreadEnabled = false;
+    assert_int_equal(cominitAutomountFindPartitionOnDisk(&disk, &guidType, partition, partitionSize), EXIT_FAILURE);
+    assert_null(disk.entries);
     cominitMockCloseEnabled = false;
     cominitMockOpenEnabled = false;
-    cominitMockStrcasecmpEnabled = false;
 }
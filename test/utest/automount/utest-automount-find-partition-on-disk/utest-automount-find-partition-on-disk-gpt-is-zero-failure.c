@@ -16,7 +16,7 @@ void cominitAutomountFindPartitionOnDiskTestGptIsZeroFailure(void **state) {
     COMINIT_PARAM_UNUSED(state);
     int zero = 0;
     cominitGPTDisk_t disk = {.diskName = "dev/sda", .blockSize = 512, .hdr = {{0}}};
-    const char guidType[37] = "GUID_TYPE_test";
+    const cominitGuid_t guidType = COMINIT_ROOTFS_GUID_TYPE;
     char partition[256] = {0};
     size_t partitionSize = sizeof(partition);
 
@@ -35,7 +35,8 @@ void cominitAutomountFindPartitionOnDiskTestGptIsZeroFailure(void **state) {
 
     cominitMockCloseEnabled = true;
     cominitMockOpenEnabled = true;
-    assert_int_equal(cominitAutomountFindPartitionOnDisk(&disk, guidType, partition, partitionSize), EXIT_FAILURE);
+    assert_int_equal(cominitAutomountFindPartitionOnDisk(&disk, &guidType, partition, partitionSize), EXIT_FAILURE);
+    assert_null(disk.entries);
     cominitMockCloseEnabled = false;
     cominitMockOpenEnabled = false;
 }
@@ -16,7 +16,7 @@ void cominitAutomountFindPartitionOnDiskTestGptEntrySizeIsNegativeFailure(void *
     COMINIT_PARAM_UNUSED(state);
     int negative = -1;
     cominitGPTDisk_t disk = {.diskName = "dev/sda", .blockSize = negative, .hdr = {{0}}};
-    const char guidType[37] = "GUID_TYPE_test";
+    const cominitGuid_t guidType = COMINIT_ROOTFS_GUID_TYPE;
     char partition[256] = {0};
     size_t partitionSize = sizeof(partition);
 
@@ -34,7 +34,8 @@ void cominitAutomountFindPartitionOnDiskTestGptEntrySizeIsNegativeFailure(void *
 
     cominitMockCloseEnabled = true;
     cominitMockOpenEnabled = true;
-    assert_int_equal(cominitAutomountFindPartitionOnDisk(&disk, guidType, partition, partitionSize), EXIT_FAILURE);
+    assert_int_equal(cominitAutomountFindPartitionOnDisk(&disk, &guidType, partition, partitionSize), EXIT_FAILURE);
+    assert_null(disk.entries);
     cominitMockCloseEnabled = false;
     cominitMockOpenEnabled = false;
 }
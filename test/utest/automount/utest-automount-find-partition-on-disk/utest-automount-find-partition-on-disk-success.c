@@ -12,9 +12,9 @@
 #include <sys/stat.h>
 
 #include "common.h"
+#include "crc32.h"
 #include "mock_close.h"
 #include "mock_open.h"
-#include "mock_strcasecmp.h"
 #include "unit_test.h"
 #include "utest-automount-find-partition-on-disk.h"
 
@@ -25,7 +25,7 @@ void cominitAutomountFindPartitionOnDiskTestSuccess(void **state) {
     COMINIT_PARAM_UNUSED(state);
 
     cominitGPTDisk_t disk = {.diskName = TEST_DIR_DEV "/" TEST_DISK, .blockSize = 512, .hdr = {{0}}};
-    const char guidType[37] = "GUID_TYPE_test";
+    const cominitGuid_t guidType = COMINIT_GUID(0x01010101, 0x0101, 0x0101, 0x0101, 0x010101010101ULL);
     char partition[1024] = {0};
     size_t partitionSize = sizeof(partition);
 
@@ -33,6 +33,10 @@ void cominitAutomountFindPartitionOnDiskTestSuccess(void **state) {
     memset(&hdr->partitionEntriesLba, 1, 1);
     memset(&hdr->partitionEntrySize, GPT_HEADER_DEFAULT_ENTRY_SIZE, 1);
     memset(&hdr->partitionEntryCount, 1, 1);
+    /* the mocked pread() returns a partition entries array with all Bytes set to 1 */
+    uint8_t entry[GPT_HEADER_DEFAULT_ENTRY_SIZE];
+    memset(entry, 1, sizeof(entry));
+    hdr->partitionEntriesCrc32 = cominitCrc32(0, entry, sizeof(entry));
 
     expect_string(__wrap_open, path, disk.diskName);
     expect_any(__wrap_open, flags);
@@ -42,9 +46,6 @@ void cominitAutomountFindPartitionOnDiskTestSuccess(void **state) {
 
     expect_value(__wrap_pread, fd, cominitDiskFd);
 
-    expect_string(__wrap_strcasecmp, s2, guidType);
-    expect_any(__wrap_strcasecmp, s1);
-    will_return(__wrap_strcasecmp, 0);
 
     expect_value(__wrap_close, fd, cominitDiskFd);
     will_return(__wrap_close, 0);
@@ -52,10 +53,11 @@ void cominitAutomountFindPartitionOnDiskTestSuccess(void **state) {
     cominitMockCloseEnabled = true;
     cominitMockOpenEnabled = true;
     cominitMockPreadEnabled = true;
-    cominitMockStrcasecmpEnabled = true;
-    assert_int_equal(cominitAutomountFindPartitionOnDisk(&disk, guidType, partition, partitionSize), EXIT_SUCCESS);
+    assert_int_equal(cominitAutomountFindPartitionOnDisk(&disk, &guidType, partition, partitionSize), EXIT_SUCCESS);
     cominitMockPreadEnabled = false;
     cominitMockCloseEnabled = false;
     cominitMockOpenEnabled = false;
-    cominitMockStrcasecmpEnabled = false;
+    assert_string_equal(partition, TEST_DIR_DEV "/" TEST_DISK "1");
+    assert_non_null(disk.entries);
+    cominitAutomountFreeDisk(&disk);
 }
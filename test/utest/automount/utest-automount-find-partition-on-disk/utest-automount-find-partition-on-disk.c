@@ -73,6 +73,7 @@ int __wrap_ioctl(int fd, unsigned long request, ...) {
 int main(void) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(cominitAutomountFindPartitionOnDiskTestSuccess),
+        cmocka_unit_test(cominitAutomountFindPartitionOnDiskTestCachedSuccess),
         cmocka_unit_test(cominitAutomountFindPartitionOnDiskTestParamFailure),
         cmocka_unit_test(cominitAutomountFindPartitionOnDiskTestGptIsNegativeFailure),
         cmocka_unit_test(cominitAutomountFindPartitionOnDiskTestGptIsZeroFailure),
@@ -26,6 +26,12 @@ ssize_t __wrap_pread(int fd, void *buf, size_t count, off_t offset);
  */
 void cominitAutomountFindPartitionOnDiskTestSuccess(void **state);
 
+/**
+ * Unit test for cominitAutomountFindPartitionOnDisk() successful code path with already cached partition entries.
+ * @param state
+ */
+void cominitAutomountFindPartitionOnDiskTestCachedSuccess(void **state);
+
 /**
  * Unit test for cominitAutomountFindPartitionOnDisk() if parameters are not initialized.
  * @param state
@@ -12,12 +12,12 @@
 #include <sys/stat.h>
 
 #include "common.h"
+#include "crc32.h"
 #include "mock_close.h"
 #include "mock_closedir.h"
 #include "mock_open.h"
 #include "mock_opendir.h"
 #include "mock_readdir.h"
-#include "mock_strcasecmp.h"
 #include "unit_test.h"
 #include "utest-automount-find-partition.h"
 
@@ -27,11 +27,11 @@
 #define IOCTL_REQ_T int
 #endif
 
+#define TEST_DIR_SYSFS "/sys/class/block"
 #define TEST_DIR_DEV "/dev"
 #define TEST_DISK "sdx"
 
-static int cominitBlockDeviceFd = 123;
-static int cominitDiskFd = 4711;
+int cominitBlockDeviceFd = 123;
 
 // NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
 int __wrap_ioctl(int fd, unsigned long request, ...) {
@@ -82,21 +82,26 @@ ssize_t __real_pread(int fd, void *buf, size_t count, off_t offset);  // NOLINT(
 // NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
 ssize_t __wrap_pread(int fd, void *buf, size_t count, off_t offset) {
     if (cominitMockPreadEnabled) {
-        COMINIT_PARAM_UNUSED(count);
         COMINIT_PARAM_UNUSED(offset);
         check_expected(fd);
         assert_non_null(buf);
-        if (fd == cominitBlockDeviceFd) {
+        if (fd == cominitBlockDeviceFd && count == sizeof(cominitGPTHeader_t)) {
             cominitGPTHeader_t *hdr = buf;
+            uint8_t entry[GPT_HEADER_DEFAULT_ENTRY_SIZE];
             static const char gptSignature[8] = {'E', 'F', 'I', ' ', 'P', 'A', 'R', 'T'};
+            memset(entry, 0x11, sizeof(entry));
+            memset(hdr, 0, sizeof(*hdr));
             memcpy(hdr->signature, gptSignature, sizeof(gptSignature));
+            hdr->headerSize = sizeof(*hdr);
+            hdr->currentLba = 1;
             memset(&hdr->partitionEntriesLba, 1, 1);
             memset(&hdr->partitionEntrySize, GPT_HEADER_DEFAULT_ENTRY_SIZE, 1);
             memset(&hdr->partitionEntryCount, 1, 1);
-        }
-        if (fd == cominitDiskFd) {
+            hdr->partitionEntriesCrc32 = cominitCrc32(0, entry, sizeof(entry));
+            hdr->headerCrc32 = cominitCrc32(0, hdr, sizeof(*hdr));
+        } else if (fd == cominitBlockDeviceFd) {
             /*set entry to non zero*/
-            memset(buf, 0x11, GPT_HEADER_DEFAULT_ENTRY_SIZE);
+            memset(buf, 0x11, count);
         }
         return mock_type(ssize_t);
     } else {
@@ -108,7 +113,7 @@ void cominitAutomountFindPartitionTestSuccess(void **state) {
     COMINIT_PARAM_UNUSED(state);
 
     cominitGPTDisk_t emptyDisk = {.diskName = "", .blockSize = 0, .hdr = {{0}}};
-    const char guidType[37] = "GUID_TYPE_test";
+    const cominitGuid_t guidType = COMINIT_GUID(0x11111111, 0x1111, 0x1111, 0x1111, 0x111111111111ULL);
     char partition[1024] = {0};
     size_t partitionSize = sizeof(partition);
     struct dirent deviceEntry = {0};
@@ -116,11 +121,16 @@ void cominitAutomountFindPartitionTestSuccess(void **state) {
     int dummy;
     DIR *fakeDirPtr = (DIR *)&dummy;
 
+    /* without sysfs the block device nodes in /dev are scanned */
+    expect_string(__wrap_opendir, name, TEST_DIR_SYSFS);
+    will_return(__wrap_opendir, NULL);
     expect_string(__wrap_opendir, name, TEST_DIR_DEV);
     will_return(__wrap_opendir, fakeDirPtr);
 
     expect_value(__wrap_readdir, dirp, fakeDirPtr);
     will_return(__wrap_readdir, &deviceEntry);
+    expect_value(__wrap_readdir, dirp, fakeDirPtr);
+    will_return(__wrap_readdir, NULL);
 
     expect_string(__wrap_lstat, path, TEST_DIR_DEV "/" TEST_DISK);
     will_return(__wrap_lstat, 0);
@@ -134,23 +144,13 @@ void cominitAutomountFindPartitionTestSuccess(void **state) {
     expect_value(__wrap_pread, fd, cominitBlockDeviceFd);
     will_return(__wrap_pread, sizeof(cominitGPTHeader_t));
 
-    expect_value(__wrap_close, fd, cominitBlockDeviceFd);
-    will_return(__wrap_close, 0);
-
-    expect_string(__wrap_open, path, TEST_DIR_DEV "/" TEST_DISK);
-    expect_any(__wrap_open, flags);
-    will_return(__wrap_open, cominitDiskFd);
-
-    expect_value(__wrap_ioctl, fd, cominitDiskFd);
+    /* the partition entries are read with the same file descriptor as the header */
+    expect_value(__wrap_ioctl, fd, cominitBlockDeviceFd);
 
-    expect_value(__wrap_pread, fd, cominitDiskFd);
+    expect_value(__wrap_pread, fd, cominitBlockDeviceFd);
     will_return(__wrap_pread, GPT_HEADER_DEFAULT_ENTRY_SIZE);
 
-    expect_string(__wrap_strcasecmp, s2, guidType);
-    expect_any(__wrap_strcasecmp, s1);
-    will_return(__wrap_strcasecmp, 0);
-
-    expect_value(__wrap_close, fd, cominitDiskFd);
+    expect_value(__wrap_close, fd, cominitBlockDeviceFd);
     will_return(__wrap_close, 0);
 
     expect_value(__wrap_closedir, dirp, fakeDirPtr);
@@ -160,16 +160,17 @@ void cominitAutomountFindPartitionTestSuccess(void **state) {
     cominitMockReaddirEnabled = true;
     cominitMockClosedirEnabled = true;
     cominitMockPreadEnabled = true;
-    cominitMockStrcasecmpEnabled = true;
     cominitMockOpendirEnabled = true;
     cominitMockLstatEnabled = true;
-    assert_int_equal(cominitAutomountFindPartition(&emptyDisk, guidType, partition, partitionSize), EXIT_SUCCESS);
+    assert_int_equal(cominitAutomountFindPartition(&emptyDisk, &guidType, partition, partitionSize), EXIT_SUCCESS);
     cominitMockCloseEnabled = false;
     cominitMockOpenEnabled = false;
     cominitMockReaddirEnabled = false;
     cominitMockClosedirEnabled = false;
     cominitMockPreadEnabled = false;
-    cominitMockStrcasecmpEnabled = false;
     cominitMockOpendirEnabled = false;
     cominitMockLstatEnabled = false;
+    assert_string_equal(emptyDisk.diskName, TEST_DIR_DEV "/" TEST_DISK);
+    assert_non_null(emptyDisk.entries);
+    cominitAutomountFreeDisk(&emptyDisk);
 }
@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-automount-find-partition-sysfs-success.c
+ * @brief Implementation of a success case unit test for cominitAutomountFindPartition() with disks listed in sysfs.
+ */
+
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <dirent.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "mock_close.h"
+#include "mock_closedir.h"
+#include "mock_open.h"
+#include "mock_opendir.h"
+#include "mock_readdir.h"
+#include "unit_test.h"
+#include "utest-automount-find-partition.h"
+
+#define TEST_DIR_SYSFS "/sys/class/block"
+/* A name that does not exist in the sysfs of the test host, so the disk attributes are queried from the device. */
+#define TEST_DISK "utest-disk"
+
+void cominitAutomountFindPartitionTestSysfsSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitGPTDisk_t emptyDisk = {.diskName = "", .blockSize = 0, .hdr = {{0}}};
+    const cominitGuid_t guidType = COMINIT_GUID(0x11111111, 0x1111, 0x1111, 0x1111, 0x111111111111ULL);
+    char partition[1024] = {0};
+    size_t partitionSize = sizeof(partition);
+    struct dirent dotEntry = {0};
+    struct dirent blacklistedEntry = {0};
+    struct dirent deviceEntry = {0};
+    strcpy(dotEntry.d_name, ".");
+    strcpy(blacklistedEntry.d_name, "loop0");
+    strcpy(deviceEntry.d_name, TEST_DISK);
+    int dummy;
+    DIR *fakeDirPtr = (DIR *)&dummy;
+
+    expect_string(__wrap_opendir, name, TEST_DIR_SYSFS);
+    will_return(__wrap_opendir, fakeDirPtr);
+
+    expect_value_count(__wrap_readdir, dirp, fakeDirPtr, 4);
+    will_return(__wrap_readdir, &dotEntry);
+    will_return(__wrap_readdir, &blacklistedEntry);
+    will_return(__wrap_readdir, &deviceEntry);
+    will_return(__wrap_readdir, NULL);
+
+    expect_value(__wrap_closedir, dirp, fakeDirPtr);
+
+    /* no lstat() is needed, the whole disk is probed directly */
+    expect_string(__wrap_open, path, "/dev/" TEST_DISK);
+    expect_any(__wrap_open, flags);
+    will_return(__wrap_open, cominitBlockDeviceFd);
+
+    expect_value(__wrap_ioctl, fd, cominitBlockDeviceFd);
+
+    expect_value(__wrap_pread, fd, cominitBlockDeviceFd);
+    will_return(__wrap_pread, sizeof(cominitGPTHeader_t));
+
+    expect_value(__wrap_ioctl, fd, cominitBlockDeviceFd);
+
+    expect_value(__wrap_pread, fd, cominitBlockDeviceFd);
+    will_return(__wrap_pread, GPT_HEADER_DEFAULT_ENTRY_SIZE);
+
+    expect_value(__wrap_close, fd, cominitBlockDeviceFd);
+    will_return(__wrap_close, 0);
+
+    cominitMockCloseEnabled = true;
+    cominitMockOpenEnabled = true;
+    cominitMockReaddirEnabled = true;
+    cominitMockClosedirEnabled = true;
+    cominitMockPreadEnabled = true;
+    cominitMockOpendirEnabled = true;
+    assert_int_equal(cominitAutomountFindPartition(&emptyDisk, &guidType, partition, partitionSize), EXIT_SUCCESS);
+    cominitMockCloseEnabled = false;
+    cominitMockOpenEnabled = false;
+    cominitMockReaddirEnabled = false;
+    cominitMockClosedirEnabled = false;
+    cominitMockPreadEnabled = false;
+    cominitMockOpendirEnabled = false;
+    assert_string_equal(emptyDisk.diskName, "/dev/" TEST_DISK);
+    assert_string_equal(partition, "/dev/" TEST_DISK "1");
+    assert_int_equal(emptyDisk.diskSize, 1024);
+    cominitAutomountFreeDisk(&emptyDisk);
+}
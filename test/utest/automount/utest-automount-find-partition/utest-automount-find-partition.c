@@ -15,6 +15,7 @@
 int main(void) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(cominitAutomountFindPartitionTestSuccess),
+        cmocka_unit_test(cominitAutomountFindPartitionTestSysfsSuccess),
         cmocka_unit_test(cominitAutomountFindPartitionTestParamFailure),
     };
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -8,12 +8,21 @@
 
 #include "automount.h"
 
+extern int cominitBlockDeviceFd;
+extern bool cominitMockPreadEnabled;
+
 /**
  * Unit test for cominitAutomountFindPartition() successful code path.
  * @param state
  */
 void cominitAutomountFindPartitionTestSuccess(void **state);
 
+/**
+ * Unit test for cominitAutomountFindPartition() successful code path with disks listed in sysfs.
+ * @param state
+ */
+void cominitAutomountFindPartitionTestSysfsSuccess(void **state);
+
 /**
  * Unit test for cominitAutomountFindPartition() if parameters are not initialized.
  * @param state
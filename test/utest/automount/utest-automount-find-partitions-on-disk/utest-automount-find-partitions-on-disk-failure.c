@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-automount-find-partitions-on-disk-failure.c
+ * @brief Implementation of a failure case unit test for cominitAutomountFindPartitionsOnDisk().
+ */
+
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <string.h>
+
+#include "common.h"
+#include "utest-automount-find-partitions-on-disk.h"
+
+void cominitAutomountFindPartitionsOnDiskTestFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    uint8_t entries[COMINIT_TEST_ENTRY_COUNT * GPT_HEADER_DEFAULT_ENTRY_SIZE];
+    cominitGPTDisk_t disk;
+    const cominitGuid_t missingGuidType = COMINIT_GUID(0x0fc63daf, 0x8483, 0x4772, 0x8e79, 0x3d69d8477de4ULL);
+    char rootfs[COMINIT_ROOTFS_DEV_PATH_MAX] = {0};
+    char missing[COMINIT_ROOTFS_DEV_PATH_MAX] = {0};
+    cominitGPTLookup_t lookups[] = {
+        {.guid = &missingGuidType, .partitionName = missing, .partitionNameSize = sizeof(missing)},
+        {.guid = &COMINIT_ROOTFS_GUID_TYPE, .partitionName = rootfs, .partitionNameSize = sizeof(rootfs)},
+    };
+
+    cominitAutomountFindPartitionsOnDiskPrepareDisk(&disk, entries);
+
+    assert_int_equal(cominitAutomountFindPartitionsOnDisk(&disk, lookups, ARRAY_SIZE(lookups)), EXIT_FAILURE);
+    assert_false(lookups[0].found);
+    assert_string_equal(missing, "");
+    assert_true(lookups[1].found);
+    assert_string_equal(rootfs, "/dev/mmcblk0p4");
+}
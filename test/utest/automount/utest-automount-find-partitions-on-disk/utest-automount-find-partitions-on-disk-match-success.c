@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-automount-find-partitions-on-disk-match-success.c
+ * @brief Implementation of a success case unit test for cominitAutomountFindPartitionsOnDisk() matching unique
+ * partition GUID and name.
+ */
+
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <string.h>
+
+#include "common.h"
+#include "utest-automount-find-partitions-on-disk.h"
+
+void cominitAutomountFindPartitionsOnDiskTestMatchSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    uint8_t entries[COMINIT_TEST_ENTRY_COUNT * GPT_HEADER_DEFAULT_ENTRY_SIZE];
+    cominitGPTDisk_t disk;
+    char rootfsByUuid[COMINIT_ROOTFS_DEV_PATH_MAX] = {0};
+    char rootfsByLabel[COMINIT_ROOTFS_DEV_PATH_MAX] = {0};
+    char secureStorageByUuid[COMINIT_ROOTFS_DEV_PATH_MAX] = {0};
+    char secureStorageByLabel[COMINIT_ROOTFS_DEV_PATH_MAX] = {0};
+    cominitGPTLookup_t lookups[] = {
+        {.match = COMINIT_GPT_MATCH_PARTUUID,
+         .guid = &COMINIT_TEST_ROOTFS_PARTUUID,
+         .partitionName = rootfsByUuid,
+         .partitionNameSize = sizeof(rootfsByUuid)},
+        {.match = COMINIT_GPT_MATCH_PARTLABEL,
+         .label = COMINIT_TEST_ROOTFS_PARTLABEL,
+         .partitionName = rootfsByLabel,
+         .partitionNameSize = sizeof(rootfsByLabel)},
+        {.match = COMINIT_GPT_MATCH_PARTUUID,
+         .guid = &COMINIT_TEST_SECURE_STORAGE_PARTUUID,
+         .partitionName = secureStorageByUuid,
+         .partitionNameSize = sizeof(secureStorageByUuid)},
+        {.match = COMINIT_GPT_MATCH_PARTLABEL,
+         .label = COMINIT_TEST_SECURE_STORAGE_PARTLABEL,
+         .partitionName = secureStorageByLabel,
+         .partitionNameSize = sizeof(secureStorageByLabel)},
+    };
+
+    cominitAutomountFindPartitionsOnDiskPrepareDisk(&disk, entries);
+
+    assert_int_equal(cominitAutomountFindPartitionsOnDisk(&disk, lookups, ARRAY_SIZE(lookups)), EXIT_SUCCESS);
+    assert_string_equal(rootfsByUuid, "/dev/mmcblk0p4");
+    assert_string_equal(rootfsByLabel, "/dev/mmcblk0p4");
+    assert_string_equal(secureStorageByUuid, "/dev/mmcblk0p2");
+    assert_string_equal(secureStorageByLabel, "/dev/mmcblk0p2");
+
+    /* a prefix of a name does not match */
+    lookups[1].label = "rootfs";
+    assert_int_equal(cominitAutomountFindPartitionsOnDisk(&disk, &lookups[1], 1), EXIT_FAILURE);
+    assert_false(lookups[1].found);
+}
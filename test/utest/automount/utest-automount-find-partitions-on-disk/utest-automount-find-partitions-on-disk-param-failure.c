@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-automount-find-partitions-on-disk-param-failure.c
+ * @brief Implementation of a failure case unit test for cominitAutomountFindPartitionsOnDisk().
+ */
+
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <string.h>
+
+#include "common.h"
+#include "utest-automount-find-partitions-on-disk.h"
+
+void cominitAutomountFindPartitionsOnDiskTestParamFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    uint8_t entries[COMINIT_TEST_ENTRY_COUNT * GPT_HEADER_DEFAULT_ENTRY_SIZE];
+    cominitGPTDisk_t disk;
+    char partition[COMINIT_ROOTFS_DEV_PATH_MAX] = {0};
+    cominitGPTLookup_t lookup = {
+        .guid = &COMINIT_ROOTFS_GUID_TYPE, .partitionName = partition, .partitionNameSize = sizeof(partition)};
+
+    cominitAutomountFindPartitionsOnDiskPrepareDisk(&disk, entries);
+
+    assert_int_equal(cominitAutomountFindPartitionsOnDisk(NULL, &lookup, 1), EXIT_FAILURE);
+    assert_int_equal(cominitAutomountFindPartitionsOnDisk(&disk, NULL, 1), EXIT_FAILURE);
+    assert_int_equal(cominitAutomountFindPartitionsOnDisk(&disk, &lookup, 0), EXIT_FAILURE);
+
+    lookup.guid = NULL;
+    assert_int_equal(cominitAutomountFindPartitionsOnDisk(&disk, &lookup, 1), EXIT_FAILURE);
+    lookup.guid = &COMINIT_ROOTFS_GUID_TYPE;
+    lookup.partitionName = NULL;
+    assert_int_equal(cominitAutomountFindPartitionsOnDisk(&disk, &lookup, 1), EXIT_FAILURE);
+    lookup.partitionName = partition;
+    lookup.partitionNameSize = 0;
+    assert_int_equal(cominitAutomountFindPartitionsOnDisk(&disk, &lookup, 1), EXIT_FAILURE);
+    lookup.partitionNameSize = sizeof(partition);
+    lookup.match = COMINIT_GPT_MATCH_PARTLABEL;
+    assert_int_equal(cominitAutomountFindPartitionsOnDisk(&disk, &lookup, 1), EXIT_FAILURE);
+    assert_false(lookup.found);
+}
@@ -0,0 +1,33 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-automount-find-partitions-on-disk-success.c
+ * @brief Implementation of a success case unit test for cominitAutomountFindPartitionsOnDisk().
+ */
+
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <string.h>
+
+#include "common.h"
+#include "utest-automount-find-partitions-on-disk.h"
+
+void cominitAutomountFindPartitionsOnDiskTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    uint8_t entries[COMINIT_TEST_ENTRY_COUNT * GPT_HEADER_DEFAULT_ENTRY_SIZE];
+    cominitGPTDisk_t disk;
+    char rootfs[COMINIT_ROOTFS_DEV_PATH_MAX] = {0};
+    char secureStorage[COMINIT_ROOTFS_DEV_PATH_MAX] = {0};
+    cominitGPTLookup_t lookups[] = {
+        {.guid = &COMINIT_ROOTFS_GUID_TYPE, .partitionName = rootfs, .partitionNameSize = sizeof(rootfs)},
+        {.guid = &COMINIT_SECURE_STORAGE_GUID_TYPE,
+         .partitionName = secureStorage,
+         .partitionNameSize = sizeof(secureStorage)},
+    };
+
+    cominitAutomountFindPartitionsOnDiskPrepareDisk(&disk, entries);
+
+    assert_int_equal(cominitAutomountFindPartitionsOnDisk(&disk, lookups, ARRAY_SIZE(lookups)), EXIT_SUCCESS);
+    assert_true(lookups[0].found);
+    assert_true(lookups[1].found);
+    assert_string_equal(rootfs, "/dev/mmcblk0p4");
+    assert_string_equal(secureStorage, "/dev/mmcblk0p2");
+}
@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-automount-find-partitions-on-disk.c
+ * @brief Implementation of an cominitAutomountFindPartitionsOnDisk() unit test group using cmocka.
+ */
+#include "utest-automount-find-partitions-on-disk.h"
+
+#include <string.h>
+
+#include "unit_test.h"
+
+void cominitAutomountFindPartitionsOnDiskPrepareDisk(cominitGPTDisk_t *disk, uint8_t *entries) {
+    /* type GUIDs as stored on disk, see COMINIT_SECURE_STORAGE_GUID_TYPE and COMINIT_ROOTFS_GUID_TYPE */
+    static const uint8_t secureStorageOnDisk[16] = {0xcb, 0x7c, 0x7d, 0xca, 0xed, 0x63, 0x53, 0x4c,
+                                                    0x86, 0x1c, 0x17, 0x42, 0x53, 0x60, 0x59, 0xcc};
+    static const uint8_t rootfsOnDisk[16] = {0x45, 0xb0, 0x21, 0xb9, 0xf0, 0x1d, 0xc3, 0x41,
+                                             0xaf, 0x44, 0x4c, 0x6f, 0x28, 0x0d, 0x3f, 0xae};
+
+    memset(disk, 0, sizeof(*disk));
+    strcpy(disk->diskName, "/dev/mmcblk0");
+    disk->blockSize = 512;
+    disk->hdr.partitionEntriesLba = 2;
+    disk->hdr.partitionEntrySize = GPT_HEADER_DEFAULT_ENTRY_SIZE;
+    disk->hdr.partitionEntryCount = COMINIT_TEST_ENTRY_COUNT;
+    disk->entries = entries;
+
+    memset(entries, 0, COMINIT_TEST_ENTRY_COUNT * GPT_HEADER_DEFAULT_ENTRY_SIZE);
+    memset(entries, 0x11, 16);
+    memcpy(entries + 1 * GPT_HEADER_DEFAULT_ENTRY_SIZE, secureStorageOnDisk, sizeof(secureStorageOnDisk));
+    memcpy(entries + 3 * GPT_HEADER_DEFAULT_ENTRY_SIZE, rootfsOnDisk, sizeof(rootfsOnDisk));
+
+    /* unique partition GUIDs and names, see COMINIT_TEST_SECURE_STORAGE_* and COMINIT_TEST_ROOTFS_* */
+    cominitGPTEntry_t *secureStorage = (cominitGPTEntry_t *)(entries + 1 * GPT_HEADER_DEFAULT_ENTRY_SIZE);
+    cominitGPTEntry_t *rootfs = (cominitGPTEntry_t *)(entries + 3 * GPT_HEADER_DEFAULT_ENTRY_SIZE);
+    static const uint8_t secureStorageName[] = {'S', 0, 0xe9, 0, 'c', 0, 0x3d, 0xd8, 0x12, 0xdd};
+    static const uint8_t rootfsName[] = {'r', 0, 'o', 0, 'o', 0, 't', 0, 'f', 0, 's', 0, 'A', 0};
+    memcpy(&secureStorage->uniqueGuid, &COMINIT_TEST_SECURE_STORAGE_PARTUUID, sizeof(secureStorage->uniqueGuid));
+    memcpy(secureStorage->name, secureStorageName, sizeof(secureStorageName));
+    memcpy(&rootfs->uniqueGuid, &COMINIT_TEST_ROOTFS_PARTUUID, sizeof(rootfs->uniqueGuid));
+    memcpy(rootfs->name, rootfsName, sizeof(rootfsName));
+}
+
+/**
+ * Run the unit tests for cominitAutomountFindPartitionsOnDisk().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitAutomountFindPartitionsOnDiskTestSuccess),
+        cmocka_unit_test(cominitAutomountFindPartitionsOnDiskTestMatchSuccess),
+        cmocka_unit_test(cominitAutomountFindPartitionsOnDiskTestFailure),
+        cmocka_unit_test(cominitAutomountFindPartitionsOnDiskTestParamFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
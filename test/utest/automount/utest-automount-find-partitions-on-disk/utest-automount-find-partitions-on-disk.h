@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-automount-find-partitions-on-disk.h
+ * @brief Header declaring cmocka unit test functions for cominitAutomountFindPartitionsOnDisk().
+ */
+#ifndef __UTEST_AUTOMOUNT_FIND_PARTITIONS_ON_DISK_H__
+#define __UTEST_AUTOMOUNT_FIND_PARTITIONS_ON_DISK_H__
+
+#include "automount.h"
+
+#define COMINIT_TEST_ENTRY_COUNT 4  ///< Number of entries in the partition table used by the tests.
+/** Unique partition GUID of the rootfs used by the tests. **/
+#define COMINIT_TEST_ROOTFS_PARTUUID COMINIT_GUID(0x6e1f9d2a, 0x8c4b, 0x4e0f, 0x9a31, 0x52b7c0d4e8f1ULL)
+/** Unique partition GUID of the secure storage used by the tests. **/
+#define COMINIT_TEST_SECURE_STORAGE_PARTUUID COMINIT_GUID(0x0d3c2b1a, 0x5f4e, 0x7a6b, 0x8c9d, 0xaebfc0d1e2f3ULL)
+#define COMINIT_TEST_ROOTFS_PARTLABEL "rootfsA"  ///< Partition name of the rootfs used by the tests.
+/** Partition name of the secure storage used by the tests, containing a two and a four Byte UTF-8 sequence. **/
+#define COMINIT_TEST_SECURE_STORAGE_PARTLABEL "S\xc3\xa9" "c\xf0\x9f\x94\x92"
+
+/**
+ * Prepares a disk with cached partition entries holding the secure storage as second and the rootfs as fourth
+ * partition, identifiable by type, unique partition GUID and name.
+ *
+ * @param disk      The disk to prepare.
+ * @param entries   Buffer for COMINIT_TEST_ENTRY_COUNT entries of the default size.
+ */
+void cominitAutomountFindPartitionsOnDiskPrepareDisk(cominitGPTDisk_t *disk, uint8_t *entries);
+
+/**
+ * Unit test for cominitAutomountFindPartitionsOnDisk() successful code path.
+ * @param state
+ */
+void cominitAutomountFindPartitionsOnDiskTestSuccess(void **state);
+
+/**
+ * Unit test for cominitAutomountFindPartitionsOnDisk() successful code path matching unique partition GUID and name.
+ * @param state
+ */
+void cominitAutomountFindPartitionsOnDiskTestMatchSuccess(void **state);
+
+/**
+ * Unit test for cominitAutomountFindPartitionsOnDisk() if not all partitions are present.
+ * @param state
+ */
+void cominitAutomountFindPartitionsOnDiskTestFailure(void **state);
+
+/**
+ * Unit test for cominitAutomountFindPartitionsOnDisk() if parameters are not initialized.
+ * @param state
+ */
+void cominitAutomountFindPartitionsOnDiskTestParamFailure(void **state);
+
+#endif /* __UTEST_AUTOMOUNT_FIND_PARTITIONS_ON_DISK_H__ */
@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-automount-parse-guid-failure.c
+ * @brief Implementation of a failure case unit test for cominitAutomountParseGuid().
+ */
+
+#include <cmocka_extensions/cmocka_extensions.h>
+
+#include "common.h"
+#include "utest-automount-parse-guid.h"
+
+void cominitAutomountParseGuidTestFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    cominitGuid_t guid;
+    static const char *const malformed[] = {
+        "",
+        "b921b045-1df0-41c3-af44-4c6f280d3fa",
+        "b921b045-1df0-41c3-af44-4c6f280d3faee",
+        "b921b045-1df0-41c3-af44-4c6f280d3fag",
+        "b921b0451-df0-41c3-af44-4c6f280d3fae",
+        "b921b045-1df0-41c3-af44_4c6f280d3fae",
+        "{b921b045-1df0-41c3-af44-4c6f280d3fa}",
+    };
+
+    for (size_t i = 0; i < ARRAY_SIZE(malformed); i++) {
+        assert_int_equal(cominitAutomountParseGuid(&guid, malformed[i]), EXIT_FAILURE);
+    }
+
+    assert_int_equal(cominitAutomountParseGuid(NULL, "b921b045-1df0-41c3-af44-4c6f280d3fae"), EXIT_FAILURE);
+    assert_int_equal(cominitAutomountParseGuid(&guid, NULL), EXIT_FAILURE);
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-automount-parse-guid-success.c
+ * @brief Implementation of a success case unit test for cominitAutomountParseGuid().
+ */
+
+#include <cmocka_extensions/cmocka_extensions.h>
+
+#include "common.h"
+#include "utest-automount-parse-guid.h"
+
+void cominitAutomountParseGuidTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    cominitGuid_t guid;
+
+    assert_int_equal(cominitAutomountParseGuid(&guid, "b921b045-1df0-41c3-af44-4c6f280d3fae"), EXIT_SUCCESS);
+    assert_memory_equal(guid.bytes, COMINIT_ROOTFS_GUID_TYPE.bytes, sizeof(guid.bytes));
+
+    assert_int_equal(cominitAutomountParseGuid(&guid, "CA7D7CCB-63ED-4C53-861C-1742536059CC"), EXIT_SUCCESS);
+    assert_memory_equal(guid.bytes, COMINIT_SECURE_STORAGE_GUID_TYPE.bytes, sizeof(guid.bytes));
+}
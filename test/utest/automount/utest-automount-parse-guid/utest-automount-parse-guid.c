@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-automount-parse-guid.c
+ * @brief Implementation of an cominitAutomountParseGuid() unit test group using cmocka.
+ */
+#include "utest-automount-parse-guid.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitAutomountParseGuid().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitAutomountParseGuidTestSuccess),
+        cmocka_unit_test(cominitAutomountParseGuidTestFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
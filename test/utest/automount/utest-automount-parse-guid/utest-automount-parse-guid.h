@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-automount-parse-guid.h
+ * @brief Header declaring cmocka unit test functions for cominitAutomountParseGuid().
+ */
+#ifndef __UTEST_AUTOMOUNT_PARSE_GUID_H__
+#define __UTEST_AUTOMOUNT_PARSE_GUID_H__
+
+#include "automount.h"
+
+/**
+ * Unit test for cominitAutomountParseGuid() successful code path.
+ * @param state
+ */
+void cominitAutomountParseGuidTestSuccess(void **state);
+
+/**
+ * Unit test for cominitAutomountParseGuid() with malformed GUIDs and invalid parameters.
+ * @param state
+ */
+void cominitAutomountParseGuidTestFailure(void **state);
+
+#endif /* __UTEST_AUTOMOUNT_PARSE_GUID_H__ */
@@ -0,0 +1,38 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-automount-parse-partition-spec-failure.c
+ * @brief Implementation of a failure case unit test for cominitAutomountParsePartitionSpec().
+ */
+
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <string.h>
+
+#include "common.h"
+#include "utest-automount-parse-partition-spec.h"
+
+void cominitAutomountParsePartitionSpecTestFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    cominitGPTLookup_t lookup = {0};
+    cominitGuid_t guid;
+    char tooLong[sizeof("PARTLABEL=") + GPT_ENTRY_LABEL_SIZE_MAX] = "PARTLABEL=";
+    static const char *const unsupported[] = {
+        "/dev/sda1",
+        "UUID=b921b045-1df0-41c3-af44-4c6f280d3fae",
+        "PARTUUID=b921b045-1df0-41c3-af44-4c6f280d3fae/PARTNROFF=1",
+        "PARTUUID=",
+        "PARTLABEL=",
+        "partlabel=rootfsA",
+    };
+
+    for (size_t i = 0; i < ARRAY_SIZE(unsupported); i++) {
+        assert_int_equal(cominitAutomountParsePartitionSpec(&lookup, &guid, unsupported[i]), EXIT_FAILURE);
+    }
+
+    memset(tooLong + strlen(tooLong), 'a', GPT_ENTRY_LABEL_SIZE_MAX);
+    tooLong[sizeof(tooLong) - 1] = '\0';
+    assert_int_equal(cominitAutomountParsePartitionSpec(&lookup, &guid, tooLong), EXIT_FAILURE);
+
+    assert_int_equal(cominitAutomountParsePartitionSpec(NULL, &guid, "PARTLABEL=rootfsA"), EXIT_FAILURE);
+    assert_int_equal(cominitAutomountParsePartitionSpec(&lookup, NULL, "PARTLABEL=rootfsA"), EXIT_FAILURE);
+    assert_int_equal(cominitAutomountParsePartitionSpec(&lookup, &guid, NULL), EXIT_FAILURE);
+}
@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-automount-parse-partition-spec-success.c
+ * @brief Implementation of a success case unit test for cominitAutomountParsePartitionSpec().
+ */
+
+#include <cmocka_extensions/cmocka_extensions.h>
+
+#include "common.h"
+#include "utest-automount-parse-partition-spec.h"
+
+void cominitAutomountParsePartitionSpecTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    const char *uuidSpec = "PARTUUID=b921b045-1df0-41c3-af44-4c6f280d3fae";
+    const char *labelSpec = "PARTLABEL=rootfsB";
+    cominitGPTLookup_t lookup = {0};
+    cominitGuid_t guid;
+
+    assert_int_equal(cominitAutomountParsePartitionSpec(&lookup, &guid, uuidSpec), EXIT_SUCCESS);
+    assert_int_equal(lookup.match, COMINIT_GPT_MATCH_PARTUUID);
+    assert_ptr_equal(lookup.guid, &guid);
+    assert_null(lookup.label);
+    assert_memory_equal(guid.bytes, COMINIT_ROOTFS_GUID_TYPE.bytes, sizeof(guid.bytes));
+
+    assert_int_equal(cominitAutomountParsePartitionSpec(&lookup, &guid, labelSpec), EXIT_SUCCESS);
+    assert_int_equal(lookup.match, COMINIT_GPT_MATCH_PARTLABEL);
+    assert_null(lookup.guid);
+    assert_ptr_equal(lookup.label, labelSpec + 10);
+    assert_string_equal(lookup.label, "rootfsB");
+}
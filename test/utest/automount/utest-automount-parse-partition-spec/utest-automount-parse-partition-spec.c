@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-automount-parse-partition-spec.c
+ * @brief Implementation of an cominitAutomountParsePartitionSpec() unit test group using cmocka.
+ */
+#include "utest-automount-parse-partition-spec.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitAutomountParsePartitionSpec().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitAutomountParsePartitionSpecTestSuccess),
+        cmocka_unit_test(cominitAutomountParsePartitionSpecTestFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-automount-parse-partition-spec.h
+ * @brief Header declaring cmocka unit test functions for cominitAutomountParsePartitionSpec().
+ */
+#ifndef __UTEST_AUTOMOUNT_PARSE_PARTITION_SPEC_H__
+#define __UTEST_AUTOMOUNT_PARSE_PARTITION_SPEC_H__
+
+#include "automount.h"
+
+/**
+ * Unit test for cominitAutomountParsePartitionSpec() successful code path.
+ * @param state
+ */
+void cominitAutomountParsePartitionSpecTestSuccess(void **state);
+
+/**
+ * Unit test for cominitAutomountParsePartitionSpec() with unsupported specifications and invalid parameters.
+ * @param state
+ */
+void cominitAutomountParsePartitionSpecTestFailure(void **state);
+
+#endif /* __UTEST_AUTOMOUNT_PARSE_PARTITION_SPEC_H__ */
@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-common-bytes-to-hex-failure.c
+ * @brief Implementation of failure case unit tests for cominitCommonBytesToHex().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+
+#include "common.h"
+#include "unit_test.h"
+#include "utest-common-bytes-to-hex.h"
+
+void cominitCommonBytesToHexTestFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    const uint8_t bytes[] = {0x12};
+    char hex[3];
+
+    assert_int_equal(cominitCommonBytesToHex(NULL, bytes, sizeof(bytes)), -1);
+    assert_int_equal(cominitCommonBytesToHex(hex, NULL, sizeof(bytes)), -1);
+}
@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-common-bytes-to-hex-success.c
+ * @brief Implementation of success case unit tests for cominitCommonBytesToHex().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "common.h"
+#include "unit_test.h"
+#include "utest-common-bytes-to-hex.h"
+
+void cominitCommonBytesToHexTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    const uint8_t bytes[] = {0x00, 0x01, 0x7f, 0x80, 0xab, 0xcd, 0xef, 0xff};
+    char hex[2 * 256 + 1];
+
+    assert_int_equal(cominitCommonBytesToHex(hex, bytes, sizeof(bytes)), 0);
+    assert_string_equal(hex, "00017f80abcdefff");
+
+    memset(hex, 'X', sizeof(hex));
+    assert_int_equal(cominitCommonBytesToHex(hex, bytes, 0), 0);
+    assert_string_equal(hex, "");
+
+    /* every Byte value is written like "%02x" does */
+    uint8_t all[256];
+    char expected[3];
+    for (size_t i = 0; i < sizeof(all); i++) {
+        all[i] = (uint8_t)i;
+    }
+    assert_int_equal(cominitCommonBytesToHex(hex, all, sizeof(all)), 0);
+    for (size_t i = 0; i < sizeof(all); i++) {
+        snprintf(expected, sizeof(expected), "%02x", all[i]);
+        assert_memory_equal(hex + 2 * i, expected, 2);
+    }
+    assert_int_equal(hex[2 * sizeof(all)], '\0');
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-common-bytes-to-hex.c
+ * @brief Implementation of an cominitCommonBytesToHex() unit test group using cmocka.
+ */
+#include "utest-common-bytes-to-hex.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitCommonBytesToHex().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitCommonBytesToHexTestSuccess),
+        cmocka_unit_test(cominitCommonBytesToHexTestFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
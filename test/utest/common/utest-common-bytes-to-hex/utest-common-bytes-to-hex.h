@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-common-bytes-to-hex.h
+ * @brief Header declaring cmocka unit test functions for cominitCommonBytesToHex().
+ */
+#ifndef __UTEST_COMMON_BYTES_TO_HEX_H__
+#define __UTEST_COMMON_BYTES_TO_HEX_H__
+
+/**
+ * Unit test for cominitCommonBytesToHex() success cases.
+ * @param state
+ */
+void cominitCommonBytesToHexTestSuccess(void **state);
+
+/**
+ * Unit test for cominitCommonBytesToHex() with invalid parameters.
+ * @param state
+ */
+void cominitCommonBytesToHexTestFailure(void **state);
+
+#endif /* __UTEST_COMMON_BYTES_TO_HEX_H__ */
@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-common-hex-to-bytes-failure.c
+ * @brief Implementation of failure case unit tests for cominitCommonHexToBytes().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+
+#include "common.h"
+#include "unit_test.h"
+#include "utest-common-hex-to-bytes.h"
+
+void cominitCommonHexToBytesTestFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    uint8_t bytes[4];
+    const char *invalid[] = {"0g", "g0", " 0", "0 ", "-1", "0x", "\xff" "0", ":0", "@0", "`0", "/0", "G0"};
+
+    assert_int_equal(cominitCommonHexToBytes(NULL, sizeof(bytes), "00", 2), -1);
+    assert_int_equal(cominitCommonHexToBytes(bytes, sizeof(bytes), NULL, 2), -1);
+
+    /* odd length and too long for the buffer */
+    assert_int_equal(cominitCommonHexToBytes(bytes, sizeof(bytes), "000", 3), -1);
+    assert_int_equal(cominitCommonHexToBytes(bytes, sizeof(bytes), "0011223344", 10), -1);
+
+    for (size_t i = 0; i < ARRAY_SIZE(invalid); i++) {
+        assert_int_equal(cominitCommonHexToBytes(bytes, sizeof(bytes), invalid[i], 2), -1);
+    }
+}
@@ -0,0 +1,42 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-common-hex-to-bytes-success.c
+ * @brief Implementation of success case unit tests for cominitCommonHexToBytes().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <string.h>
+
+#include "common.h"
+#include "unit_test.h"
+#include "utest-common-hex-to-bytes.h"
+
+void cominitCommonHexToBytesTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    const uint8_t expected[] = {0x00, 0x01, 0x7f, 0x80, 0xab, 0xcd, 0xef, 0xff};
+    const char *lower = "00017f80abcdefff";
+    const char *upper = "00017F80ABCDEFFF";
+    uint8_t bytes[sizeof(expected)];
+
+    assert_int_equal(cominitCommonHexToBytes(bytes, sizeof(bytes), lower, strlen(lower)), sizeof(expected));
+    assert_memory_equal(bytes, expected, sizeof(expected));
+    memset(bytes, 0, sizeof(bytes));
+    assert_int_equal(cominitCommonHexToBytes(bytes, sizeof(bytes), upper, strlen(upper)), sizeof(expected));
+    assert_memory_equal(bytes, expected, sizeof(expected));
+
+    /* only the given length is converted, the string does not need to be terminated */
+    assert_int_equal(cominitCommonHexToBytes(bytes, 1, "abXX", 2), 1);
+    assert_int_equal(bytes[0], 0xab);
+    assert_int_equal(cominitCommonHexToBytes(bytes, 0, "", 0), 0);
+
+    /* round trip of every Byte value */
+    uint8_t all[256];
+    uint8_t decoded[sizeof(all)];
+    char hex[2 * sizeof(all) + 1];
+    for (size_t i = 0; i < sizeof(all); i++) {
+        all[i] = (uint8_t)i;
+    }
+    assert_int_equal(cominitCommonBytesToHex(hex, all, sizeof(all)), 0);
+    assert_int_equal(cominitCommonHexToBytes(decoded, sizeof(decoded), hex, strlen(hex)), sizeof(all));
+    assert_memory_equal(decoded, all, sizeof(all));
+}
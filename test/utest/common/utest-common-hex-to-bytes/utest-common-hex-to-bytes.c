@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-common-hex-to-bytes.c
+ * @brief Implementation of an cominitCommonHexToBytes() unit test group using cmocka.
+ */
+#include "utest-common-hex-to-bytes.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitCommonHexToBytes().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitCommonHexToBytesTestSuccess),
+        cmocka_unit_test(cominitCommonHexToBytesTestFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-common-hex-to-bytes.h
+ * @brief Header declaring cmocka unit test functions for cominitCommonHexToBytes().
+ */
+#ifndef __UTEST_COMMON_HEX_TO_BYTES_H__
+#define __UTEST_COMMON_HEX_TO_BYTES_H__
+
+/**
+ * Unit test for cominitCommonHexToBytes() success cases.
+ * @param state
+ */
+void cominitCommonHexToBytesTestSuccess(void **state);
+
+/**
+ * Unit test for cominitCommonHexToBytes() with invalid parameters.
+ * @param state
+ */
+void cominitCommonHexToBytesTestFailure(void **state);
+
+#endif /* __UTEST_COMMON_HEX_TO_BYTES_H__ */
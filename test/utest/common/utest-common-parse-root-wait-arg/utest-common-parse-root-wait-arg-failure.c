@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-common-parse-root-wait-arg-failure.c
+ * @brief Implementation of failure case unit tests for cominitCommonParseRootWaitArg().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+
+#include "common.h"
+#include "unit_test.h"
+#include "utest-common-parse-root-wait-arg.h"
+
+void cominitCommonParseRootWaitArgTestFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitCliArgs_t argCtx = {.rootWaitMillis = 5000, .rootDelayMillis = 500};
+    const char *invalid[] = {"cominit.rootwait=",      "cominit.rootwait=-1",    "cominit.rootwait=1s",
+                             "cominit.rootwait= 1",    "cominit.rootwait=+1",    "cominit.rootdelay=",
+                             "cominit.rootdelay=0",    "cominit.rootdelay=-500", "cominit.rootdelay=0x10",
+                             "cominit.rootwait=99999999999999999999"};
+
+    assert_int_equal(cominitCommonParseRootWaitArg(NULL, "cominit.rootwait=1"), -1);
+    assert_int_equal(cominitCommonParseRootWaitArg(&argCtx, NULL), -1);
+
+    for (size_t i = 0; i < ARRAY_SIZE(invalid); i++) {
+        assert_int_equal(cominitCommonParseRootWaitArg(&argCtx, invalid[i]), -1);
+    }
+    assert_int_equal(argCtx.rootWaitMillis, 5000);
+    assert_int_equal(argCtx.rootDelayMillis, 500);
+}
@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-common-parse-root-wait-arg-success.c
+ * @brief Implementation of success case unit tests for cominitCommonParseRootWaitArg().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+
+#include "common.h"
+#include "unit_test.h"
+#include "utest-common-parse-root-wait-arg.h"
+
+void cominitCommonParseRootWaitArgTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitCliArgs_t argCtx = {.rootWaitMillis = 5000, .rootDelayMillis = 500};
+    /* the Kernel's parameters and similar names are left to other options */
+    const char *others[] = {"rootwait",           "rootwait=100",      "rootdelay=2",         "cominit.rootwait",
+                            "cominit.rootwaits=1", "cominit.rootdelay", "xcominit.rootwait=1", "root=/dev/sda1"};
+
+    assert_int_equal(cominitCommonParseRootWaitArg(&argCtx, "cominit.rootwait=20000"), 1);
+    assert_int_equal(argCtx.rootWaitMillis, 20000);
+    assert_int_equal(argCtx.rootDelayMillis, 500);
+
+    assert_int_equal(cominitCommonParseRootWaitArg(&argCtx, "cominit.rootdelay=50"), 1);
+    assert_int_equal(argCtx.rootWaitMillis, 20000);
+    assert_int_equal(argCtx.rootDelayMillis, 50);
+
+    /* try only once */
+    assert_int_equal(cominitCommonParseRootWaitArg(&argCtx, "cominit.rootwait=0"), 1);
+    assert_int_equal(argCtx.rootWaitMillis, 0);
+
+    for (size_t i = 0; i < ARRAY_SIZE(others); i++) {
+        assert_int_equal(cominitCommonParseRootWaitArg(&argCtx, others[i]), 0);
+    }
+    assert_int_equal(argCtx.rootWaitMillis, 0);
+    assert_int_equal(argCtx.rootDelayMillis, 50);
+}
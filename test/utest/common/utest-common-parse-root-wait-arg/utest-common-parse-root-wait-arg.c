@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-common-parse-root-wait-arg.c
+ * @brief Implementation of an cominitCommonParseRootWaitArg() unit test group using cmocka.
+ */
+#include "utest-common-parse-root-wait-arg.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitCommonParseRootWaitArg().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitCommonParseRootWaitArgTestSuccess),
+        cmocka_unit_test(cominitCommonParseRootWaitArgTestFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
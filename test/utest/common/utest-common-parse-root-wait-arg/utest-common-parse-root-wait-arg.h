@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-common-parse-root-wait-arg.h
+ * @brief Header declaring cmocka unit test functions for cominitCommonParseRootWaitArg().
+ */
+#ifndef __UTEST_COMMON_PARSE_ROOT_WAIT_ARG_H__
+#define __UTEST_COMMON_PARSE_ROOT_WAIT_ARG_H__
+
+/**
+ * Unit test for cominitCommonParseRootWaitArg() success cases.
+ * @param state
+ */
+void cominitCommonParseRootWaitArgTestSuccess(void **state);
+
+/**
+ * Unit test for cominitCommonParseRootWaitArg() with invalid parameters.
+ * @param state
+ */
+void cominitCommonParseRootWaitArgTestFailure(void **state);
+
+#endif /* __UTEST_COMMON_PARSE_ROOT_WAIT_ARG_H__ */
@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crc32-compute-success.c
+ * @brief Implementation of success case unit tests for cominitCrc32().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <string.h>
+
+#include "common.h"
+#include "crc32.h"
+#include "unit_test.h"
+#include "utest-crc32-compute.h"
+
+/**
+ * Computes the CRC32 bit by bit as reference for the optimized implementation.
+ *
+ * @param buf   The data to compute the checksum over.
+ * @param len   The size of @p buf in Bytes.
+ *
+ * @return  The CRC32 of @p buf
+ */
+static uint32_t cominitCrc32TestReference(const uint8_t *buf, size_t len) {
+    uint32_t c = 0xffffffffu;
+
+    for (size_t i = 0; i < len; i++) {
+        c ^= buf[i];
+        for (int bit = 0; bit < 8; bit++) {
+            c = (c & 1) ? (c >> 1) ^ 0xedb88320u : c >> 1;
+        }
+    }
+
+    return ~c;
+}
+
+void cominitCrc32TestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    const char check[] = "123456789";
+    const char fox[] = "The quick brown fox jumps over the lazy dog";
+
+    assert_int_equal(cominitCrc32(0, check, strlen(check)), 0xcbf43926u);
+    assert_int_equal(cominitCrc32(0, fox, strlen(fox)), 0x414fa339u);
+    assert_int_equal(cominitCrc32(0, check, 0), 0);
+
+    /* the checksum can be computed piecewise */
+    uint32_t crc = cominitCrc32(0, check, 3);
+    crc = cominitCrc32(crc, check + 3, strlen(check) - 3);
+    assert_int_equal(crc, 0xcbf43926u);
+}
+
+void cominitCrc32TestReferenceSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    uint8_t buf[16 * 1024 + 7];
+    uint32_t seed = 0x12345678u;
+    for (size_t i = 0; i < sizeof(buf); i++) {
+        seed = seed * 1103515245u + 12345u;
+        buf[i] = (uint8_t)(seed >> 16);
+    }
+
+    /* all lengths around the 8 Byte blocks and all alignments of the start */
+    for (size_t offset = 0; offset < 8; offset++) {
+        for (size_t len = 0; len < 64; len++) {
+            assert_int_equal(cominitCrc32(0, buf + offset, len), cominitCrc32TestReference(buf + offset, len));
+        }
+    }
+    assert_int_equal(cominitCrc32(0, buf, sizeof(buf)), cominitCrc32TestReference(buf, sizeof(buf)));
+    assert_int_equal(cominitCrc32(0, buf + 1, sizeof(buf) - 1), cominitCrc32TestReference(buf + 1, sizeof(buf) - 1));
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crc32-compute.c
+ * @brief Implementation of an cominitCrc32() unit test group using cmocka.
+ */
+#include "utest-crc32-compute.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitCrc32().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitCrc32TestSuccess),
+        cmocka_unit_test(cominitCrc32TestReferenceSuccess),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
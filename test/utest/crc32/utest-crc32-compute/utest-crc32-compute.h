@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crc32-compute.h
+ * @brief Header declaring cmocka unit test functions for cominitCrc32().
+ */
+#ifndef __UTEST_CRC32_COMPUTE_H__
+#define __UTEST_CRC32_COMPUTE_H__
+
+/**
+ * Unit test for cominitCrc32() with known check values.
+ * @param state
+ */
+void cominitCrc32TestSuccess(void **state);
+
+/**
+ * Unit test for cominitCrc32() comparing against a bitwise reference implementation.
+ * @param state
+ */
+void cominitCrc32TestReferenceSuccess(void **state);
+
+#endif /* __UTEST_CRC32_COMPUTE_H__ */
@@ -50,6 +50,7 @@ int cominitCryptoCreateDigestTestSuccessSetup(void **state) {
 int cominitCryptoCreateDigestTestSuccessTeardown(void **state) {
     struct testContext *testCtx = *state;
 
+    cominitCryptoReleaseKey();
     if (testCtx != NULL) {
         if (testCtx->keyfile != NULL) {
             unlink(testCtx->keyfile);
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crypto-embedded-key-failure.c
+ * @brief Implementation of a failure case unit test for using the built-in public key.
+ */
+#include <stdlib.h>
+
+#include "common.h"
+#include "crypto.h"
+#include "unit_test.h"
+#include "utest-crypto-embedded-key.h"
+
+void cominitCryptoEmbeddedKeyTestCorruptedDataFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    unsigned char corruptedData[] = "12345";
+    size_t len = strlen((char *)corruptedData);
+
+    assert_int_not_equal(
+        cominitCryptoVerifySignature(corruptedData, len, cominitTestSignature, COMINIT_CRYPTO_EMBEDDED_KEY), 0);
+    cominitCryptoReleaseKey();
+}
@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crypto-embedded-key-rootfskey.c
+ * @brief Built-in key and test data for the cominitCryptoVerifySignature() embedded key unit tests.
+ *
+ * The key definitions have been generated from #cominitTestPubKey the same way CMake does from rootfskey.c.in.
+ */
+#include "rootfskey.h"
+#include "utest-crypto-embedded-key.h"
+
+const uint8_t cominitRootfsKeyModulus[] = {
+    0xc3, 0x16, 0x62, 0xdc, 0x8c, 0x59, 0x4d, 0xd4, 0x57, 0x0a, 0x1b, 0xf4, 0x5c, 0xe2, 0xa0, 0xbc, 0xd0, 0x06, 0x8e,
+    0x04, 0xd1, 0x7f, 0x3c, 0x52, 0x26, 0x35, 0x33, 0xa7, 0x30, 0xec, 0xa5, 0xb6, 0x93, 0xad, 0x45, 0x80, 0xeb, 0xd8,
+    0x29, 0xfc, 0xd9, 0x7c, 0x01, 0x9d, 0x77, 0xf4, 0x39, 0xff, 0x2c, 0xd4, 0xae, 0x3f, 0x5e, 0x94, 0x19, 0xa6, 0x70,
+    0x98, 0x77, 0xec, 0xa2, 0x5c, 0x42, 0xcf, 0xd6, 0x6d, 0x08, 0x7a, 0x21, 0x88, 0x20, 0xed, 0x20, 0x0e, 0x87, 0x9a,
+    0xe9, 0x66, 0xd2, 0xe9, 0x70, 0xa4, 0x5f, 0x3f, 0xe5, 0x67, 0xeb, 0x89, 0x62, 0x43, 0xd0, 0x85, 0xa2, 0x03, 0x3e,
+    0x21, 0x50, 0x7d, 0x29, 0x14, 0x06, 0x72, 0x79, 0x62, 0x93, 0x5b, 0x70, 0xf0, 0xbd, 0x51, 0xb9, 0x0c, 0x44, 0x87,
+    0xa9, 0xf0, 0xc7, 0x7c, 0x74, 0x35, 0xf1, 0x12, 0xb7, 0xc0, 0xd0, 0x8d, 0xd4, 0xda, 0x19, 0x7e, 0x40, 0x74, 0x4f,
+    0xd2, 0xf5, 0x38, 0x3e, 0x22, 0x0f, 0xba, 0x68, 0x3c, 0x2e, 0x2d, 0x14, 0x05, 0xdc, 0x21, 0x24, 0xb5, 0x72, 0x6e,
+    0x1d, 0x10, 0xfa, 0x2a, 0x18, 0xc0, 0xea, 0xd3, 0x95, 0xd2, 0xe3, 0x5d, 0xc5, 0x23, 0xaf, 0xda, 0x78, 0x2b, 0x71,
+    0x2d, 0x08, 0x04, 0x22, 0x60, 0x20, 0x9c, 0x5c, 0xab, 0x5c, 0xe3, 0x2b, 0x2f, 0x64, 0x0c, 0x0d, 0xfb, 0x27, 0x03,
+    0xf5, 0x37, 0x8d, 0xeb, 0xc8, 0x17, 0xd2, 0x0d, 0x61, 0x14, 0x46, 0x7a, 0xe0, 0x8d, 0x2c, 0xc1, 0x92, 0x4f, 0x3e,
+    0x41, 0x33, 0xda, 0x77, 0xf4, 0x56, 0x5d, 0xb6, 0x8e, 0x2c, 0xb8, 0x33, 0x23, 0x60, 0xf6, 0xee, 0x25, 0x1d, 0x54,
+    0x85, 0x30, 0x6f, 0x40, 0x2a, 0xda, 0xa4, 0xd9, 0x27, 0xf9, 0xdd, 0x8b, 0x23, 0x0e, 0x5d, 0x4a, 0x1a, 0x60, 0xf1,
+    0xe3, 0x78, 0x01, 0x6f, 0x2f, 0x33, 0xc7, 0x55, 0x2d};
+const size_t cominitRootfsKeyModulusLen = sizeof(cominitRootfsKeyModulus);
+
+const uint8_t cominitRootfsKeyExponent[] = {0x01, 0x00, 0x01};
+const size_t cominitRootfsKeyExponentLen = sizeof(cominitRootfsKeyExponent);
+
+const uint8_t cominitRootfsKeyDerDigest[SHA256_LEN] = {
+    0xdc, 0xc9, 0xec, 0xa8, 0x82, 0x30, 0xa6, 0x5e, 0xd5, 0x0c, 0xcf, 0xa3, 0xec, 0x17, 0x7a, 0xcd,
+    0x56, 0xc0, 0xe1, 0xb0, 0xed, 0xcc, 0x5a, 0x16, 0x4f, 0xab, 0x5b, 0x6d, 0xd2, 0xe0, 0x03, 0xfc};
+
+const char cominitTestPubKey[] =
+    "-----BEGIN PUBLIC KEY-----\n"
+    "MIIBIjANBgkqhkiG9w0BAQEFAAOCAQ8AMIIBCgKCAQEAwxZi3IxZTdRXChv0XOKg\n"
+    "vNAGjgTRfzxSJjUzpzDspbaTrUWA69gp/Nl8AZ139Dn/LNSuP16UGaZwmHfsolxC\n"
+    "z9ZtCHohiCDtIA6Hmulm0ulwpF8/5WfriWJD0IWiAz4hUH0pFAZyeWKTW3DwvVG5\n"
+    "DESHqfDHfHQ18RK3wNCN1NoZfkB0T9L1OD4iD7poPC4tFAXcISS1cm4dEPoqGMDq\n"
+    "05XS413FI6/aeCtxLQgEImAgnFyrXOMrL2QMDfsnA/U3jevIF9INYRRGeuCNLMGS\n"
+    "Tz5BM9p39FZdto4suDMjYPbuJR1UhTBvQCrapNkn+d2LIw5dShpg8eN4AW8vM8dV\n"
+    "LQIDAQAB\n"
+    "-----END PUBLIC KEY-----\n";
+
+/* Signature of "1234", see utest-crypto-verify-signature-success.c on how to generate it. */
+const uint8_t cominitTestSignature[COMINIT_TEST_SIGNATURE_SIZE] = {
+    0xb4, 0xb9, 0x78, 0x3e, 0x77, 0x2e, 0x82, 0xd5, 0xce, 0x05, 0x10, 0x0c, 0xf8, 0x41, 0xea, 0x70, 0xdb, 0xb0, 0x24,
+    0x41, 0x9f, 0xcd, 0x6e, 0x1f, 0x92, 0xd7, 0x7c, 0xf1, 0xba, 0xec, 0x5a, 0x73, 0xb9, 0x26, 0x69, 0xb6, 0x06, 0xcd,
+    0x6e, 0xb0, 0x8e, 0x7f, 0xe6, 0x77, 0xc3, 0xf8, 0xd8, 0x89, 0xe7, 0xb0, 0x1d, 0x52, 0xf2, 0xf9, 0x92, 0x41, 0x2e,
+    0x10, 0xbf, 0x28, 0x68, 0xac, 0x27, 0x7e, 0x2f, 0x29, 0x8d, 0xc1, 0x31, 0x7c, 0x77, 0x70, 0xf5, 0x7d, 0x27, 0xea,
+    0x55, 0x81, 0xab, 0x90, 0x73, 0x97, 0xe2, 0x03, 0xb8, 0x4b, 0x44, 0x0a, 0x3c, 0x5c, 0xa5, 0x3f, 0xd2, 0x0d, 0x34,
+    0xaf, 0x2f, 0x17, 0x9e, 0x51, 0x7b, 0x98, 0x26, 0xe7, 0x5a, 0x5d, 0xc1, 0xb6, 0x72, 0xbd, 0x37, 0xe8, 0x5c, 0xec,
+    0x41, 0xfe, 0x20, 0x87, 0x69, 0xec, 0xd7, 0x2c, 0x06, 0x06, 0x6e, 0xe3, 0x18, 0x31, 0xe5, 0xb6, 0xb5, 0xf9, 0x32,
+    0x83, 0x84, 0x21, 0x97, 0x25, 0xcf, 0x3b, 0xc2, 0xa3, 0x2c, 0xbd, 0xdf, 0x6f, 0xf5, 0xc6, 0xa8, 0x29, 0x5f, 0xf3,
+    0x0c, 0x90, 0xe3, 0xf1, 0xdd, 0xc3, 0x33, 0x1a, 0xf2, 0x5d, 0x77, 0xc8, 0xdc, 0x55, 0x97, 0xf1, 0xa8, 0xbb, 0x9c,
+    0xf5, 0xee, 0xbb, 0x77, 0x4a, 0x9c, 0x46, 0x54, 0x4b, 0x5f, 0x32, 0x30, 0x80, 0x2c, 0x9b, 0xd7, 0xad, 0x1b, 0x47,
+    0x64, 0x39, 0xb8, 0x1d, 0x4b, 0x03, 0xca, 0xd3, 0x3d, 0x24, 0x1a, 0x61, 0x15, 0x2e, 0xb0, 0x36, 0xd0, 0xfe, 0x7d,
+    0xe1, 0x10, 0x96, 0x28, 0xa3, 0x7f, 0x3c, 0x61, 0xa2, 0xbe, 0x1b, 0x3c, 0xfe, 0xd2, 0xcd, 0x8f, 0x4a, 0x34, 0xe0,
+    0xc8, 0x0e, 0xf8, 0xf3, 0x56, 0x18, 0xa3, 0x48, 0x4f, 0xd8, 0x46, 0x03, 0x12, 0x89, 0xf8, 0xdf, 0xf8, 0x71, 0xc3,
+    0x85, 0x2d, 0xbf, 0x92, 0xa6, 0xc7, 0xe0, 0x9c, 0xae};
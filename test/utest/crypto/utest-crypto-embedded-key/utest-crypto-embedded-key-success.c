@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crypto-embedded-key-success.c
+ * @brief Implementation of success case unit tests for using the built-in public key.
+ */
+#include <stdlib.h>
+
+#include "common.h"
+#include "crypto.h"
+#include "rootfskey.h"
+#include "unit_test.h"
+#include "utest-crypto-embedded-key.h"
+
+int cominitCryptoEmbeddedKeyTestDigestSuccessSetup(void **state) {
+    struct testContext *testCtx = NULL;
+
+    testCtx = calloc(1, sizeof(struct testContext));
+    if (testCtx != NULL) {
+        char template[] = "/tmp/keyfile-XXXXXX";
+        testCtx->fd = mkstemp(template);
+        testCtx->keyfile = strdup(template);
+        if (write(testCtx->fd, cominitTestPubKey, strlen(cominitTestPubKey)) != (ssize_t)strlen(cominitTestPubKey)) {
+            close(testCtx->fd);
+            free(testCtx->keyfile);
+            free(testCtx);
+            return errno;
+        };
+        *state = testCtx;
+        close(testCtx->fd);
+        return 0;
+    }
+
+    return -1;
+}
+
+int cominitCryptoEmbeddedKeyTestDigestSuccessTeardown(void **state) {
+    struct testContext *testCtx = *state;
+
+    cominitCryptoReleaseKey();
+    if (testCtx != NULL) {
+        if (testCtx->keyfile != NULL) {
+            unlink(testCtx->keyfile);
+            free(testCtx->keyfile);
+        }
+        free(testCtx);
+    }
+
+    return 0;
+}
+
+void cominitCryptoEmbeddedKeyTestVerifySuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    unsigned char data[] = "1234";
+    size_t len = strlen((char *)data);
+
+    assert_int_equal(cominitCryptoVerifySignature(data, len, cominitTestSignature, COMINIT_CRYPTO_EMBEDDED_KEY), 0);
+    cominitCryptoReleaseKey();
+}
+
+void cominitCryptoEmbeddedKeyTestDigestSuccess(void **state) {
+    struct testContext *testCtx = *state;
+    unsigned char embeddedDigest[SHA256_LEN] = {0};
+    unsigned char keyfileDigest[SHA256_LEN] = {0};
+
+    assert_int_equal(cominitCreateSHA256DigestfromKeyfile(COMINIT_CRYPTO_EMBEDDED_KEY, embeddedDigest, SHA256_LEN), 0);
+    assert_memory_equal(embeddedDigest, cominitRootfsKeyDerDigest, SHA256_LEN);
+
+    assert_int_equal(cominitCreateSHA256DigestfromKeyfile(testCtx->keyfile, keyfileDigest, SHA256_LEN), 0);
+    assert_memory_equal(keyfileDigest, embeddedDigest, SHA256_LEN);
+}
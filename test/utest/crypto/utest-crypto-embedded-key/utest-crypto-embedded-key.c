@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crypto-embedded-key.c
+ * @brief Implementation of a built-in public key unit test group using cmocka.
+ */
+#include "utest-crypto-embedded-key.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for the built-in public key.
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitCryptoEmbeddedKeyTestVerifySuccess),
+        cmocka_unit_test_setup_teardown(cominitCryptoEmbeddedKeyTestDigestSuccess,
+                                        cominitCryptoEmbeddedKeyTestDigestSuccessSetup,
+                                        cominitCryptoEmbeddedKeyTestDigestSuccessTeardown),
+        cmocka_unit_test(cominitCryptoEmbeddedKeyTestCorruptedDataFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
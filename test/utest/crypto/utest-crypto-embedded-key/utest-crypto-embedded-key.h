@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crypto-embedded-key.h
+ * @brief Header declaring cmocka unit test functions for using the built-in public key.
+ */
+#ifndef __UTEST_CRYPTO_EMBEDDED_KEY_H__
+#define __UTEST_CRYPTO_EMBEDDED_KEY_H__
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/** Size (in Bytes) of #cominitTestSignature. **/
+#define COMINIT_TEST_SIGNATURE_SIZE 256
+
+/** The built-in public key in PEM format. **/
+extern const char cominitTestPubKey[];
+/** sha256/RSASSA-PSS signature of "1234" made with the private part of #cominitTestPubKey. **/
+extern const uint8_t cominitTestSignature[COMINIT_TEST_SIGNATURE_SIZE];
+
+struct testContext {
+    int fd;
+    char *keyfile;
+};
+
+/**
+ * Unit test for cominitCryptoVerifySignature() successful code path using the built-in key.
+ * @param state
+ */
+void cominitCryptoEmbeddedKeyTestVerifySuccess(void **state);
+
+/**
+ * Unit test for cominitCreateSHA256DigestfromKeyfile() comparing the precomputed digest of the built-in key against
+ * the one computed from the same key in PEM format.
+ * @param state
+ */
+void cominitCryptoEmbeddedKeyTestDigestSuccess(void **state);
+int cominitCryptoEmbeddedKeyTestDigestSuccessSetup(void **state);
+int cominitCryptoEmbeddedKeyTestDigestSuccessTeardown(void **state);
+
+/**
+ * Unit test for cominitCryptoVerifySignature() with corrupted data using the built-in key.
+ * @param state
+ */
+void cominitCryptoEmbeddedKeyTestCorruptedDataFailure(void **state);
+
+#endif /* __UTEST_CRYPTO_EMBEDDED_KEY_H__ */
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crypto-verify-signature-alg-failure.c
+ * @brief Implementation of failure case unit tests for cominitCryptoVerifySignatureAlg().
+ */
+#include <stdlib.h>
+
+#include "common.h"
+#include "crypto.h"
+#include "unit_test.h"
+#include "utest-crypto-verify-signature-alg.h"
+
+static const char cominitPubKey[] =
+    "-----BEGIN PUBLIC KEY-----\n"
+    "MFkwEwYHKoZIzj0CAQYIKoZIzj0DAQcDQgAElmNkQ7hoWqnBVR/bR7KYhiYMhyJb\n"
+    "e3BxBu44pqi5R10dmAfyqjhDfuMWRMdyvu9KdP/02JsRdtGxdm+tkJdNig==\n"
+    "-----END PUBLIC KEY-----\n";
+
+/* Generate key and signature:
+ *
+ * openssl ecparam -name prime256v1 -genkey -noout -out private.pem
+ * openssl ec -in private.pem -pubout -out public.pem
+ * printf "1234" | openssl dgst -sha256 -sign private.pem > signature
+ *
+ * xxd -i signature > signature.hex
+ */
+static unsigned char cominitSignature[] = {
+    0x30, 0x46, 0x02, 0x21, 0x00, 0xb8, 0x41, 0x45, 0xfb, 0x82, 0x85, 0xa1, 0xf3, 0xc2, 0x9c, 0x0c, 0x77, 0xc7, 0xe1,
+    0x42, 0xfb, 0xda, 0x5d, 0x44, 0x7b, 0x95, 0x66, 0xb9, 0xc4, 0x6a, 0xc5, 0x95, 0x25, 0xb9, 0x9f, 0xa4, 0xe2, 0x02,
+    0x21, 0x00, 0xd3, 0x82, 0x24, 0xda, 0xee, 0x3f, 0xa6, 0xa7, 0x63, 0x7a, 0x36, 0x71, 0xf4, 0x75, 0xbd, 0x04, 0x23,
+    0x96, 0x6c, 0x3e, 0x45, 0x89, 0xdf, 0x19, 0xff, 0x2e, 0xcf, 0x02, 0x2a, 0x0a, 0x38, 0xc2};
+
+int cominitCryptoVerifySignatureAlgTestFailureSetup(void **state) {
+    struct testContext *testCtx = NULL;
+
+    testCtx = calloc(1, sizeof(struct testContext));
+    if (testCtx != NULL) {
+        char template[] = "/tmp/keyfile-XXXXXX";
+        testCtx->fd = mkstemp(template);
+        testCtx->keyfile = strdup(template);
+        if (write(testCtx->fd, cominitPubKey, strlen(cominitPubKey)) != (ssize_t)strlen(cominitPubKey)) {
+            close(testCtx->fd);
+            free(testCtx->keyfile);
+            free(testCtx);
+            return errno;
+        };
+        *state = testCtx;
+        close(testCtx->fd);
+        return 0;
+    }
+
+    return -1;
+}
+
+int cominitCryptoVerifySignatureAlgTestFailureTeardown(void **state) {
+    struct testContext *testCtx = *state;
+
+    cominitCryptoReleaseKey();
+    if (testCtx != NULL) {
+        if (testCtx->keyfile != NULL) {
+            unlink(testCtx->keyfile);
+            free(testCtx->keyfile);
+        }
+        free(testCtx);
+    }
+
+    return 0;
+}
+
+void cominitCryptoVerifySignatureAlgTestCorruptedDataFailure(void **state) {
+    struct testContext *testCtx = *state;
+    unsigned char corruptedData[] = "12345";
+    size_t len = strlen((char *)corruptedData);
+
+    assert_int_not_equal(cominitCryptoVerifySignatureAlg(corruptedData, len, cominitSignature, sizeof(cominitSignature),
+                                                         COMINIT_CRYPTO_SIGALG_ECDSA_P256, testCtx->keyfile),
+                         0);
+}
+
+void cominitCryptoVerifySignatureAlgTestWrongAlgFailure(void **state) {
+    struct testContext *testCtx = *state;
+    unsigned char data[] = "1234";
+    size_t len = strlen((char *)data);
+
+    assert_int_not_equal(cominitCryptoVerifySignatureAlg(data, len, cominitSignature, sizeof(cominitSignature),
+                                                         COMINIT_CRYPTO_SIGALG_RSA_PSS, testCtx->keyfile),
+                         0);
+}
+
+void cominitCryptoVerifySignatureAlgTestTruncatedSignatureFailure(void **state) {
+    struct testContext *testCtx = *state;
+    unsigned char data[] = "1234";
+    size_t len = strlen((char *)data);
+
+    assert_int_not_equal(cominitCryptoVerifySignatureAlg(data, len, cominitSignature, sizeof(cominitSignature) - 1,
+                                                         COMINIT_CRYPTO_SIGALG_ECDSA_P256, testCtx->keyfile),
+                         0);
+    assert_int_not_equal(cominitCryptoVerifySignatureAlg(data, len, cominitSignature, 1,
+                                                         COMINIT_CRYPTO_SIGALG_ECDSA_P256, testCtx->keyfile),
+                         0);
+}
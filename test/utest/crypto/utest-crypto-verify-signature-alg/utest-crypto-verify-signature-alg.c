@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crypto-verify-signature-alg.c
+ * @brief Implementation of a cominitCryptoVerifySignatureAlg() unit test group using cmocka.
+ */
+#include "utest-crypto-verify-signature-alg.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitCryptoVerifySignatureAlg().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(cominitCryptoVerifySignatureAlgTestSuccess,
+                                        cominitCryptoVerifySignatureAlgTestSuccessSetup,
+                                        cominitCryptoVerifySignatureAlgTestSuccessTeardown),
+        cmocka_unit_test_setup_teardown(cominitCryptoVerifySignatureAlgTestCorruptedDataFailure,
+                                        cominitCryptoVerifySignatureAlgTestFailureSetup,
+                                        cominitCryptoVerifySignatureAlgTestFailureTeardown),
+        cmocka_unit_test_setup_teardown(cominitCryptoVerifySignatureAlgTestWrongAlgFailure,
+                                        cominitCryptoVerifySignatureAlgTestFailureSetup,
+                                        cominitCryptoVerifySignatureAlgTestFailureTeardown),
+        cmocka_unit_test_setup_teardown(cominitCryptoVerifySignatureAlgTestTruncatedSignatureFailure,
+                                        cominitCryptoVerifySignatureAlgTestFailureSetup,
+                                        cominitCryptoVerifySignatureAlgTestFailureTeardown),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
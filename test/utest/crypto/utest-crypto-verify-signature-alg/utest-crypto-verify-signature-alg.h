@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crypto-verify-signature-alg.h
+ * @brief Header declaring cmocka unit test functions for cominitCryptoVerifySignatureAlg().
+ */
+#ifndef __UTEST_CRYPTO_VERIFY_SIGNATURE_ALG_H__
+#define __UTEST_CRYPTO_VERIFY_SIGNATURE_ALG_H__
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+struct testContext {
+    int fd;
+    char *keyfile;
+};
+
+/**
+ * Unit test for cominitCryptoVerifySignatureAlg() successful code path using an ECDSA P-256 key.
+ * @param state
+ */
+void cominitCryptoVerifySignatureAlgTestSuccess(void **state);
+int cominitCryptoVerifySignatureAlgTestSuccessSetup(void **state);
+int cominitCryptoVerifySignatureAlgTestSuccessTeardown(void **state);
+
+int cominitCryptoVerifySignatureAlgTestFailureSetup(void **state);
+int cominitCryptoVerifySignatureAlgTestFailureTeardown(void **state);
+/**
+ * Unit test for cominitCryptoVerifySignatureAlg() with corrupted data.
+ * @param state
+ */
+void cominitCryptoVerifySignatureAlgTestCorruptedDataFailure(void **state);
+/**
+ * Unit test for cominitCryptoVerifySignatureAlg() with an algorithm not matching the key type.
+ * @param state
+ */
+void cominitCryptoVerifySignatureAlgTestWrongAlgFailure(void **state);
+/**
+ * Unit test for cominitCryptoVerifySignatureAlg() with a signature buffer too small for the DER structure.
+ * @param state
+ */
+void cominitCryptoVerifySignatureAlgTestTruncatedSignatureFailure(void **state);
+
+#endif /* __UTEST_CRYPTO_VERIFY_SIGNATURE_ALG_H__ */
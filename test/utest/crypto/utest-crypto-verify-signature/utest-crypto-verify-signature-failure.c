@@ -108,6 +108,7 @@ int cominitCryptoVerifySignatureTestCorruptedDataFailureSetup(void **state) {
 int cominitCryptoVerifySignatureTestCorruptedDataFailureTeardown(void **state) {
     struct testContext *testCtx = *state;
 
+    cominitCryptoReleaseKey();
     if (testCtx != NULL) {
         if (testCtx->keyfile != NULL) {
             unlink(testCtx->keyfile);
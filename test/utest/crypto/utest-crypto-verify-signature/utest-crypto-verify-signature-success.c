@@ -108,6 +108,7 @@ int cominitCryptoVerifySignatureTestSuccessSetup(void **state) {
 int cominitCryptoVerifySignatureTestSuccessTeardown(void **state) {
     struct testContext *testCtx = *state;
 
+    cominitCryptoReleaseKey();
     if (testCtx != NULL) {
         if (testCtx->keyfile != NULL) {
             unlink(testCtx->keyfile);
@@ -127,3 +128,18 @@ void cominitCryptoVerifySignatureTestSuccess(void **state) {
 
     assert_int_equal(cominitCryptoVerifySignature(data, len, cominitSignature, testCtx->keyfile), 0);
 }
+
+void cominitCryptoVerifySignatureTestCachedKeySuccess(void **state) {
+    struct testContext *testCtx = *state;
+    unsigned char data[] = "1234";
+    size_t len = strlen((char *)data);
+
+    assert_int_equal(cominitCryptoVerifySignature(data, len, cominitSignature, testCtx->keyfile), 0);
+
+    // The key must not be read from the file again as long as it is cached.
+    unlink(testCtx->keyfile);
+    assert_int_equal(cominitCryptoVerifySignature(data, len, cominitSignature, testCtx->keyfile), 0);
+
+    cominitCryptoReleaseKey();
+    assert_int_not_equal(cominitCryptoVerifySignature(data, len, cominitSignature, testCtx->keyfile), 0);
+}
@@ -17,6 +17,9 @@ int main(void) {
         cmocka_unit_test_setup_teardown(cominitCryptoVerifySignatureTestSuccess,
                                         cominitCryptoVerifySignatureTestSuccessSetup,
                                         cominitCryptoVerifySignatureTestSuccessTeardown),
+        cmocka_unit_test_setup_teardown(cominitCryptoVerifySignatureTestCachedKeySuccess,
+                                        cominitCryptoVerifySignatureTestSuccessSetup,
+                                        cominitCryptoVerifySignatureTestSuccessTeardown),
         cmocka_unit_test_setup_teardown(cominitCryptoVerifySignatureTestCorruptedDataFailure,
                                         cominitCryptoVerifySignatureTestCorruptedDataFailureSetup,
                                         cominitCryptoVerifySignatureTestCorruptedDataFailureTeardown),
@@ -25,6 +25,12 @@ void cominitCryptoVerifySignatureTestSuccess(void **state);
 int cominitCryptoVerifySignatureTestSuccessSetup(void **state);
 int cominitCryptoVerifySignatureTestSuccessTeardown(void **state);
 
+/**
+ * Unit test for cominitCryptoVerifySignature() using the cached key after the keyfile has been removed.
+ * @param state
+ */
+void cominitCryptoVerifySignatureTestCachedKeySuccess(void **state);
+
 /**
  * Unit test for cominitCreateSHA256DigestfromKeyfile() with corrupted data.
  * @param state
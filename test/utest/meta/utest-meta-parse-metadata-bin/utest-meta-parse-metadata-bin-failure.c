@@ -0,0 +1,193 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-meta-parse-metadata-bin-failure.c
+ * @brief Implementation of failure case unit tests for cominitParseMetadataBin().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <string.h>
+
+#include "common.h"
+#include "meta.h"
+#include "unit_test.h"
+#include "utest-meta-parse-metadata-bin.h"
+
+/** Number of mutated metadata blocks parsed per seed. **/
+#define COMINIT_TEST_MUTATIONS 20000
+
+/**
+ * Start binary metadata with valid settings records.
+ *
+ * @param bin    The binary metadata to initialize.
+ * @param crypt  The value of the crypt record.
+ */
+static void cominitTestMetaBinSettings(cominitTestMetaBin_t *bin, uint8_t crypt) {
+    const uint8_t ro = 1;
+
+    cominitTestMetaBinInit(bin);
+    cominitTestMetaBinAdd(bin, COMINIT_META_REC_FSTYPE, "ext4", strlen("ext4"));
+    cominitTestMetaBinAdd(bin, COMINIT_META_REC_MODE, &ro, 1);
+    cominitTestMetaBinAdd(bin, COMINIT_META_REC_CRYPT, &crypt, 1);
+}
+
+/**
+ * Check if binary metadata contains a well-formed key record, which would query the keyring.
+ *
+ * @param data  The data block starting with the header.
+ * @param len   The size of \a data in Bytes.
+ *
+ * @return  true if a key record is found, false otherwise
+ */
+static bool cominitTestMetaBinHasKey(const uint8_t *data, size_t len) {
+    size_t pos = COMINIT_PART_META_BIN_HEADER_SIZE;
+    while (pos + COMINIT_PART_META_BIN_RECORD_HEADER_SIZE <= len) {
+        uint16_t type = (uint16_t)(data[pos] | data[pos + 1] << 8);
+        size_t recLen = (size_t)(data[pos + 2] | data[pos + 3] << 8);
+        if (type == COMINIT_META_REC_INTEGRITY_KEY) {
+            return true;
+        }
+        pos += COMINIT_PART_META_BIN_RECORD_HEADER_SIZE + recLen;
+    }
+    return false;
+}
+
+void cominitParseMetadataBinTestFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitRfsMetaData_t meta = {.devicePath = COMINIT_TEST_DEVICE_PATH};
+    cominitTestMetaBin_t bin;
+    const uint8_t invalid = 7;
+    const uint8_t integrityParams[COMINIT_PART_META_BIN_INTEGRITY_PARAMS_SIZE] = {8, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0};
+
+    cominitTestMetaBinSettings(&bin, COMINIT_CRYPTOPT_NONE);
+    assert_int_equal(cominitParseMetadataBin(NULL, bin.data, bin.len), -1);
+    assert_int_equal(cominitParseMetadataBin(&meta, NULL, bin.len), -1);
+
+    /* header */
+    assert_int_equal(cominitParseMetadataBin(&meta, bin.data, COMINIT_PART_META_BIN_HEADER_SIZE - 1), -1);
+    assert_int_equal(cominitParseMetadataBin(&meta, bin.data, bin.len - 1), -1);
+    bin.data[0] = '2';
+    assert_int_equal(cominitParseMetadataBin(&meta, bin.data, bin.len), -1);
+
+    /* truncated record */
+    cominitTestMetaBinSettings(&bin, COMINIT_CRYPTOPT_NONE);
+    bin.data[bin.len - 2] = 2;
+    assert_int_equal(cominitParseMetadataBin(&meta, bin.data, bin.len), -1);
+
+    /* unknown, duplicate and missing records */
+    cominitTestMetaBinSettings(&bin, COMINIT_CRYPTOPT_NONE);
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_COUNT, "x", 1);
+    assert_int_equal(cominitParseMetadataBin(&meta, bin.data, bin.len), -1);
+    cominitTestMetaBinSettings(&bin, COMINIT_CRYPTOPT_NONE);
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_FSTYPE, "ext4", strlen("ext4"));
+    assert_int_equal(cominitParseMetadataBin(&meta, bin.data, bin.len), -1);
+    cominitTestMetaBinInit(&bin);
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_FSTYPE, "ext4", strlen("ext4"));
+    assert_int_equal(cominitParseMetadataBin(&meta, bin.data, bin.len), -1);
+
+    /* invalid values */
+    cominitTestMetaBinInit(&bin);
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_FSTYPE, "ext 4", strlen("ext 4"));
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_MODE, "\x01", 1);
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_CRYPT, "\x00", 1);
+    assert_int_equal(cominitParseMetadataBin(&meta, bin.data, bin.len), -1);
+    cominitTestMetaBinInit(&bin);
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_FSTYPE, "ext4", strlen("ext4"));
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_MODE, &invalid, 1);
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_CRYPT, "\x00", 1);
+    assert_int_equal(cominitParseMetadataBin(&meta, bin.data, bin.len), -1);
+    cominitTestMetaBinSettings(&bin, invalid << 2);
+    assert_int_equal(cominitParseMetadataBin(&meta, bin.data, bin.len), -1);
+    cominitTestMetaBinSettings(&bin, COMINIT_CRYPTOPT_VERITY | COMINIT_CRYPTOPT_INTEGRITY);
+    assert_int_equal(cominitParseMetadataBin(&meta, bin.data, bin.len), -1);
+    cominitTestMetaBinSettings(&bin, COMINIT_CRYPTOPT_VERITY | COMINIT_CRYPTOPT_INTEGRITY | COMINIT_CRYPTOPT_CRYPT);
+    assert_int_equal(cominitParseMetadataBin(&meta, bin.data, bin.len), -1);
+    cominitTestMetaBinSettings(&bin, 0x80);
+    assert_int_equal(cominitParseMetadataBin(&meta, bin.data, bin.len), -1);
+    cominitTestMetaBinSettings(&bin, COMINIT_CRYPTOPT_CRYPT);
+    assert_int_equal(cominitParseMetadataBin(&meta, bin.data, bin.len), -1);
+    cominitTestMetaBinSettings(&bin, COMINIT_CRYPTOPT_NONE);
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_VERITY_PARAMS, integrityParams, sizeof(integrityParams));
+    assert_int_equal(cominitParseMetadataBin(&meta, bin.data, bin.len), -1);
+
+    /* dm-verity and dm-integrity without their parameters */
+    cominitTestMetaBinSettings(&bin, COMINIT_CRYPTOPT_VERITY);
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_VERITY_ALG, "sha256", strlen("sha256"));
+    assert_int_equal(cominitParseMetadataBin(&meta, bin.data, bin.len), -1);
+    cominitTestMetaBinSettings(&bin, COMINIT_CRYPTOPT_INTEGRITY);
+    assert_int_equal(cominitParseMetadataBin(&meta, bin.data, bin.len), -1);
+
+    /* invalid key reference and unavailable key */
+    cominitTestMetaBinSettings(&bin, COMINIT_CRYPTOPT_INTEGRITY);
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_INTEGRITY_PARAMS, integrityParams, sizeof(integrityParams));
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_INTEGRITY_KEY, "\x03\x06sha256k", 9);
+    assert_int_equal(cominitParseMetadataBin(&meta, bin.data, bin.len), -1);
+    cominitTestMetaBinSettings(&bin, COMINIT_CRYPTOPT_INTEGRITY);
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_INTEGRITY_PARAMS, integrityParams, sizeof(integrityParams));
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_INTEGRITY_KEY, "\x00\x07sha256k", 9);
+    assert_int_equal(cominitParseMetadataBin(&meta, bin.data, bin.len), -1);
+    cominitTestMetaBinSettings(&bin, COMINIT_CRYPTOPT_INTEGRITY);
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_INTEGRITY_PARAMS, integrityParams, sizeof(integrityParams));
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_INTEGRITY_KEY, "\x00\x06sha256k", 9);
+    expect_any(__wrap_cominitKeyringGetKey, key);
+    expect_string(__wrap_cominitKeyringGetKey, keyDesc, "k");
+    expect_any(__wrap_cominitKeyringGetKey, keyMaxLen);
+    will_return(__wrap_cominitKeyringGetKey, -1);
+    assert_int_equal(cominitParseMetadataBin(&meta, bin.data, bin.len), -1);
+
+    /* the resulting table does not fit */
+    char longOpt[COMINIT_DM_TABLE_SIZE_MAX];
+    memset(longOpt, 'x', sizeof(longOpt));
+    cominitTestMetaBinSettings(&bin, COMINIT_CRYPTOPT_INTEGRITY);
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_INTEGRITY_PARAMS, integrityParams, sizeof(integrityParams));
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_INTEGRITY_OPT, longOpt, sizeof(longOpt));
+    assert_int_equal(cominitParseMetadataBin(&meta, bin.data, bin.len), -1);
+}
+
+void cominitParseMetadataBinTestMutationFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitRfsMetaData_t meta = {.devicePath = COMINIT_TEST_DEVICE_PATH};
+    cominitTestMetaBin_t seeds[2];
+    cominitTestMetaBin_t bin;
+    const uint8_t verityParams[COMINIT_PART_META_BIN_VERITY_PARAMS_SIZE] = {1, 0, 0, 0, 0, 0x10, 0, 0, 0, 0x10};
+    const uint8_t integrityParams[COMINIT_PART_META_BIN_INTEGRITY_PARAMS_SIZE] = {8, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0};
+    uint32_t seed = 0x12345678u;
+
+    cominitTestMetaBinSettings(&seeds[0], COMINIT_CRYPTOPT_VERITY);
+    cominitTestMetaBinAdd(&seeds[0], COMINIT_META_REC_VERITY_PARAMS, verityParams, sizeof(verityParams));
+    cominitTestMetaBinAdd(&seeds[0], COMINIT_META_REC_VERITY_ALG, "sha256", strlen("sha256"));
+    cominitTestMetaBinAdd(&seeds[0], COMINIT_META_REC_VERITY_DIGEST, "\x01\x02\x03\x04", 4);
+    cominitTestMetaBinAdd(&seeds[0], COMINIT_META_REC_VERITY_SALT, "\x05\x06", 2);
+    cominitTestMetaBinAdd(&seeds[0], COMINIT_META_REC_VERITY_OPT, "ignore_zero_blocks", strlen("ignore_zero_blocks"));
+    cominitTestMetaBinSettings(&seeds[1], COMINIT_CRYPTOPT_INTEGRITY);
+    cominitTestMetaBinAdd(&seeds[1], COMINIT_META_REC_INTEGRITY_PARAMS, integrityParams, sizeof(integrityParams));
+    cominitTestMetaBinAdd(&seeds[1], COMINIT_META_REC_INTEGRITY_OPT, "fix_padding", strlen("fix_padding"));
+
+    for (size_t s = 0; s < ARRAY_SIZE(seeds); s++) {
+        for (size_t i = 0; i < COMINIT_TEST_MUTATIONS; i++) {
+            bin = seeds[s];
+            seed = seed * 1103515245u + 12345u;
+            size_t count = 1 + (seed >> 16) % 4;
+            for (size_t m = 0; m < count; m++) {
+                seed = seed * 1103515245u + 12345u;
+                size_t at = (seed >> 16) % bin.len;
+                seed = seed * 1103515245u + 12345u;
+                bin.data[at] = (uint8_t)(seed >> 16);
+            }
+            /* the length may be cut short, but never beyond the buffer */
+            seed = seed * 1103515245u + 12345u;
+            size_t len = ((seed >> 16) % 8 == 0) ? (seed >> 20) % (bin.len + 1) : bin.len;
+            if (cominitTestMetaBinHasKey(bin.data, len)) {
+                continue;
+            }
+
+            memset(meta.dmTableVerint, 'X', sizeof(meta.dmTableVerint));
+            int ret = cominitParseMetadataBin(&meta, bin.data, len);
+            assert_true(ret == 0 || ret == -1);
+            if (ret == 0) {
+                assert_non_null(memchr(meta.dmTableVerint, '\0', sizeof(meta.dmTableVerint)));
+                assert_non_null(memchr(meta.fsType, '\0', sizeof(meta.fsType)));
+            }
+        }
+    }
+}
@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-meta-parse-metadata-bin-success.c
+ * @brief Implementation of success case unit tests for cominitParseMetadataBin().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <string.h>
+
+#include "common.h"
+#include "keyring.h"
+#include "meta.h"
+#include "unit_test.h"
+#include "utest-meta-parse-metadata-bin.h"
+
+void cominitParseMetadataBinTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitRfsMetaData_t meta = {.devicePath = COMINIT_TEST_DEVICE_PATH};
+    cominitTestMetaBin_t bin;
+    const uint8_t ro = 1;
+    const uint8_t crypt = COMINIT_CRYPTOPT_NONE;
+
+    cominitTestMetaBinInit(&bin);
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_CRYPT, &crypt, 1);
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_FSTYPE, "squashfs", strlen("squashfs"));
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_MODE, &ro, 1);
+
+    assert_int_equal(cominitParseMetadataBin(&meta, bin.data, bin.len), 0);
+    assert_string_equal(meta.fsType, "squashfs");
+    assert_true(meta.ro);
+    assert_int_equal(meta.crypt, COMINIT_CRYPTOPT_NONE);
+    assert_string_equal(meta.dmTableVerint, "");
+    assert_string_equal(meta.dmTableCrypt, "");
+}
+
+void cominitParseMetadataBinTestVeritySuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitRfsMetaData_t meta = {.devicePath = COMINIT_TEST_DEVICE_PATH};
+    cominitTestMetaBin_t bin;
+    const uint8_t ro = 1;
+    const uint8_t crypt = COMINIT_CRYPTOPT_VERITY;
+    /* version 1, 4096 Byte blocks, 100 data blocks, hash tree starting at block 101 */
+    const uint8_t params[COMINIT_PART_META_BIN_VERITY_PARAMS_SIZE] = {
+        1, 0, 0, 0, 0, 0x10, 0, 0, 0, 0x10, 0, 0, 100, 0, 0, 0, 0, 0, 0, 0, 101, 0, 0, 0, 0, 0, 0, 0,
+    };
+    const uint8_t digest[] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef};
+    const uint8_t salt[] = {0xab, 0xcd};
+
+    cominitTestMetaBinInit(&bin);
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_FSTYPE, "squashfs", strlen("squashfs"));
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_MODE, &ro, 1);
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_CRYPT, &crypt, 1);
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_VERITY_PARAMS, params, sizeof(params));
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_VERITY_ALG, "sha256", strlen("sha256"));
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_VERITY_DIGEST, digest, sizeof(digest));
+
+    /* without salt and options */
+    assert_int_equal(cominitParseMetadataBin(&meta, bin.data, bin.len), 0);
+    assert_int_equal(meta.crypt, COMINIT_CRYPTOPT_VERITY);
+    assert_string_equal(meta.dmTableVerint, "1 " COMINIT_TEST_DEVICE_PATH " " COMINIT_TEST_DEVICE_PATH
+                                            " 4096 4096 100 101 sha256 0123456789abcdef -");
+    assert_int_equal(meta.dmVerintDataSizeBytes, 4096 * 100);
+
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_VERITY_SALT, salt, sizeof(salt));
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_VERITY_OPT, "ignore_zero_blocks", strlen("ignore_zero_blocks"));
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_VERITY_OPT, "check_at_most_once", strlen("check_at_most_once"));
+    assert_int_equal(cominitParseMetadataBin(&meta, bin.data, bin.len), 0);
+    assert_string_equal(meta.dmTableVerint, "1 " COMINIT_TEST_DEVICE_PATH " " COMINIT_TEST_DEVICE_PATH
+                                            " 4096 4096 100 101 sha256 0123456789abcdef abcd"
+                                            " 2 ignore_zero_blocks check_at_most_once");
+}
+
+void cominitParseMetadataBinTestIntegritySuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitRfsMetaData_t meta = {.devicePath = COMINIT_TEST_DEVICE_PATH};
+    cominitTestMetaBin_t bin;
+    const uint8_t rw = 0;
+    const uint8_t crypt = COMINIT_CRYPTOPT_INTEGRITY;
+    /* 1000 data blocks of 4096 Bytes */
+    const uint8_t params[COMINIT_PART_META_BIN_INTEGRITY_PARAMS_SIZE] = {0xe8, 3, 0, 0, 0, 0, 0, 0, 0, 0x10, 0, 0};
+    const uint8_t key[] = "\x02\x0chmac(sha256)mykey";
+
+    cominitTestMetaBinInit(&bin);
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_FSTYPE, "ext4", strlen("ext4"));
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_MODE, &rw, 1);
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_CRYPT, &crypt, 1);
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_INTEGRITY_PARAMS, params, sizeof(params));
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_INTEGRITY_OPT, "internal_hash:crc32c", strlen("internal_hash:crc32c"));
+
+    assert_int_equal(cominitParseMetadataBin(&meta, bin.data, bin.len), 0);
+    assert_false(meta.ro);
+    assert_int_equal(meta.crypt, COMINIT_CRYPTOPT_INTEGRITY);
+    assert_string_equal(meta.dmTableVerint,
+                        COMINIT_TEST_DEVICE_PATH " 0 - J 2 block_size:4096 internal_hash:crc32c ");
+    assert_int_equal(meta.dmVerintDataSizeBytes, 1000 * 4096);
+
+    /* the key payload is inserted in hexadecimal, the mock does not fill it so only the length is checked */
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_INTEGRITY_KEY, key, sizeof(key) - 1);
+    cominitTestMetaBinAdd(&bin, COMINIT_META_REC_INTEGRITY_OPT, "fix_padding", strlen("fix_padding"));
+    expect_any(__wrap_cominitKeyringGetKey, key);
+    expect_string(__wrap_cominitKeyringGetKey, keyDesc, "mykey");
+    expect_value(__wrap_cominitKeyringGetKey, keyMaxLen, COMINIT_KEYRING_PAYLOAD_MAX_SIZE);
+    will_return(__wrap_cominitKeyringGetKey, 4);
+    assert_int_equal(cominitParseMetadataBin(&meta, bin.data, bin.len), 0);
+    const char prefix[] =
+        COMINIT_TEST_DEVICE_PATH " 0 - J 4 block_size:4096 internal_hash:crc32c journal_mac:hmac(sha256):";
+    assert_memory_equal(meta.dmTableVerint, prefix, strlen(prefix));
+    assert_string_equal(meta.dmTableVerint + strlen(prefix) + 2 * 4, " fix_padding ");
+}
@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-meta-parse-metadata-bin.c
+ * @brief Implementation of an cominitParseMetadataBin() unit test group using cmocka.
+ */
+#include "utest-meta-parse-metadata-bin.h"
+
+#include <string.h>
+
+#include "meta.h"
+#include "unit_test.h"
+
+void cominitTestMetaBinInit(cominitTestMetaBin_t *bin) {
+    memset(bin, 0, sizeof(*bin));
+    bin->data[0] = COMINIT_PART_META_DATA_VERSION_BIN;
+    bin->data[1] = COMINIT_PART_META_BIN_SIG_ALG_RSA_PSS;
+    bin->len = COMINIT_PART_META_BIN_HEADER_SIZE;
+}
+
+void cominitTestMetaBinAdd(cominitTestMetaBin_t *bin, uint16_t type, const void *value, size_t len) {
+    uint8_t *rec = bin->data + bin->len;
+    rec[0] = (uint8_t)type;
+    rec[1] = (uint8_t)(type >> 8);
+    rec[2] = (uint8_t)len;
+    rec[3] = (uint8_t)(len >> 8);
+    memcpy(rec + COMINIT_PART_META_BIN_RECORD_HEADER_SIZE, value, len);
+    bin->len += COMINIT_PART_META_BIN_RECORD_HEADER_SIZE + len;
+
+    size_t recordsLen = bin->len - COMINIT_PART_META_BIN_HEADER_SIZE;
+    bin->data[2] = (uint8_t)recordsLen;
+    bin->data[3] = (uint8_t)(recordsLen >> 8);
+}
+
+/**
+ * Run the unit tests for cominitParseMetadataBin().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitParseMetadataBinTestSuccess),
+        cmocka_unit_test(cominitParseMetadataBinTestVeritySuccess),
+        cmocka_unit_test(cominitParseMetadataBinTestIntegritySuccess),
+        cmocka_unit_test(cominitParseMetadataBinTestFailure),
+        cmocka_unit_test(cominitParseMetadataBinTestMutationFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-meta-parse-metadata-bin.h
+ * @brief Header declaring cmocka unit test functions for cominitParseMetadataBin().
+ */
+#ifndef __UTEST_META_PARSE_METADATA_BIN_H__
+#define __UTEST_META_PARSE_METADATA_BIN_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** Device path used for the partition in all tests. **/
+#define COMINIT_TEST_DEVICE_PATH "/dev/mmcblk0p3"
+
+/**
+ * Binary metadata built by the tests.
+ */
+typedef struct {
+    uint8_t data[4096];  ///< The data block including the header.
+    size_t len;          ///< The size of the data block in Bytes.
+} cominitTestMetaBin_t;
+
+/**
+ * Start binary metadata with a header and no records.
+ *
+ * @param bin  The binary metadata to initialize.
+ */
+void cominitTestMetaBinInit(cominitTestMetaBin_t *bin);
+
+/**
+ * Append a record to binary metadata and update the length in its header.
+ *
+ * @param bin    The binary metadata started with cominitTestMetaBinInit().
+ * @param type   The record type.
+ * @param value  The value of the record.
+ * @param len    The size of \a value in Bytes.
+ */
+void cominitTestMetaBinAdd(cominitTestMetaBin_t *bin, uint16_t type, const void *value, size_t len);
+
+/**
+ * Unit test for cominitParseMetadataBin() with a plain partition.
+ * @param state
+ */
+void cominitParseMetadataBinTestSuccess(void **state);
+
+/**
+ * Unit test for cominitParseMetadataBin() generating a dm-verity table.
+ * @param state
+ */
+void cominitParseMetadataBinTestVeritySuccess(void **state);
+
+/**
+ * Unit test for cominitParseMetadataBin() generating a dm-integrity table, optionally with a key from the keyring.
+ * @param state
+ */
+void cominitParseMetadataBinTestIntegritySuccess(void **state);
+
+/**
+ * Unit test for cominitParseMetadataBin() with invalid parameters and malformed metadata.
+ * @param state
+ */
+void cominitParseMetadataBinTestFailure(void **state);
+
+/**
+ * Unit test for cominitParseMetadataBin() with randomly mutated metadata.
+ * @param state
+ */
+void cominitParseMetadataBinTestMutationFailure(void **state);
+
+#endif /* __UTEST_META_PARSE_METADATA_BIN_H__ */
@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-meta-parse-metadata-failure.c
+ * @brief Implementation of failure case unit tests for cominitParseMetadata().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <string.h>
+
+#include "common.h"
+#include "meta.h"
+#include "unit_test.h"
+#include "utest-meta-parse-metadata.h"
+
+/** Number of mutated metadata strings parsed per seed string. **/
+#define COMINIT_TEST_MUTATIONS 20000
+
+void cominitParseMetadataTestFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitRfsMetaData_t meta = {.devicePath = COMINIT_TEST_DEVICE_PATH};
+    const char *invalid[] = {
+        "",
+        "1 ext4 rw plain",
+        "1 ext4 rw plain\xff",
+        "3 ext4 rw plain\xff\xff",
+        "10 ext4 rw plain\xff\xff",
+        "2 rsa-pss ext4 rw\xff\xff",
+        "1 ext4 rx plain\xff\xff",
+        "1 ext4 rw verity-integrity\xff\xff",
+        "1 ext4 ro verity\xff\xff",
+        "1 ext4 ro verity\xff" "1 4096 4096 100 101\xff",
+        "1 ext4 rw integrity\xff" "8 512 1\xff",
+        "1 ext4 rw crypt\xff\xff",
+        "1 ext4 rw crypt-integrity\xff" "4 512 1 fix_padding\xff" "a\xff" "b",
+    };
+
+    assert_int_equal(cominitParseMetadata(NULL, "1 ext4 rw plain\xff\xff"), -1);
+    assert_int_equal(cominitParseMetadata(&meta, NULL), -1);
+    for (size_t i = 0; i < ARRAY_SIZE(invalid); i++) {
+        assert_int_equal(cominitParseMetadata(&meta, invalid[i]), -1);
+    }
+
+    /* the key is not available */
+    expect_any(__wrap_cominitKeyringGetKey, key);
+    expect_string(__wrap_cominitKeyringGetKey, keyDesc, "mykey");
+    expect_any(__wrap_cominitKeyringGetKey, keyMaxLen);
+    will_return(__wrap_cominitKeyringGetKey, -1);
+    assert_int_equal(
+        cominitParseMetadata(&meta, "1 ext4 rw integrity\xff" "8 512 1 internal_hash:hmac(sha256)::mykey\xff"), -1);
+
+    /* the resulting table does not fit */
+    char longStr[2 * COMINIT_DM_TABLE_SIZE_MAX];
+    int n = snprintf(longStr, sizeof(longStr), "1 ext4 ro verity\xff" "1 4096 4096 100 101 sha256 %0*d\xff",
+                     COMINIT_DM_TABLE_SIZE_MAX, 0);
+    assert_true(n > 0 && (size_t)n < sizeof(longStr));
+    assert_int_equal(cominitParseMetadata(&meta, longStr), -1);
+
+    /* too many fields */
+    char manyStr[COMINIT_DM_TABLE_SIZE_MAX];
+    size_t pos = (size_t)snprintf(manyStr, sizeof(manyStr), "1 ext4 ro plain\xff");
+    while (pos + 3 < sizeof(manyStr)) {
+        manyStr[pos++] = 'x';
+        manyStr[pos++] = ' ';
+    }
+    manyStr[pos++] = '\xff';
+    manyStr[pos] = '\0';
+    assert_int_equal(cominitParseMetadata(&meta, manyStr), -1);
+}
+
+void cominitParseMetadataTestMutationFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    /* without "::" in the seeds and the alphabet, no key is requested from the keyring */
+    const char *seeds[] = {
+        "2 rsa-pss squashfs ro verity\xff" "1 4096 4096 100 101 sha256 abcd 1234 1 ignore_zero_blocks\xff",
+        "1 ext4 rw integrity\xff" "1000 4096 2 internal_hash:crc32c fix_padding\xff" "x",
+        "2 ecdsa-p256 ext4 rw plain\xff\xff",
+    };
+    const char alphabet[] = " \xff\0" "0123456789abcdefverityintegrityplainrw";
+    cominitRfsMetaData_t meta = {.devicePath = COMINIT_TEST_DEVICE_PATH};
+    char buf[COMINIT_DM_TABLE_SIZE_MAX];
+    uint32_t seed = 0x12345678u;
+
+    for (size_t s = 0; s < ARRAY_SIZE(seeds); s++) {
+        size_t len = strlen(seeds[s]);
+        for (size_t i = 0; i < COMINIT_TEST_MUTATIONS; i++) {
+            memcpy(buf, seeds[s], len + 1);
+            seed = seed * 1103515245u + 12345u;
+            size_t count = 1 + (seed >> 16) % 4;
+            for (size_t m = 0; m < count; m++) {
+                seed = seed * 1103515245u + 12345u;
+                size_t at = (seed >> 16) % len;
+                seed = seed * 1103515245u + 12345u;
+                buf[at] = alphabet[(seed >> 16) % (sizeof(alphabet) - 1)];
+            }
+
+            memset(meta.dmTableVerint, 'X', sizeof(meta.dmTableVerint));
+            int ret = cominitParseMetadata(&meta, buf);
+            assert_true(ret == 0 || ret == -1);
+            if (ret == 0) {
+                assert_non_null(memchr(meta.dmTableVerint, '\0', sizeof(meta.dmTableVerint)));
+                assert_non_null(memchr(meta.fsType, '\0', sizeof(meta.fsType)));
+            }
+        }
+    }
+}
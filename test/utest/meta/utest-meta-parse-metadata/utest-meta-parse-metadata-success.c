@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-meta-parse-metadata-success.c
+ * @brief Implementation of success case unit tests for cominitParseMetadata().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <string.h>
+
+#include "common.h"
+#include "keyring.h"
+#include "meta.h"
+#include "unit_test.h"
+#include "utest-meta-parse-metadata.h"
+
+void cominitParseMetadataTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitRfsMetaData_t meta = {.devicePath = COMINIT_TEST_DEVICE_PATH};
+
+    assert_int_equal(cominitParseMetadata(&meta, "1 ext4 rw plain\xff\xff"), 0);
+    assert_string_equal(meta.fsType, "ext4");
+    assert_false(meta.ro);
+    assert_int_equal(meta.crypt, COMINIT_CRYPTOPT_NONE);
+    assert_string_equal(meta.dmTableVerint, "");
+    assert_string_equal(meta.dmTableCrypt, "");
+
+    /* repeated spaces are skipped and the string is not modified */
+    const char metaStr[] = "2  ecdsa-p256 squashfs  ro plain \xff \xff";
+    char metaCopy[sizeof(metaStr)];
+    memcpy(metaCopy, metaStr, sizeof(metaStr));
+    assert_int_equal(cominitParseMetadata(&meta, metaCopy), 0);
+    assert_memory_equal(metaCopy, metaStr, sizeof(metaStr));
+    assert_string_equal(meta.fsType, "squashfs");
+    assert_true(meta.ro);
+    assert_int_equal(meta.crypt, COMINIT_CRYPTOPT_NONE);
+}
+
+void cominitParseMetadataTestVeritySuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitRfsMetaData_t meta = {.devicePath = COMINIT_TEST_DEVICE_PATH};
+
+    assert_int_equal(cominitParseMetadata(&meta, "2 rsa-pss squashfs ro verity\xff"
+                                                 "1 4096 4096 100 101 sha256 abcd 1234 1 ignore_zero_blocks\xff"),
+                     0);
+    assert_int_equal(meta.crypt, COMINIT_CRYPTOPT_VERITY);
+    assert_string_equal(meta.dmTableVerint, "1 " COMINIT_TEST_DEVICE_PATH " " COMINIT_TEST_DEVICE_PATH
+                                            " 4096 4096 100 101 sha256 abcd 1234 1 ignore_zero_blocks");
+    assert_int_equal(meta.dmVerintDataSizeBytes, 4096 * 100);
+}
+
+void cominitParseMetadataTestIntegritySuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitRfsMetaData_t meta = {.devicePath = COMINIT_TEST_DEVICE_PATH};
+
+    assert_int_equal(cominitParseMetadata(&meta, "1 ext4 rw integrity\xff" "1000 4096 1 internal_hash:crc32c\xff"), 0);
+    assert_int_equal(meta.crypt, COMINIT_CRYPTOPT_INTEGRITY);
+    assert_string_equal(meta.dmTableVerint,
+                        COMINIT_TEST_DEVICE_PATH " 0 - J 2 block_size:4096 internal_hash:crc32c ");
+    assert_int_equal(meta.dmVerintDataSizeBytes, 1000 * 4096);
+
+    /* the key payload is inserted in hexadecimal, the mock does not fill it so only the length is checked */
+    expect_any(__wrap_cominitKeyringGetKey, key);
+    expect_string(__wrap_cominitKeyringGetKey, keyDesc, "mykey");
+    expect_value(__wrap_cominitKeyringGetKey, keyMaxLen, COMINIT_KEYRING_PAYLOAD_MAX_SIZE);
+    will_return(__wrap_cominitKeyringGetKey, 4);
+    assert_int_equal(cominitParseMetadata(&meta, "1 ext4 rw integrity\xff"
+                                                 "8 512 2 journal_mac:hmac(sha256)::mykey fix_padding\xff"),
+                     0);
+    const char prefix[] = COMINIT_TEST_DEVICE_PATH " 0 - J 3 block_size:512 journal_mac:hmac(sha256):";
+    assert_memory_equal(meta.dmTableVerint, prefix, strlen(prefix));
+    assert_string_equal(meta.dmTableVerint + strlen(prefix) + 2 * 4, " fix_padding ");
+}
@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-meta-parse-metadata.c
+ * @brief Implementation of an cominitParseMetadata() unit test group using cmocka.
+ */
+#include "utest-meta-parse-metadata.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitParseMetadata().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitParseMetadataTestSuccess),
+        cmocka_unit_test(cominitParseMetadataTestVeritySuccess),
+        cmocka_unit_test(cominitParseMetadataTestIntegritySuccess),
+        cmocka_unit_test(cominitParseMetadataTestFailure),
+        cmocka_unit_test(cominitParseMetadataTestMutationFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
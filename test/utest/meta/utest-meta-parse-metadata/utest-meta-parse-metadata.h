@@ -0,0 +1,42 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-meta-parse-metadata.h
+ * @brief Header declaring cmocka unit test functions for cominitParseMetadata().
+ */
+#ifndef __UTEST_META_PARSE_METADATA_H__
+#define __UTEST_META_PARSE_METADATA_H__
+
+/** Device path used for the partition in all tests. **/
+#define COMINIT_TEST_DEVICE_PATH "/dev/mmcblk0p3"
+
+/**
+ * Unit test for cominitParseMetadata() with plain partitions of both metadata versions.
+ * @param state
+ */
+void cominitParseMetadataTestSuccess(void **state);
+
+/**
+ * Unit test for cominitParseMetadata() generating a dm-verity table.
+ * @param state
+ */
+void cominitParseMetadataTestVeritySuccess(void **state);
+
+/**
+ * Unit test for cominitParseMetadata() generating a dm-integrity table, optionally with a key from the keyring.
+ * @param state
+ */
+void cominitParseMetadataTestIntegritySuccess(void **state);
+
+/**
+ * Unit test for cominitParseMetadata() with invalid parameters and malformed metadata.
+ * @param state
+ */
+void cominitParseMetadataTestFailure(void **state);
+
+/**
+ * Unit test for cominitParseMetadata() with randomly mutated metadata strings.
+ * @param state
+ */
+void cominitParseMetadataTestMutationFailure(void **state);
+
+#endif /* __UTEST_META_PARSE_METADATA_H__ */
@@ -16,5 +16,8 @@ void cominitCleanupSysfilesTestSuccess(void **state) {
     expect_string(__wrap_umount2, target, "/dev");
     expect_value(__wrap_umount2, flags, MNT_DETACH);
     will_return(__wrap_umount2, 0);
+    expect_string(__wrap_umount2, target, "/sys");
+    expect_value(__wrap_umount2, flags, MNT_DETACH);
+    will_return(__wrap_umount2, 0);
     assert_int_equal(cominitCleanupSysfiles(), 0);
 }
@@ -17,4 +17,12 @@ void cominitCleanupSysfilesTestUmountError(void **state) {
     expect_value(__wrap_umount2, flags, MNT_DETACH);
     will_return(__wrap_umount2, -1);
     assert_int_equal(cominitCleanupSysfiles(), -1);
+
+    expect_string(__wrap_umount2, target, "/dev");
+    expect_value(__wrap_umount2, flags, MNT_DETACH);
+    will_return(__wrap_umount2, 0);
+    expect_string(__wrap_umount2, target, "/sys");
+    expect_value(__wrap_umount2, flags, MNT_DETACH);
+    will_return(__wrap_umount2, -1);
+    assert_int_equal(cominitCleanupSysfiles(), -1);
 }
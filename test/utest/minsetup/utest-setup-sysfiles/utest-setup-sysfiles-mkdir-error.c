@@ -35,4 +35,32 @@ void cominitSetupSysfilesTestMkdirError(void **state) {
     will_return(__wrap_mkdir, EINVAL);  // Use something that is not EEXIST, i.e. not already created.
     will_return(__wrap_mkdir, -1);
     assert_int_equal(cominitSetupSysfiles(), -1);
+
+    expect_string(__wrap_mkdir, pathName, MNT_TGT_DEV);
+    expect_value(__wrap_mkdir, mode, DIR_MODE_DEV);
+    will_return(__wrap_mkdir, EEXIST);
+    will_return(__wrap_mkdir, -1);
+    expect_string(__wrap_mount, source, MNT_SRC);
+    expect_string(__wrap_mount, target, MNT_TGT_DEV);
+    expect_string(__wrap_mount, fileSystemType, MNT_TYPE_DEV);
+    expect_value(__wrap_mount, mountFlags, MNT_FLAGS_DEV);
+    expect_value(__wrap_mount, data, MNT_DATA);
+    will_return(__wrap_mount, 0);
+    will_return(__wrap_mount, 0);
+    expect_string(__wrap_mkdir, pathName, MNT_TGT_PROC);
+    expect_value(__wrap_mkdir, mode, DIR_MODE_PROC);
+    will_return(__wrap_mkdir, 0);
+    will_return(__wrap_mkdir, 0);
+    expect_string(__wrap_mount, source, MNT_SRC);
+    expect_string(__wrap_mount, target, MNT_TGT_PROC);
+    expect_string(__wrap_mount, fileSystemType, MNT_TYPE_PROC);
+    expect_value(__wrap_mount, mountFlags, MNT_FLAGS_PROC);
+    expect_value(__wrap_mount, data, MNT_DATA);
+    will_return(__wrap_mount, 0);
+    will_return(__wrap_mount, 0);
+    expect_string(__wrap_mkdir, pathName, MNT_TGT_SYS);
+    expect_value(__wrap_mkdir, mode, DIR_MODE_SYS);
+    will_return(__wrap_mkdir, EINVAL);  // Use something that is not EEXIST, i.e. not already created.
+    will_return(__wrap_mkdir, -1);
+    assert_int_equal(cominitSetupSysfiles(), -1);
 }
@@ -40,6 +40,28 @@ void cominitSetupSysfilesTestSuccess(void **state) {
     will_return(__wrap_mount, 0);
     will_return(__wrap_mount, 0);
 
+    // Check success case where we create and mount /sys.
+    expect_string(__wrap_mkdir, pathName, MNT_TGT_SYS);
+    expect_value(__wrap_mkdir, mode, DIR_MODE_SYS);
+    will_return(__wrap_mkdir, 0);
+    will_return(__wrap_mkdir, 0);
+    expect_string(__wrap_mount, source, MNT_SRC);
+    expect_string(__wrap_mount, target, MNT_TGT_SYS);
+    expect_string(__wrap_mount, fileSystemType, MNT_TYPE_SYS);
+    expect_value(__wrap_mount, mountFlags, MNT_FLAGS_SYS);
+    expect_value(__wrap_mount, data, MNT_DATA);
+    will_return(__wrap_mount, 0);
+    will_return(__wrap_mount, 0);
+
+    // Check success case where we mount efivarfs.
+    expect_string(__wrap_mount, source, MNT_SRC);
+    expect_string(__wrap_mount, target, MNT_TGT_EFIVARS);
+    expect_string(__wrap_mount, fileSystemType, MNT_TYPE_EFIVARS);
+    expect_value(__wrap_mount, mountFlags, MNT_FLAGS_EFIVARS);
+    expect_value(__wrap_mount, data, MNT_DATA);
+    will_return(__wrap_mount, 0);
+    will_return(__wrap_mount, 0);
+
     assert_int_equal(cominitSetupSysfiles(), 0);
 }
 
@@ -71,6 +93,29 @@ void cominitSetupSysfilesTestSuccessAlreadyMounted(void **state) {
     expect_value(__wrap_mount, data, MNT_DATA);
     will_return(__wrap_mount, EBUSY);
     will_return(__wrap_mount, -1);
+
+    // Check success where /sys is already mounted.
+    expect_string(__wrap_mkdir, pathName, MNT_TGT_SYS);
+    expect_value(__wrap_mkdir, mode, DIR_MODE_SYS);
+    will_return(__wrap_mkdir, EEXIST);
+    will_return(__wrap_mkdir, -1);
+    expect_string(__wrap_mount, source, MNT_SRC);
+    expect_string(__wrap_mount, target, MNT_TGT_SYS);
+    expect_string(__wrap_mount, fileSystemType, MNT_TYPE_SYS);
+    expect_value(__wrap_mount, mountFlags, MNT_FLAGS_SYS);
+    expect_value(__wrap_mount, data, MNT_DATA);
+    will_return(__wrap_mount, EBUSY);
+    will_return(__wrap_mount, -1);
+
+    // Check success where efivarfs is already mounted.
+    expect_string(__wrap_mount, source, MNT_SRC);
+    expect_string(__wrap_mount, target, MNT_TGT_EFIVARS);
+    expect_string(__wrap_mount, fileSystemType, MNT_TYPE_EFIVARS);
+    expect_value(__wrap_mount, mountFlags, MNT_FLAGS_EFIVARS);
+    expect_value(__wrap_mount, data, MNT_DATA);
+    will_return(__wrap_mount, EBUSY);
+    will_return(__wrap_mount, -1);
+
     assert_int_equal(cominitSetupSysfiles(), 0);
 }
 
@@ -102,5 +147,82 @@ void cominitSetupSysfilesTestSuccessDirExists(void **state) {
     expect_value(__wrap_mount, data, MNT_DATA);
     will_return(__wrap_mount, 0);
     will_return(__wrap_mount, 0);
+
+    // Check success where /sys already exists as a directory but is not yet mounted
+    expect_string(__wrap_mkdir, pathName, MNT_TGT_SYS);
+    expect_value(__wrap_mkdir, mode, DIR_MODE_SYS);
+    will_return(__wrap_mkdir, EEXIST);
+    will_return(__wrap_mkdir, -1);
+    expect_string(__wrap_mount, source, MNT_SRC);
+    expect_string(__wrap_mount, target, MNT_TGT_SYS);
+    expect_string(__wrap_mount, fileSystemType, MNT_TYPE_SYS);
+    expect_value(__wrap_mount, mountFlags, MNT_FLAGS_SYS);
+    expect_value(__wrap_mount, data, MNT_DATA);
+    will_return(__wrap_mount, 0);
+    will_return(__wrap_mount, 0);
+
+    // Check success where no EFI variables are available.
+    expect_string(__wrap_mount, source, MNT_SRC);
+    expect_string(__wrap_mount, target, MNT_TGT_EFIVARS);
+    expect_string(__wrap_mount, fileSystemType, MNT_TYPE_EFIVARS);
+    expect_value(__wrap_mount, mountFlags, MNT_FLAGS_EFIVARS);
+    expect_value(__wrap_mount, data, MNT_DATA);
+    will_return(__wrap_mount, ENOENT);
+    will_return(__wrap_mount, -1);
+
+    assert_int_equal(cominitSetupSysfiles(), 0);
+}
+
+void cominitSetupSysfilesTestSuccessNoEfivarfs(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    // Check success case where we create and mount /dev.
+    expect_string(__wrap_mkdir, pathName, MNT_TGT_DEV);
+    expect_value(__wrap_mkdir, mode, DIR_MODE_DEV);
+    will_return(__wrap_mkdir, 0);
+    will_return(__wrap_mkdir, 0);
+    expect_string(__wrap_mount, source, MNT_SRC);
+    expect_string(__wrap_mount, target, MNT_TGT_DEV);
+    expect_string(__wrap_mount, fileSystemType, MNT_TYPE_DEV);
+    expect_value(__wrap_mount, mountFlags, MNT_FLAGS_DEV);
+    expect_value(__wrap_mount, data, MNT_DATA);
+    will_return(__wrap_mount, 0);
+    will_return(__wrap_mount, 0);
+
+    // Check success case where we create and mount /proc.
+    expect_string(__wrap_mkdir, pathName, MNT_TGT_PROC);
+    expect_value(__wrap_mkdir, mode, DIR_MODE_PROC);
+    will_return(__wrap_mkdir, 0);
+    will_return(__wrap_mkdir, 0);
+    expect_string(__wrap_mount, source, MNT_SRC);
+    expect_string(__wrap_mount, target, MNT_TGT_PROC);
+    expect_string(__wrap_mount, fileSystemType, MNT_TYPE_PROC);
+    expect_value(__wrap_mount, mountFlags, MNT_FLAGS_PROC);
+    expect_value(__wrap_mount, data, MNT_DATA);
+    will_return(__wrap_mount, 0);
+    will_return(__wrap_mount, 0);
+
+    // Check success case where we create and mount /sys.
+    expect_string(__wrap_mkdir, pathName, MNT_TGT_SYS);
+    expect_value(__wrap_mkdir, mode, DIR_MODE_SYS);
+    will_return(__wrap_mkdir, 0);
+    will_return(__wrap_mkdir, 0);
+    expect_string(__wrap_mount, source, MNT_SRC);
+    expect_string(__wrap_mount, target, MNT_TGT_SYS);
+    expect_string(__wrap_mount, fileSystemType, MNT_TYPE_SYS);
+    expect_value(__wrap_mount, mountFlags, MNT_FLAGS_SYS);
+    expect_value(__wrap_mount, data, MNT_DATA);
+    will_return(__wrap_mount, 0);
+    will_return(__wrap_mount, 0);
+
+    // Check success where the Kernel does not support efivarfs.
+    expect_string(__wrap_mount, source, MNT_SRC);
+    expect_string(__wrap_mount, target, MNT_TGT_EFIVARS);
+    expect_string(__wrap_mount, fileSystemType, MNT_TYPE_EFIVARS);
+    expect_value(__wrap_mount, mountFlags, MNT_FLAGS_EFIVARS);
+    expect_value(__wrap_mount, data, MNT_DATA);
+    will_return(__wrap_mount, ENODEV);
+    will_return(__wrap_mount, -1);
+
     assert_int_equal(cominitSetupSysfiles(), 0);
 }
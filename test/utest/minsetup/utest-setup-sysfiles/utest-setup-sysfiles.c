@@ -16,6 +16,7 @@ int main(void) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(cominitSetupSysfilesTestSuccess), cmocka_unit_test(cominitSetupSysfilesTestSuccessDirExists),
         cmocka_unit_test(cominitSetupSysfilesTestSuccessAlreadyMounted),
+        cmocka_unit_test(cominitSetupSysfilesTestSuccessNoEfivarfs),
         cmocka_unit_test(cominitSetupSysfilesTestMkdirError), cmocka_unit_test(cominitSetupSysfilesTestMountError)};
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
@@ -11,13 +11,21 @@
 #define MNT_SRC "none"                                     ///< Mount source parameter
 #define MNT_TGT_DEV "/dev"                                 ///< Mount target parameter
 #define MNT_TGT_PROC "/proc"                               ///< Mount target parameter
+#define MNT_TGT_SYS "/sys"                                 ///< Mount target parameter
+#define MNT_TGT_EFIVARS "/sys/firmware/efi/efivars"        ///< Mount target parameter
 #define MNT_TYPE_DEV "devtmpfs"                            ///< Mount file system type
 #define MNT_TYPE_PROC "proc"                               ///< Mount file system type
+#define MNT_TYPE_SYS "sysfs"                               ///< Mount file system type
+#define MNT_TYPE_EFIVARS "efivarfs"                        ///< Mount file system type
 #define MNT_FLAGS_DEV (MS_NOEXEC | MS_NOSUID)              ///< Mount flags for the devtmpfs
 #define MNT_FLAGS_PROC (MS_NODEV | MS_NOEXEC | MS_NOSUID)  ///< Mount flags for the proc
+#define MNT_FLAGS_SYS (MS_NODEV | MS_NOEXEC | MS_NOSUID)   ///< Mount flags for the sysfs
+/** Mount flags for the efivarfs **/
+#define MNT_FLAGS_EFIVARS (MS_RDONLY | MS_NODEV | MS_NOEXEC | MS_NOSUID)
 #define MNT_DATA NULL                                      ///< Mount data parameter
 #define DIR_MODE_DEV 0755                                  ///< Directory mode for the devtmpfs
 #define DIR_MODE_PROC 0555                                 ///< Directory mode for the proc
+#define DIR_MODE_SYS 0555                                  ///< Directory mode for the sysfs
 
 /**
  * Unit test for cominitSetupSysfiles() mount() error code path.
@@ -54,5 +62,12 @@ void cominitSetupSysfilesTestSuccessDirExists(void **state);
  * cominitSetupSysfilesTestSuccessDirExists()).
  */
 void cominitSetupSysfilesTestSuccessAlreadyMounted(void **state);
+/**
+ * Unit test for cominitSetupSysfiles() successful code path where the Kernel does not support efivarfs.
+ *
+ * Needs __wrap_mount() and __wrap_mkdir mock functions. All calls succeed except mounting efivarfs, which fails with
+ * ENODEV.
+ */
+void cominitSetupSysfilesTestSuccessNoEfivarfs(void **state);
 
 #endif /* __UTEST_SETUP_SYSFILES_H__ */
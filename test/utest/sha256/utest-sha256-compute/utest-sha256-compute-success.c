@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-sha256-compute-success.c
+ * @brief Implementation of success case unit tests for cominitSha256().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <string.h>
+
+#include "common.h"
+#include "sha256.h"
+#include "unit_test.h"
+#include "utest-sha256-compute.h"
+
+void cominitSha256TestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    const uint8_t emptyDigest[COMINIT_SHA256_DIGEST_LEN] = {
+        0xe3, 0xb0, 0xc4, 0x42, 0x98, 0xfc, 0x1c, 0x14, 0x9a, 0xfb, 0xf4, 0xc8, 0x99, 0x6f, 0xb9, 0x24,
+        0x27, 0xae, 0x41, 0xe4, 0x64, 0x9b, 0x93, 0x4c, 0xa4, 0x95, 0x99, 0x1b, 0x78, 0x52, 0xb8, 0x55};
+    const uint8_t abcDigest[COMINIT_SHA256_DIGEST_LEN] = {
+        0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+        0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad};
+    const uint8_t twoBlockDigest[COMINIT_SHA256_DIGEST_LEN] = {
+        0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8, 0xe5, 0xc0, 0x26, 0x93, 0x0c, 0x3e, 0x60, 0x39,
+        0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff, 0x21, 0x67, 0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1};
+    const uint8_t millionDigest[COMINIT_SHA256_DIGEST_LEN] = {
+        0xcd, 0xc7, 0x6e, 0x5c, 0x99, 0x14, 0xfb, 0x92, 0x81, 0xa1, 0xc7, 0xe2, 0x84, 0xd7, 0x3e, 0x67,
+        0xf1, 0x80, 0x9a, 0x48, 0xa4, 0x97, 0x20, 0x0e, 0x04, 0x6d, 0x39, 0xcc, 0xc7, 0x11, 0x2c, 0xd0};
+    const char abc[] = "abc";
+    const char twoBlock[] = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    uint8_t digest[COMINIT_SHA256_DIGEST_LEN];
+
+    cominitSha256(abc, 0, digest);
+    assert_memory_equal(digest, emptyDigest, sizeof(digest));
+    cominitSha256(abc, strlen(abc), digest);
+    assert_memory_equal(digest, abcDigest, sizeof(digest));
+    cominitSha256(twoBlock, strlen(twoBlock), digest);
+    assert_memory_equal(digest, twoBlockDigest, sizeof(digest));
+
+    /* one million times 'a', fed in chunks not aligned to the block size */
+    char chunk[1000];
+    cominitSha256Context_t ctx;
+    memset(chunk, 'a', sizeof(chunk));
+    cominitSha256Init(&ctx);
+    for (size_t i = 0; i < 1000; i++) {
+        cominitSha256Update(&ctx, chunk, sizeof(chunk));
+    }
+    cominitSha256Final(&ctx, digest);
+    assert_memory_equal(digest, millionDigest, sizeof(digest));
+
+    const char *backend = cominitSha256GetBackend();
+    assert_true(strcmp(backend, "x86-sha-ni") == 0 || strcmp(backend, "armv8-ce") == 0 ||
+                strcmp(backend, "portable") == 0);
+}
+
+void cominitSha256TestIncrementalSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    uint8_t buf[3 * COMINIT_SHA256_BLOCK_SIZE + 7];
+    uint32_t seed = 0x12345678u;
+    for (size_t i = 0; i < sizeof(buf); i++) {
+        seed = seed * 1103515245u + 12345u;
+        buf[i] = (uint8_t)(seed >> 16);
+    }
+
+    for (size_t len = 0; len <= sizeof(buf); len++) {
+        uint8_t expected[COMINIT_SHA256_DIGEST_LEN];
+        cominitSha256(buf, len, expected);
+
+        for (size_t split = 0; split <= len; split++) {
+            uint8_t digest[COMINIT_SHA256_DIGEST_LEN];
+            cominitSha256Context_t ctx;
+            cominitSha256Init(&ctx);
+            cominitSha256Update(&ctx, buf, split);
+            cominitSha256Update(&ctx, buf + split, len - split);
+            cominitSha256Final(&ctx, digest);
+            assert_memory_equal(digest, expected, sizeof(digest));
+        }
+    }
+}
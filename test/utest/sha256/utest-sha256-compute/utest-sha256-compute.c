@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-sha256-compute.c
+ * @brief Implementation of an cominitSha256() unit test group using cmocka.
+ */
+#include "utest-sha256-compute.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitSha256().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitSha256TestSuccess),
+        cmocka_unit_test(cominitSha256TestIncrementalSuccess),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
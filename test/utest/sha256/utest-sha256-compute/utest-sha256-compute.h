@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-sha256-compute.h
+ * @brief Header declaring cmocka unit test functions for cominitSha256().
+ */
+#ifndef __UTEST_SHA256_COMPUTE_H__
+#define __UTEST_SHA256_COMPUTE_H__
+
+/**
+ * Unit test for cominitSha256() with the FIPS 180-2 test vectors.
+ * @param state
+ */
+void cominitSha256TestSuccess(void **state);
+
+/**
+ * Unit test for cominitSha256Update() splitting the input at all positions around the block boundaries.
+ * @param state
+ */
+void cominitSha256TestIncrementalSuccess(void **state);
+
+#endif /* __UTEST_SHA256_COMPUTE_H__ */
@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-timing-write-report-failure.c
+ * @brief Implementation of a failure case unit test for cominitTimingWriteReport().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+
+#include "common.h"
+#include "timing.h"
+#include "unit_test.h"
+#include "utest-timing-write-report.h"
+
+void cominitTimingWriteReportTestFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitTimingInit();
+    assert_int_equal(cominitTimingWriteReport(NULL), -1);
+    /* a parent directory cannot be created below a character device */
+    assert_int_equal(cominitTimingWriteReport("/dev/null/cominit/timing.json"), -1);
+}
@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-timing-write-report-success.c
+ * @brief Implementation of a success case unit test for cominitTimingWriteReport().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "timing.h"
+#include "unit_test.h"
+#include "utest-timing-write-report.h"
+
+void cominitTimingWriteReportTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    char dir[] = "/tmp/utest-timing-XXXXXX";
+    char path[sizeof(dir) + 32];
+    char report[1024] = {0};
+    unsigned long long start = 0, end = 0;
+
+    assert_non_null(mkdtemp(dir));
+    snprintf(path, sizeof(path), "%s/run/cominit/timing.json", dir);
+
+    cominitTimingInit();
+    cominitTimingStart(COMINIT_TIMING_SETUP_SYSFILES);
+    cominitTimingStop(COMINIT_TIMING_SETUP_SYSFILES);
+    cominitTimingStart(COMINIT_TIMING_DISCOVER_ROOTFS);  // never stopped, so left out of the report
+    cominitTimingStart(COMINIT_TIMING_VERIFY_METADATA);
+    cominitTimingStop(COMINIT_TIMING_VERIFY_METADATA);
+    cominitTimingSetValue(COMINIT_TIMING_ROOT_WAIT, 5000);
+    cominitTimingSetValue(COMINIT_TIMING_ROOT_TRIES, 3);  // root-delay-ms is never set, so left out of the report
+    assert_int_equal(cominitTimingWriteReport(path), 0);
+
+    FILE *f = fopen(path, "r");
+    assert_non_null(f);
+    assert_non_null(fgets(report, sizeof(report), f));
+    fclose(f);
+
+    const char *format = "{\"clock\":\"boottime\",\"unit\":\"us\",\"start\":%llu,\"end\":%llu,";
+    assert_int_equal(sscanf(report, format, &start, &end), 2);
+    assert_true(start > 0);
+    assert_true(end >= start);
+    char *setup = strstr(report, "{\"name\":\"setup-sysfiles\",\"start\":");
+    char *verify = strstr(report, "},{\"name\":\"verify-metadata\",\"start\":");
+    assert_non_null(setup);
+    assert_non_null(verify);
+    assert_true(setup < verify);
+    assert_null(strstr(report, "discover-rootfs"));
+    assert_non_null(strstr(report, "}],\"values\":{\"root-wait-ms\":5000,\"root-tries\":3}}\n"));
+
+    /* remove report and the directories created for it */
+    assert_int_equal(unlink(path), 0);
+    *strrchr(path, '/') = '\0';
+    assert_int_equal(rmdir(path), 0);
+    *strrchr(path, '/') = '\0';
+    assert_int_equal(rmdir(path), 0);
+    assert_int_equal(rmdir(dir), 0);
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-timing-write-report.c
+ * @brief Implementation of an cominitTimingWriteReport() unit test group using cmocka.
+ */
+#include "utest-timing-write-report.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitTimingWriteReport().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitTimingWriteReportTestSuccess),
+        cmocka_unit_test(cominitTimingWriteReportTestFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
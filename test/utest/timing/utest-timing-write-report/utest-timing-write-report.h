@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-timing-write-report.h
+ * @brief Header declaring cmocka unit test functions for cominitTimingWriteReport().
+ */
+#ifndef __UTEST_TIMING_WRITE_REPORT_H__
+#define __UTEST_TIMING_WRITE_REPORT_H__
+
+/**
+ * Unit test for cominitTimingWriteReport() successful code path.
+ * @param state
+ */
+void cominitTimingWriteReportTestSuccess(void **state);
+
+/**
+ * Unit test for cominitTimingWriteReport() if the report cannot be written.
+ * @param state
+ */
+void cominitTimingWriteReportTestFailure(void **state);
+
+#endif /* __UTEST_TIMING_WRITE_REPORT_H__ */
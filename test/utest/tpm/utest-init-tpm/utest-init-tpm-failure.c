@@ -15,7 +15,7 @@
 void cominitInitTpmTestNullCtxFailure(void **state) {
     COMINIT_PARAM_UNUSED(state);
 
-    assert_int_not_equal(cominitInitTpm(NULL), 0);
+    assert_int_not_equal(cominitInitTpm(NULL, NULL), 0);
 }
 
 void cominitInitTpmTestTss2InitFailFailure(void **state) {
@@ -23,7 +23,7 @@ void cominitInitTpmTestTss2InitFailFailure(void **state) {
     cominitTpmContext_t ctx;
 
     will_return(__wrap_Tss2_TctiLdr_Initialize, TSS2_TCTI_RC_GENERAL_FAILURE);
-    assert_int_not_equal(cominitInitTpm(&ctx), 0);
+    assert_int_not_equal(cominitInitTpm(&ctx, NULL), 0);
 }
 
 void cominitInitTpmTestEsysInitFailFailure(void **state) {
@@ -32,5 +32,23 @@ void cominitInitTpmTestEsysInitFailFailure(void **state) {
 
     will_return(__wrap_Tss2_TctiLdr_Initialize, TSS2_RC_SUCCESS);
     will_return(__wrap_Esys_Initialize, TSS2_ESYS_RC_GENERAL_FAILURE);
-    assert_int_not_equal(cominitInitTpm(&ctx), 0);
+    assert_int_not_equal(cominitInitTpm(&ctx, NULL), 0);
+}
+
+void cominitInitTpmTestFailureModeFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    cominitTpmContext_t ctx;
+
+    ctx.esysCtx = calloc(1, sizeof(char));
+    ctx.tctiCtx = calloc(1, sizeof(char));
+
+    will_return(__wrap_Tss2_TctiLdr_Initialize, TSS2_RC_SUCCESS);
+    will_return(__wrap_Esys_Initialize, TSS2_RC_SUCCESS);
+    will_return(__wrap_Esys_GetTestResult, TSS2_RC_SUCCESS);
+    will_return(__wrap_Esys_GetTestResult, TPM2_RC_FAILURE);
+    expect_value(__wrap_Esys_Free, __ptr, NULL);
+    assert_int_not_equal(cominitInitTpm(&ctx, NULL), 0);
+
+    free(ctx.esysCtx);
+    free(ctx.tctiCtx);
 }
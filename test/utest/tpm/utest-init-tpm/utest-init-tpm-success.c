@@ -16,7 +16,56 @@ void cominitInitTpmTestSuccess(void **state) {
     COMINIT_PARAM_UNUSED(state);
     cominitTpmContext_t ctx;
 
+    ctx.esysCtx = calloc(1, sizeof(char));
+    ctx.tctiCtx = calloc(1, sizeof(char));
+
+    will_return(__wrap_Tss2_TctiLdr_Initialize, TSS2_RC_SUCCESS);
+    will_return(__wrap_Esys_Initialize, TSS2_RC_SUCCESS);
+    will_return(__wrap_Esys_GetTestResult, TSS2_RC_SUCCESS);
+    will_return(__wrap_Esys_GetTestResult, TPM2_RC_NEEDS_TEST);
+    expect_value(__wrap_Esys_Free, __ptr, NULL);
+    will_return(__wrap_Esys_IncrementalSelfTest, TSS2_RC_SUCCESS);
+    expect_value(__wrap_Esys_Free, __ptr, NULL);
+    assert_int_equal(cominitInitTpm(&ctx, NULL), 0);
+
+    free(ctx.esysCtx);
+    free(ctx.tctiCtx);
+}
+
+void cominitInitTpmTestSelftestDoneSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    cominitTpmContext_t ctx;
+
+    ctx.esysCtx = calloc(1, sizeof(char));
+    ctx.tctiCtx = calloc(1, sizeof(char));
+
     will_return(__wrap_Tss2_TctiLdr_Initialize, TSS2_RC_SUCCESS);
     will_return(__wrap_Esys_Initialize, TSS2_RC_SUCCESS);
-    assert_int_equal(cominitInitTpm(&ctx), 0);
+    will_return(__wrap_Esys_GetTestResult, TSS2_RC_SUCCESS);
+    will_return(__wrap_Esys_GetTestResult, TPM2_RC_SUCCESS);
+    expect_value(__wrap_Esys_Free, __ptr, NULL);
+    assert_int_equal(cominitInitTpm(&ctx, NULL), 0);
+
+    free(ctx.esysCtx);
+    free(ctx.tctiCtx);
+}
+
+void cominitInitTpmTestFullSelftestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    cominitTpmContext_t ctx;
+
+    ctx.esysCtx = calloc(1, sizeof(char));
+    ctx.tctiCtx = calloc(1, sizeof(char));
+
+    will_return(__wrap_Tss2_TctiLdr_Initialize, TSS2_RC_SUCCESS);
+    will_return(__wrap_Esys_Initialize, TSS2_RC_SUCCESS);
+    will_return(__wrap_Esys_GetTestResult, TSS2_ESYS_RC_GENERAL_FAILURE);
+    will_return(__wrap_Esys_GetTestResult, TPM2_RC_SUCCESS);
+    expect_value(__wrap_Esys_Free, __ptr, NULL);
+    will_return(__wrap_Esys_IncrementalSelfTest, TSS2_ESYS_RC_GENERAL_FAILURE);
+    expect_value(__wrap_Esys_Free, __ptr, NULL);
+    assert_int_equal(cominitInitTpm(&ctx, NULL), 0);
+
+    free(ctx.esysCtx);
+    free(ctx.tctiCtx);
 }
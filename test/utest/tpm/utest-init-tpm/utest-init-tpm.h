@@ -14,6 +14,18 @@
  */
 void cominitInitTpmTestSuccess(void **state);
 
+/**
+ * Unit test for cominitInitTpm() with a TPM that already completed its self-test.
+ * @param state
+ */
+void cominitInitTpmTestSelftestDoneSuccess(void **state);
+
+/**
+ * Unit test for cominitInitTpm() falling back to a full self-test.
+ * @param state
+ */
+void cominitInitTpmTestFullSelftestSuccess(void **state);
+
 /**
  * Unit test that simulates a null value parameter for tpmCtx
  * @param state
@@ -32,4 +44,10 @@ void cominitInitTpmTestTss2InitFailFailure(void **state);
  */
 void cominitInitTpmTestEsysInitFailFailure(void **state);
 
+/**
+ * Unit test that simulates a TPM in failure mode
+ * @param state
+ */
+void cominitInitTpmTestFailureModeFailure(void **state);
+
 #endif /* __UTEST_TPM_EXTEND_PCR_H__ */
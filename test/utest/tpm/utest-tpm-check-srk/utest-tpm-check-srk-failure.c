@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-check-srk-failure.c
+ * @brief Implementation of failure case unit tests for cominitTpmCheckSrk().
+ */
+#include <stdlib.h>
+#include <tss2/tss2_esys.h>
+
+#include "common.h"
+#include "tpm.h"
+#include "unit_test.h"
+#include "utest-tpm-check-srk.h"
+
+/** An SRK handle as returned by Esys_TR_FromTPMPublic(). **/
+#define UTEST_SRK_ESYS_TR 0x4000ffu
+/** The attributes of an SRK created from the template of the TCG TPM v2.0 Provisioning Guidance. **/
+#define UTEST_SRK_ATTRIBUTES                                                                          \
+    (TPMA_OBJECT_USERWITHAUTH | TPMA_OBJECT_RESTRICTED | TPMA_OBJECT_DECRYPT | TPMA_OBJECT_FIXEDTPM | \
+     TPMA_OBJECT_FIXEDPARENT | TPMA_OBJECT_SENSITIVEDATAORIGIN | TPMA_OBJECT_NODA)
+
+/**
+ * Sets the expectations for an Esys_ReadPublic() call.
+ *
+ * @param esysCtx   The ESYS context expected by Esys_ReadPublic().
+ * @param rc        The return code of Esys_ReadPublic().
+ * @param srkPublic The public area returned by Esys_ReadPublic() on success and released by Esys_Free().
+ */
+static void cominitTpmCheckSrkTestExpectReadPublic(ESYS_CONTEXT *esysCtx, TSS2_RC rc, TPM2B_PUBLIC *srkPublic) {
+    expect_value(__wrap_Esys_ReadPublic, esysContext, esysCtx);
+    expect_value(__wrap_Esys_ReadPublic, objectHandle, UTEST_SRK_ESYS_TR);
+    expect_value(__wrap_Esys_ReadPublic, shandle1, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_ReadPublic, shandle2, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_ReadPublic, shandle3, ESYS_TR_NONE);
+    will_return(__wrap_Esys_ReadPublic, rc);
+    if (rc == TSS2_RC_SUCCESS) {
+        will_return(__wrap_Esys_ReadPublic, srkPublic);
+    }
+    expect_value(__wrap_Esys_Free, __ptr, srkPublic);
+}
+
+void cominitTpmCheckSrkTestNullCtxFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    assert_int_equal(cominitTpmCheckSrk(NULL, UTEST_SRK_ESYS_TR, TPM2_ALG_ECC), EXIT_FAILURE);
+}
+
+void cominitTpmCheckSrkTestReadPublicFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    ESYS_CONTEXT *esysCtx = calloc(1, sizeof(char));
+
+    cominitTpmCheckSrkTestExpectReadPublic(esysCtx, TSS2_ESYS_RC_GENERAL_FAILURE, NULL);
+    assert_int_equal(cominitTpmCheckSrk(esysCtx, UTEST_SRK_ESYS_TR, TPM2_ALG_ECC), EXIT_FAILURE);
+
+    free(esysCtx);
+}
+
+void cominitTpmCheckSrkTestNotFixedTpmFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    ESYS_CONTEXT *esysCtx = calloc(1, sizeof(char));
+    TPM2B_PUBLIC srkPublic = {
+        .publicArea =
+            {
+                .type = TPM2_ALG_ECC,
+                .nameAlg = TPM2_ALG_SHA256,
+                .objectAttributes = UTEST_SRK_ATTRIBUTES & ~(TPMA_OBJECT_FIXEDTPM | TPMA_OBJECT_FIXEDPARENT),
+                .parameters.eccDetail.symmetric = {.algorithm = TPM2_ALG_AES,
+                                                   .keyBits.aes = 128,
+                                                   .mode.aes = TPM2_ALG_CFB},
+            },
+    };
+
+    cominitTpmCheckSrkTestExpectReadPublic(esysCtx, TSS2_RC_SUCCESS, &srkPublic);
+    assert_int_equal(cominitTpmCheckSrk(esysCtx, UTEST_SRK_ESYS_TR, TPM2_ALG_ECC), EXIT_FAILURE);
+
+    free(esysCtx);
+}
+
+void cominitTpmCheckSrkTestUnrestrictedFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    ESYS_CONTEXT *esysCtx = calloc(1, sizeof(char));
+    TPM2B_PUBLIC srkPublic = {
+        .publicArea =
+            {
+                .type = TPM2_ALG_ECC,
+                .nameAlg = TPM2_ALG_SHA256,
+                .objectAttributes = (UTEST_SRK_ATTRIBUTES & ~TPMA_OBJECT_RESTRICTED) | TPMA_OBJECT_SIGN_ENCRYPT,
+                .parameters.eccDetail.symmetric = {.algorithm = TPM2_ALG_NULL},
+            },
+    };
+
+    cominitTpmCheckSrkTestExpectReadPublic(esysCtx, TSS2_RC_SUCCESS, &srkPublic);
+    assert_int_equal(cominitTpmCheckSrk(esysCtx, UTEST_SRK_ESYS_TR, TPM2_ALG_ECC), EXIT_FAILURE);
+
+    free(esysCtx);
+}
+
+void cominitTpmCheckSrkTestTypeFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    ESYS_CONTEXT *esysCtx = calloc(1, sizeof(char));
+    TPM2B_PUBLIC srkPublic = {
+        .publicArea =
+            {
+                .type = TPM2_ALG_RSA,
+                .nameAlg = TPM2_ALG_SHA256,
+                .objectAttributes = UTEST_SRK_ATTRIBUTES,
+                .parameters.rsaDetail =
+                    {
+                        .symmetric = {.algorithm = TPM2_ALG_AES, .keyBits.aes = 128, .mode.aes = TPM2_ALG_CFB},
+                        .keyBits = 2048,
+                    },
+            },
+    };
+
+    cominitTpmCheckSrkTestExpectReadPublic(esysCtx, TSS2_RC_SUCCESS, &srkPublic);
+    assert_int_equal(cominitTpmCheckSrk(esysCtx, UTEST_SRK_ESYS_TR, TPM2_ALG_ECC), EXIT_FAILURE);
+
+    free(esysCtx);
+}
+
+void cominitTpmCheckSrkTestSymmetricFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    ESYS_CONTEXT *esysCtx = calloc(1, sizeof(char));
+    TPM2B_PUBLIC srkPublic = {
+        .publicArea =
+            {
+                .type = TPM2_ALG_ECC,
+                .nameAlg = TPM2_ALG_SHA256,
+                .objectAttributes = UTEST_SRK_ATTRIBUTES,
+                .parameters.eccDetail.symmetric = {.algorithm = TPM2_ALG_AES,
+                                                   .keyBits.aes = 256,
+                                                   .mode.aes = TPM2_ALG_CFB},
+            },
+    };
+
+    cominitTpmCheckSrkTestExpectReadPublic(esysCtx, TSS2_RC_SUCCESS, &srkPublic);
+    assert_int_equal(cominitTpmCheckSrk(esysCtx, UTEST_SRK_ESYS_TR, TPM2_ALG_ECC), EXIT_FAILURE);
+
+    free(esysCtx);
+}
@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-check-srk.c
+ * @brief Implementation of a cominitTpmCheckSrk() unit test group using cmocka.
+ */
+#include "utest-tpm-check-srk.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitTpmCheckSrk().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitTpmCheckSrkTestEccSuccess),
+        cmocka_unit_test(cominitTpmCheckSrkTestRsaSuccess),
+        cmocka_unit_test(cominitTpmCheckSrkTestNullCtxFailure),
+        cmocka_unit_test(cominitTpmCheckSrkTestReadPublicFailure),
+        cmocka_unit_test(cominitTpmCheckSrkTestNotFixedTpmFailure),
+        cmocka_unit_test(cominitTpmCheckSrkTestUnrestrictedFailure),
+        cmocka_unit_test(cominitTpmCheckSrkTestTypeFailure),
+        cmocka_unit_test(cominitTpmCheckSrkTestSymmetricFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
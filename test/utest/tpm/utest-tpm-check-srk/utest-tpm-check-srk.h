@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-check-srk.h
+ * @brief Header declaring cmocka unit test functions for cominitTpmCheckSrk().
+ */
+#ifndef __UTEST_TPM_CHECK_SRK_H__
+#define __UTEST_TPM_CHECK_SRK_H__
+
+/**
+ * Unit test for cominitTpmCheckSrk() successful code path with an ECC SRK.
+ * @param state
+ */
+void cominitTpmCheckSrkTestEccSuccess(void **state);
+
+/**
+ * Unit test for cominitTpmCheckSrk() successful code path with an RSA SRK of earlier cominit versions.
+ * @param state
+ */
+void cominitTpmCheckSrkTestRsaSuccess(void **state);
+
+/**
+ * Unit test that simulates a NULL ESYS context.
+ * @param state
+ */
+void cominitTpmCheckSrkTestNullCtxFailure(void **state);
+
+/**
+ * Unit test that simulates a failure of Esys_ReadPublic().
+ * @param state
+ */
+void cominitTpmCheckSrkTestReadPublicFailure(void **state);
+
+/**
+ * Unit test that simulates a persistent key that may leave the TPM.
+ * @param state
+ */
+void cominitTpmCheckSrkTestNotFixedTpmFailure(void **state);
+
+/**
+ * Unit test that simulates a persistent key that is no restricted decryption key.
+ * @param state
+ */
+void cominitTpmCheckSrkTestUnrestrictedFailure(void **state);
+
+/**
+ * Unit test that simulates a persistent key of another type.
+ * @param state
+ */
+void cominitTpmCheckSrkTestTypeFailure(void **state);
+
+/**
+ * Unit test that simulates a persistent key protecting its children with AES-256 instead of AES-128.
+ * @param state
+ */
+void cominitTpmCheckSrkTestSymmetricFailure(void **state);
+
+#endif /* __UTEST_TPM_CHECK_SRK_H__ */
@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-init-async-failure.c
+ * @brief Implementation of failure case unit tests for cominitTpmInitStart(), cominitTpmInitJoin() and
+ *        cominitTpmInitRelease().
+ */
+#include <stdlib.h>
+#include <tss2/tss2_esys.h>
+
+#include "common.h"
+#include "tpm.h"
+#include "unit_test.h"
+#include "utest-tpm-init-async.h"
+
+void cominitTpmInitAsyncTestNullFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitTpmInitStart(NULL, NULL);
+    assert_int_not_equal(cominitTpmInitJoin(NULL), 0);
+    cominitTpmInitRelease(NULL);
+}
+
+void cominitTpmInitAsyncTestTss2InitFailFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    cominitTpmInit_t init = {0};
+
+    will_return(__wrap_Tss2_TctiLdr_Initialize, TSS2_TCTI_RC_GENERAL_FAILURE);
+    will_return(__wrap_Tss2_TctiLdr_Initialize, TSS2_TCTI_RC_GENERAL_FAILURE);
+    cominitTpmInitStart(&init, COMINIT_TEST_TCTI);
+    assert_int_not_equal(cominitTpmInitJoin(&init), 0);
+    assert_int_not_equal(cominitTpmInitJoin(&init), 0);
+    cominitTpmInitRelease(&init);
+}
+
+void cominitTpmInitAsyncTestEsysInitFailFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    cominitTpmInit_t init = {0};
+
+    will_return(__wrap_Tss2_TctiLdr_Initialize, TSS2_RC_SUCCESS);
+    will_return(__wrap_Esys_Initialize, TSS2_ESYS_RC_GENERAL_FAILURE);
+    will_return(__wrap_Tss2_TctiLdr_Initialize, TSS2_RC_SUCCESS);
+    will_return(__wrap_Esys_Initialize, TSS2_ESYS_RC_GENERAL_FAILURE);
+    cominitTpmInitStart(&init, COMINIT_TEST_TCTI);
+    assert_int_not_equal(cominitTpmInitJoin(&init), 0);
+    cominitTpmInitRelease(&init);
+}
@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-init-async-success.c
+ * @brief Implementation of success case unit tests for cominitTpmInitStart(), cominitTpmInitJoin() and
+ *        cominitTpmInitRelease().
+ */
+#include <stdlib.h>
+#include <tss2/tss2_esys.h>
+
+#include "common.h"
+#include "tpm.h"
+#include "unit_test.h"
+#include "utest-tpm-init-async.h"
+
+void cominitTpmInitAsyncTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    cominitTpmInit_t init = {0};
+    ESYS_CONTEXT *esysCtx = calloc(1, sizeof(char));
+    TSS2_TCTI_CONTEXT *tctiCtx = calloc(1, sizeof(char));
+
+    init.tpmCtx.esysCtx = esysCtx;
+    init.tpmCtx.tctiCtx = tctiCtx;
+
+    will_return(__wrap_Tss2_TctiLdr_Initialize, TSS2_RC_SUCCESS);
+    will_return(__wrap_Esys_Initialize, TSS2_RC_SUCCESS);
+    will_return(__wrap_Esys_GetTestResult, TSS2_RC_SUCCESS);
+    will_return(__wrap_Esys_GetTestResult, TPM2_RC_SUCCESS);
+    expect_value(__wrap_Esys_Free, __ptr, NULL);
+    cominitTpmInitStart(&init, COMINIT_TEST_TCTI);
+    assert_true(init.started);
+    assert_int_equal(cominitTpmInitJoin(&init), 0);
+    assert_false(init.threadStarted);
+    assert_int_equal(cominitTpmInitJoin(&init), 0);
+    cominitTpmInitRelease(&init);
+    assert_int_not_equal(init.result, 0);
+
+    free(esysCtx);
+    free(tctiCtx);
+}
+
+void cominitTpmInitAsyncTestRetrySuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    cominitTpmInit_t init = {0};
+    ESYS_CONTEXT *esysCtx = calloc(1, sizeof(char));
+    TSS2_TCTI_CONTEXT *tctiCtx = calloc(1, sizeof(char));
+
+    init.tpmCtx.esysCtx = esysCtx;
+    init.tpmCtx.tctiCtx = tctiCtx;
+
+    /* the attempt in the background fails, joining retries it once */
+    will_return(__wrap_Tss2_TctiLdr_Initialize, TSS2_TCTI_RC_IO_ERROR);
+    will_return(__wrap_Tss2_TctiLdr_Initialize, TSS2_RC_SUCCESS);
+    will_return(__wrap_Esys_Initialize, TSS2_RC_SUCCESS);
+    will_return(__wrap_Esys_GetTestResult, TSS2_RC_SUCCESS);
+    will_return(__wrap_Esys_GetTestResult, TPM2_RC_SUCCESS);
+    expect_value(__wrap_Esys_Free, __ptr, NULL);
+    cominitTpmInitStart(&init, COMINIT_TEST_TCTI);
+    assert_int_equal(cominitTpmInitJoin(&init), 0);
+    assert_false(init.threadStarted);
+    cominitTpmInitRelease(&init);
+
+    free(esysCtx);
+    free(tctiCtx);
+}
+
+void cominitTpmInitAsyncTestJoinNotStartedSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    cominitTpmInit_t init = {0};
+    ESYS_CONTEXT *esysCtx = calloc(1, sizeof(char));
+    TSS2_TCTI_CONTEXT *tctiCtx = calloc(1, sizeof(char));
+
+    init.tpmCtx.esysCtx = esysCtx;
+    init.tpmCtx.tctiCtx = tctiCtx;
+
+    will_return(__wrap_Tss2_TctiLdr_Initialize, TSS2_RC_SUCCESS);
+    will_return(__wrap_Esys_Initialize, TSS2_RC_SUCCESS);
+    will_return(__wrap_Esys_GetTestResult, TSS2_RC_SUCCESS);
+    will_return(__wrap_Esys_GetTestResult, TPM2_RC_SUCCESS);
+    expect_value(__wrap_Esys_Free, __ptr, NULL);
+    assert_int_equal(cominitTpmInitJoin(&init), 0);
+    assert_true(init.started);
+    assert_false(init.threadStarted);
+    cominitTpmInitRelease(&init);
+
+    free(esysCtx);
+    free(tctiCtx);
+}
+
+void cominitTpmInitAsyncTestReleaseNotStartedSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    cominitTpmInit_t init = {0};
+
+    cominitTpmInitRelease(&init);
+    assert_false(init.started);
+}
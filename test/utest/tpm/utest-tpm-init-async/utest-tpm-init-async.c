@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-init-async.c
+ * @brief Implementation of a unit test group for cominitTpmInitStart(), cominitTpmInitJoin() and
+ *        cominitTpmInitRelease() using cmocka.
+ */
+#include "utest-tpm-init-async.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitTpmInitStart(), cominitTpmInitJoin() and cominitTpmInitRelease().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitTpmInitAsyncTestSuccess),
+        cmocka_unit_test(cominitTpmInitAsyncTestRetrySuccess),
+        cmocka_unit_test(cominitTpmInitAsyncTestJoinNotStartedSuccess),
+        cmocka_unit_test(cominitTpmInitAsyncTestReleaseNotStartedSuccess),
+        cmocka_unit_test(cominitTpmInitAsyncTestNullFailure),
+        cmocka_unit_test(cominitTpmInitAsyncTestTss2InitFailFailure),
+        cmocka_unit_test(cominitTpmInitAsyncTestEsysInitFailFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
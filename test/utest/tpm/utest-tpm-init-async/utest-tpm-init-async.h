@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-init-async.h
+ * @brief Header declaring cmocka unit test functions for cominitTpmInitStart(), cominitTpmInitJoin() and
+ *        cominitTpmInitRelease().
+ */
+#ifndef __UTEST_TPM_INIT_ASYNC_H__
+#define __UTEST_TPM_INIT_ASYNC_H__
+
+#define COMINIT_TEST_TCTI "swtpm"  ///< TCTI configuration, so the background attempt does not depend on /dev/tpm*.
+
+/**
+ * Unit test for starting the TPM initialization in the background and joining it.
+ * @param state
+ */
+void cominitTpmInitAsyncTestSuccess(void **state);
+
+/**
+ * Unit test for retrying a TPM initialization that did not succeed in the background when joining it.
+ * @param state
+ */
+void cominitTpmInitAsyncTestRetrySuccess(void **state);
+/**
+ * Unit test for joining a TPM initialization that has not been started, so it runs synchronously.
+ * @param state
+ */
+void cominitTpmInitAsyncTestJoinNotStartedSuccess(void **state);
+
+/**
+ * Unit test for releasing a TPM initialization that has not been started.
+ * @param state
+ */
+void cominitTpmInitAsyncTestReleaseNotStartedSuccess(void **state);
+
+/**
+ * Unit test that simulates null value parameters.
+ * @param state
+ */
+void cominitTpmInitAsyncTestNullFailure(void **state);
+
+/**
+ * Unit test that simulates a Tss2_TctiLdr_Initialize() failure in the background.
+ * @param state
+ */
+void cominitTpmInitAsyncTestTss2InitFailFailure(void **state);
+
+/**
+ * Unit test that simulates a Esys_Initialize() failure in the background.
+ * @param state
+ */
+void cominitTpmInitAsyncTestEsysInitFailFailure(void **state);
+
+#endif /* __UTEST_TPM_INIT_ASYNC_H__ */
@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-parse-tcti-failure.c
+ * @brief Implementation of several failure case unit tests for cominitTpmParseTcti().
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "tpm.h"
+#include "unit_test.h"
+#include "utest-tpm-parse-tcti.h"
+
+void cominitTpmParseTctiTestFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitCliArgs_t ctx = {0};
+    char tooLong[sizeof(ctx.tcti) + 1];
+    memset(tooLong, 'a', sizeof(tooLong) - 1);
+    tooLong[sizeof(tooLong) - 1] = '\0';
+
+    assert_int_not_equal(cominitTpmParseTcti(&ctx, ""), 0);
+    assert_int_not_equal(cominitTpmParseTcti(&ctx, tooLong), 0);
+    assert_string_equal(ctx.tcti, "");
+    assert_int_not_equal(cominitTpmParseTcti(NULL, "device:/dev/tpm0"), 0);
+    assert_int_not_equal(cominitTpmParseTcti(&ctx, NULL), 0);
+}
@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-parse-tcti-success.c
+ * @brief Implementation of a success case unit test for cominitTpmParseTcti().
+ */
+#include <stdlib.h>
+
+#include "common.h"
+#include "tpm.h"
+#include "unit_test.h"
+#include "utest-tpm-parse-tcti.h"
+
+void cominitTpmParseTctiTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitCliArgs_t ctx = {0};
+    const char *testStrings[] = {
+        "device:/dev/tpm1",
+        "swtpm:host=localhost,port=2321",
+        "/dev/tpmrm0",
+    };
+
+    for (size_t i = 0; i < ARRAY_SIZE(testStrings); ++i) {
+        assert_int_equal(cominitTpmParseTcti(&ctx, testStrings[i]), 0);
+        assert_string_equal(ctx.tcti, testStrings[i]);
+    }
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-parse-tcti.h
+ * @brief Header declaring cmocka unit test functions for cominitTpmParseTcti().
+ */
+#ifndef __UTEST_TPM_PARSE_TCTI_H__
+#define __UTEST_TPM_PARSE_TCTI_H__
+
+/**
+ * Unit test for cominitTpmParseTcti() successful code path.
+ * @param state
+ */
+void cominitTpmParseTctiTestSuccess(void **state);
+
+/**
+ * Unit test that simulates empty, too long and null value parameters
+ * @param state
+ */
+void cominitTpmParseTctiTestFailure(void **state);
+
+#endif /* __UTEST_TPM_PARSE_TCTI_H__ */
@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-protect-data-failure.c
+ * @brief Implementation of failure case unit tests for cominitTpmProtectData().
+ */
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <tss2/tss2_esys.h>
+
+#include "common.h"
+#include "tpm.h"
+#include "unit_test.h"
+#include "utest-tpm-protect-data.h"
+
+/**
+ * Builds a raw blob around an arbitrary payload.
+ *
+ * @param raw   Buffer of #COMINIT_TPM_BLOB_SIZE_MAX Bytes that receives the raw blob.
+ *
+ * @return  The length of the raw blob
+ */
+static size_t cominitTpmProtectDataTestAnyRawBlob(uint8_t *raw) {
+    TPM2B_PUBLIC sealedPublic = {.publicArea = {.type = TPM2_ALG_KEYEDHASH, .nameAlg = TPM2_ALG_SHA256}};
+    TPM2B_PRIVATE sealedPrivate = {.size = 16};
+
+    return cominitTpmProtectDataTestRawBlob(raw, &sealedPublic, &sealedPrivate);
+}
+
+void cominitTpmProtectDataTestUnrecognizedFailure(void **state) {
+    cominitTpmProtectDataTest_t *test = *state;
+    uint8_t content[COMINIT_TPM_BLOB_SIZE_MAX] = {0};
+
+    /* e.g. the wrong partition given, only its very start is set */
+    memcpy(content, "CMNTBLOX", COMINIT_TPM_BLOB_MAGIC_SIZE);
+    cominitTpmProtectDataTestWriteBlob(test, content, sizeof(content));
+
+    assert_int_equal(cominitTpmProtectData(&test->tpmCtx, &test->argCtx), TpmFailure);
+    cominitTpmProtectDataTestAssertBlob(test, content, sizeof(content));
+}
+
+void cominitTpmProtectDataTestBadCrcFailure(void **state) {
+    cominitTpmProtectDataTest_t *test = *state;
+    uint8_t raw[COMINIT_TPM_BLOB_SIZE_MAX];
+
+    size_t rawLen = cominitTpmProtectDataTestAnyRawBlob(raw);
+    raw[rawLen - 1] ^= 0x01;
+    cominitTpmProtectDataTestWriteBlob(test, raw, rawLen);
+
+    assert_int_equal(cominitTpmProtectData(&test->tpmCtx, &test->argCtx), TpmFailure);
+    cominitTpmProtectDataTestAssertBlob(test, raw, rawLen);
+}
+
+void cominitTpmProtectDataTestBadLengthFailure(void **state) {
+    cominitTpmProtectDataTest_t *test = *state;
+    uint8_t raw[COMINIT_TPM_BLOB_SIZE_MAX];
+
+    size_t rawLen = cominitTpmProtectDataTestAnyRawBlob(raw);
+    /* payload length exceeding the 4 KiB read from the partition */
+    raw[COMINIT_TPM_BLOB_MAGIC_SIZE] = 0xf1;
+    raw[COMINIT_TPM_BLOB_MAGIC_SIZE + 1] = 0x0f;
+    raw[COMINIT_TPM_BLOB_MAGIC_SIZE + 2] = 0x00;
+    raw[COMINIT_TPM_BLOB_MAGIC_SIZE + 3] = 0x00;
+    cominitTpmProtectDataTestWriteBlob(test, raw, rawLen);
+
+    assert_int_equal(cominitTpmProtectData(&test->tpmCtx, &test->argCtx), TpmFailure);
+    cominitTpmProtectDataTestAssertBlob(test, raw, rawLen);
+}
+
+void cominitTpmProtectDataTestLegacyMkdirFailure(void **state) {
+    cominitTpmProtectDataTest_t *test = *state;
+    uint8_t ext4[COMINIT_TPM_EXT4_MAGIC_OFFSET + 2] = {0};
+
+    ext4[COMINIT_TPM_EXT4_MAGIC_OFFSET] = (uint8_t)COMINIT_TPM_EXT4_MAGIC;
+    ext4[COMINIT_TPM_EXT4_MAGIC_OFFSET + 1] = (uint8_t)(COMINIT_TPM_EXT4_MAGIC >> 8);
+    cominitTpmProtectDataTestWriteBlob(test, ext4, sizeof(ext4));
+
+    /* the ext4 superblock is detected and the partition is about to be mounted */
+    expect_string(__wrap_mkdir, pathName, COMINIT_TPM_MNT_PT);
+    expect_value(__wrap_mkdir, mode, S_IRWXU);
+    will_return(__wrap_mkdir, EACCES);
+    will_return(__wrap_mkdir, -1);
+
+    assert_int_equal(cominitTpmProtectData(&test->tpmCtx, &test->argCtx), TpmFailure);
+    cominitTpmProtectDataTestAssertBlob(test, ext4, sizeof(ext4));
+}
+
+void cominitTpmProtectDataTestNoDeviceFailure(void **state) {
+    cominitTpmProtectDataTest_t *test = *state;
+
+    unlink(test->argCtx.devNodeBlob);
+    assert_int_equal(cominitTpmProtectData(&test->tpmCtx, &test->argCtx), TpmFailure);
+    test->argCtx.devNodeBlob[0] = '\0';
+    assert_int_equal(cominitTpmProtectData(&test->tpmCtx, &test->argCtx), TpmFailure);
+}
@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-protect-data-success.c
+ * @brief Implementation of success case unit tests for cominitTpmProtectData().
+ *
+ * The blob partition is recognized correctly in these cases. As the mocked TPM fails afterwards,
+ * cominitTpmProtectData() still reports a failure.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <tss2/tss2_esys.h>
+#include <tss2/tss2_mu.h>
+
+#include "common.h"
+#include "tpm.h"
+#include "unit_test.h"
+#include "utest-tpm-protect-data.h"
+
+/**
+ * Sets the expectations for sealing up to a failing creation of the SRK.
+ *
+ * @param esysCtx   The ESYS context expected by the TPM functions.
+ */
+static void cominitTpmProtectDataTestExpectSeal(ESYS_CONTEXT *esysCtx) {
+    expect_value(__wrap_Esys_TR_FromTPMPublic, esys_context, esysCtx);
+    expect_value(__wrap_Esys_TR_FromTPMPublic, tpm_handle, COMINIT_TPM_SRK_HANDLE);
+    expect_value(__wrap_Esys_TR_FromTPMPublic, shandle1, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_TR_FromTPMPublic, shandle2, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_TR_FromTPMPublic, shandle3, ESYS_TR_NONE);
+    will_return(__wrap_Esys_TR_FromTPMPublic, TSS2_ESYS_RC_GENERAL_FAILURE);
+
+    expect_value(__wrap_Esys_CreatePrimary, esysContext, esysCtx);
+    expect_value(__wrap_Esys_CreatePrimary, primaryHandle, ESYS_TR_RH_OWNER);
+    expect_value(__wrap_Esys_CreatePrimary, shandle1, ESYS_TR_PASSWORD);
+    expect_value(__wrap_Esys_CreatePrimary, shandle2, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_CreatePrimary, shandle3, ESYS_TR_NONE);
+    expect_any(__wrap_Esys_CreatePrimary, inSensitive);
+    expect_any(__wrap_Esys_CreatePrimary, inPublic);
+    expect_any(__wrap_Esys_CreatePrimary, outsideInfo);
+    expect_any(__wrap_Esys_CreatePrimary, creationPCR);
+    expect_any(__wrap_Esys_CreatePrimary, objectHandle);
+    expect_any(__wrap_Esys_CreatePrimary, outPublic);
+    expect_any(__wrap_Esys_CreatePrimary, creationData);
+    expect_any(__wrap_Esys_CreatePrimary, creationHash);
+    expect_any(__wrap_Esys_CreatePrimary, creationTicket);
+    will_return(__wrap_Esys_CreatePrimary, TSS2_ESYS_RC_GENERAL_FAILURE);
+
+    expect_value(__wrap_Esys_FlushContext, esysContext, esysCtx);
+    expect_value(__wrap_Esys_FlushContext, flushHandle, ESYS_TR_NONE);
+    will_return(__wrap_Esys_FlushContext, TSS2_RC_SUCCESS);
+
+    /* outputs of Esys_CreatePrimary(), the policy digest and the sealed object */
+    expect_value_count(__wrap_Esys_Free, __ptr, NULL, 7);
+}
+
+void cominitTpmProtectDataTestZeroedSuccess(void **state) {
+    cominitTpmProtectDataTest_t *test = *state;
+    static const uint8_t zeros[COMINIT_TPM_BLOB_SIZE_MAX] = {0};
+
+    cominitTpmProtectDataTestExpectSeal(test->tpmCtx.esysCtx);
+    assert_int_equal(cominitTpmProtectData(&test->tpmCtx, &test->argCtx), TpmFailure);
+    cominitTpmProtectDataTestAssertBlob(test, zeros, sizeof(zeros));
+}
+
+void cominitTpmProtectDataTestErasedFlashSuccess(void **state) {
+    cominitTpmProtectDataTest_t *test = *state;
+    uint8_t erased[COMINIT_TPM_BLOB_SIZE_MAX];
+
+    memset(erased, 0xff, sizeof(erased));
+    cominitTpmProtectDataTestWriteBlob(test, erased, sizeof(erased));
+
+    cominitTpmProtectDataTestExpectSeal(test->tpmCtx.esysCtx);
+    assert_int_equal(cominitTpmProtectData(&test->tpmCtx, &test->argCtx), TpmFailure);
+    cominitTpmProtectDataTestAssertBlob(test, erased, sizeof(erased));
+}
+
+void cominitTpmProtectDataTestRawBlobSuccess(void **state) {
+    cominitTpmProtectDataTest_t *test = *state;
+    ESYS_CONTEXT *esysCtx = test->tpmCtx.esysCtx;
+    uint8_t raw[COMINIT_TPM_BLOB_SIZE_MAX];
+    TPM2B_PUBLIC sealedPublic = {
+        .publicArea =
+            {
+                .type = TPM2_ALG_KEYEDHASH,
+                .nameAlg = TPM2_ALG_SHA256,
+                .objectAttributes = TPMA_OBJECT_FIXEDTPM | TPMA_OBJECT_FIXEDPARENT,
+                .authPolicy = {.size = TPM2_SHA256_DIGEST_SIZE},
+                .parameters.keyedHashDetail.scheme.scheme = TPM2_ALG_NULL,
+                .unique.keyedHash = {.size = TPM2_SHA256_DIGEST_SIZE},
+            },
+    };
+    TPM2B_PRIVATE sealedPrivate = {.size = 64};
+    TPM2B_PUBLIC expectedPublic = {0};
+    TPM2B_PRIVATE expectedPrivate = {0};
+    TPM2B_PUBLIC srkPublic = {
+        .publicArea =
+            {
+                .type = TPM2_ALG_ECC,
+                .nameAlg = TPM2_ALG_SHA256,
+                .objectAttributes = TPMA_OBJECT_USERWITHAUTH | TPMA_OBJECT_RESTRICTED | TPMA_OBJECT_DECRYPT |
+                                    TPMA_OBJECT_FIXEDTPM | TPMA_OBJECT_FIXEDPARENT | TPMA_OBJECT_SENSITIVEDATAORIGIN |
+                                    TPMA_OBJECT_NODA,
+                .parameters.eccDetail.symmetric = {.algorithm = TPM2_ALG_AES,
+                                                   .keyBits.aes = 128,
+                                                   .mode.aes = TPM2_ALG_CFB},
+            },
+    };
+    size_t offset = 0;
+
+    memset(sealedPublic.publicArea.authPolicy.buffer, 0xab, TPM2_SHA256_DIGEST_SIZE);
+    memset(sealedPublic.publicArea.unique.keyedHash.buffer, 0xcd, TPM2_SHA256_DIGEST_SIZE);
+    for (size_t i = 0; i < sealedPrivate.size; i++) {
+        sealedPrivate.buffer[i] = (BYTE)i;
+    }
+    size_t rawLen = cominitTpmProtectDataTestRawBlob(raw, &sealedPublic, &sealedPrivate);
+    cominitTpmProtectDataTestWriteBlob(test, raw, rawLen);
+
+    /* the blob is expected to reach the TPM exactly as unmarshalled from the payload */
+    assert_int_equal(Tss2_MU_TPM2B_PUBLIC_Unmarshal(raw + COMINIT_TPM_BLOB_HEADER_SIZE,
+                                                    rawLen - COMINIT_TPM_BLOB_HEADER_SIZE, &offset, &expectedPublic),
+                     TSS2_RC_SUCCESS);
+    assert_int_equal(Tss2_MU_TPM2B_PRIVATE_Unmarshal(raw + COMINIT_TPM_BLOB_HEADER_SIZE,
+                                                     rawLen - COMINIT_TPM_BLOB_HEADER_SIZE, &offset, &expectedPrivate),
+                     TSS2_RC_SUCCESS);
+    assert_memory_equal(expectedPrivate.buffer, sealedPrivate.buffer, sealedPrivate.size);
+
+    expect_value(__wrap_Esys_TR_FromTPMPublic, esys_context, esysCtx);
+    expect_value(__wrap_Esys_TR_FromTPMPublic, tpm_handle, COMINIT_TPM_SRK_HANDLE);
+    expect_value(__wrap_Esys_TR_FromTPMPublic, shandle1, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_TR_FromTPMPublic, shandle2, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_TR_FromTPMPublic, shandle3, ESYS_TR_NONE);
+    will_return(__wrap_Esys_TR_FromTPMPublic, TSS2_RC_SUCCESS);
+
+    expect_value(__wrap_Esys_ReadPublic, esysContext, esysCtx);
+    expect_value(__wrap_Esys_ReadPublic, objectHandle, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_ReadPublic, shandle1, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_ReadPublic, shandle2, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_ReadPublic, shandle3, ESYS_TR_NONE);
+    will_return(__wrap_Esys_ReadPublic, TSS2_RC_SUCCESS);
+    will_return(__wrap_Esys_ReadPublic, &srkPublic);
+    expect_value(__wrap_Esys_Free, __ptr, &srkPublic);
+
+    expect_value(__wrap_Esys_Load, esysContext, esysCtx);
+    expect_value(__wrap_Esys_Load, parentHandle, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_Load, shandle1, ESYS_TR_PASSWORD);
+    expect_value(__wrap_Esys_Load, shandle2, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_Load, shandle3, ESYS_TR_NONE);
+    expect_memory(__wrap_Esys_Load, inPrivate, &expectedPrivate, sizeof(expectedPrivate));
+    expect_memory(__wrap_Esys_Load, inPublic, &expectedPublic, sizeof(expectedPublic));
+    will_return(__wrap_Esys_Load, TSS2_ESYS_RC_GENERAL_FAILURE);
+
+    expect_value(__wrap_Esys_TR_FromTPMPublic, esys_context, esysCtx);
+    expect_value(__wrap_Esys_TR_FromTPMPublic, tpm_handle, COMINIT_TPM_SRK_HANDLE_LEGACY);
+    expect_value(__wrap_Esys_TR_FromTPMPublic, shandle1, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_TR_FromTPMPublic, shandle2, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_TR_FromTPMPublic, shandle3, ESYS_TR_NONE);
+    will_return(__wrap_Esys_TR_FromTPMPublic, TSS2_ESYS_RC_GENERAL_FAILURE);
+
+    assert_int_equal(cominitTpmProtectData(&test->tpmCtx, &test->argCtx), TpmFailure);
+    cominitTpmProtectDataTestAssertBlob(test, raw, rawLen);
+}
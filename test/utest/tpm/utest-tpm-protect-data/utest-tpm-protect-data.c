@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-protect-data.c
+ * @brief Implementation of an cominitTpmProtectData() unit test group using cmocka.
+ */
+#include "utest-tpm-protect-data.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <tss2/tss2_mu.h>
+#include <unistd.h>
+
+#include "crc32.h"
+#include "unit_test.h"
+
+int cominitTpmProtectDataTestSetup(void **state) {
+    static const uint8_t zeros[UTEST_TPM_BLOB_DEVICE_SIZE] = {0};
+    char path[] = "/tmp/utest-tpm-blob-XXXXXX";
+
+    int fd = mkstemp(path);
+    assert_int_not_equal(fd, -1);
+    assert_int_equal(write(fd, zeros, sizeof(zeros)), sizeof(zeros));
+    close(fd);
+
+    cominitTpmProtectDataTest_t *test = calloc(1, sizeof(*test));
+    assert_non_null(test);
+    strcpy(test->argCtx.devNodeBlob, path);
+    strcpy(test->argCtx.devNodeCrypt, UTEST_TPM_CRYPT_DEVICE);
+    test->tpmCtx.esysCtx = calloc(1, sizeof(char));
+    assert_non_null(test->tpmCtx.esysCtx);
+    *state = test;
+    return 0;
+}
+
+int cominitTpmProtectDataTestTeardown(void **state) {
+    cominitTpmProtectDataTest_t *test = *state;
+    if (test->argCtx.devNodeBlob[0] != '\0') {
+        unlink(test->argCtx.devNodeBlob);
+    }
+    free(test->tpmCtx.esysCtx);
+    free(test);
+    return 0;
+}
+
+void cominitTpmProtectDataTestWriteBlob(const cominitTpmProtectDataTest_t *test, const void *data, size_t len) {
+    int fd = open(test->argCtx.devNodeBlob, O_WRONLY);
+    assert_int_not_equal(fd, -1);
+    assert_int_equal(pwrite(fd, data, len, 0), len);
+    close(fd);
+}
+
+void cominitTpmProtectDataTestAssertBlob(const cominitTpmProtectDataTest_t *test, const void *data, size_t len) {
+    uint8_t buf[UTEST_TPM_BLOB_DEVICE_SIZE];
+    int fd = open(test->argCtx.devNodeBlob, O_RDONLY);
+    assert_int_not_equal(fd, -1);
+    assert_true(len <= sizeof(buf));
+    assert_int_equal(pread(fd, buf, len, 0), len);
+    close(fd);
+    assert_memory_equal(buf, data, len);
+}
+
+size_t cominitTpmProtectDataTestRawBlob(uint8_t *buf, const TPM2B_PUBLIC *outPublic, const TPM2B_PRIVATE *outPrivate) {
+    size_t offset = COMINIT_TPM_BLOB_HEADER_SIZE;
+
+    memset(buf, 0, COMINIT_TPM_BLOB_SIZE_MAX);
+    assert_int_equal(Tss2_MU_TPM2B_PUBLIC_Marshal(outPublic, buf, COMINIT_TPM_BLOB_SIZE_MAX, &offset), TSS2_RC_SUCCESS);
+    assert_int_equal(Tss2_MU_TPM2B_PRIVATE_Marshal(outPrivate, buf, COMINIT_TPM_BLOB_SIZE_MAX, &offset),
+                     TSS2_RC_SUCCESS);
+
+    uint32_t payloadLen = (uint32_t)(offset - COMINIT_TPM_BLOB_HEADER_SIZE);
+    uint32_t crc = cominitCrc32(0, buf + COMINIT_TPM_BLOB_HEADER_SIZE, payloadLen);
+    memcpy(buf, COMINIT_TPM_BLOB_MAGIC, COMINIT_TPM_BLOB_MAGIC_SIZE);
+    for (size_t i = 0; i < 4; i++) {
+        buf[COMINIT_TPM_BLOB_MAGIC_SIZE + i] = (uint8_t)(payloadLen >> (8 * i));
+        buf[COMINIT_TPM_BLOB_MAGIC_SIZE + 4 + i] = (uint8_t)(crc >> (8 * i));
+    }
+
+    return offset;
+}
+
+/**
+ * Run the unit tests for cominitTpmProtectData().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(cominitTpmProtectDataTestZeroedSuccess, cominitTpmProtectDataTestSetup,
+                                        cominitTpmProtectDataTestTeardown),
+        cmocka_unit_test_setup_teardown(cominitTpmProtectDataTestErasedFlashSuccess, cominitTpmProtectDataTestSetup,
+                                        cominitTpmProtectDataTestTeardown),
+        cmocka_unit_test_setup_teardown(cominitTpmProtectDataTestRawBlobSuccess, cominitTpmProtectDataTestSetup,
+                                        cominitTpmProtectDataTestTeardown),
+        cmocka_unit_test_setup_teardown(cominitTpmProtectDataTestUnrecognizedFailure, cominitTpmProtectDataTestSetup,
+                                        cominitTpmProtectDataTestTeardown),
+        cmocka_unit_test_setup_teardown(cominitTpmProtectDataTestBadCrcFailure, cominitTpmProtectDataTestSetup,
+                                        cominitTpmProtectDataTestTeardown),
+        cmocka_unit_test_setup_teardown(cominitTpmProtectDataTestBadLengthFailure, cominitTpmProtectDataTestSetup,
+                                        cominitTpmProtectDataTestTeardown),
+        cmocka_unit_test_setup_teardown(cominitTpmProtectDataTestLegacyMkdirFailure, cominitTpmProtectDataTestSetup,
+                                        cominitTpmProtectDataTestTeardown),
+        cmocka_unit_test_setup_teardown(cominitTpmProtectDataTestNoDeviceFailure, cominitTpmProtectDataTestSetup,
+                                        cominitTpmProtectDataTestTeardown),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-protect-data.h
+ * @brief Header declaring cmocka unit test functions for cominitTpmProtectData().
+ */
+#ifndef __UTEST_TPM_PROTECT_DATA_H__
+#define __UTEST_TPM_PROTECT_DATA_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <tss2/tss2_esys.h>
+
+#include "common.h"
+#include "tpm.h"
+
+/** Size of the temporary file standing in for the blob partition. **/
+#define UTEST_TPM_BLOB_DEVICE_SIZE (2 * COMINIT_TPM_BLOB_SIZE_MAX)
+/** Device node given for the secure storage partition, never accessed by the tests. **/
+#define UTEST_TPM_CRYPT_DEVICE "/dev/utest-crypt"
+
+/**
+ * State of a cominitTpmProtectData() test.
+ */
+typedef struct {
+    cominitCliArgs_t argCtx;     ///< The options with cominitCliArgs_t::devNodeBlob set to the temporary file.
+    cominitTpmContext_t tpmCtx;  ///< The TPM context with a dummy ESYS context.
+} cominitTpmProtectDataTest_t;
+
+/**
+ * Creates a zero-filled temporary file standing in for the blob partition.
+ * @param state  Receives a pointer to the cominitTpmProtectDataTest_t of the test.
+ * @return  0 on success
+ */
+int cominitTpmProtectDataTestSetup(void **state);
+/**
+ * Removes the file created by cominitTpmProtectDataTestSetup().
+ * @param state
+ * @return  0 on success
+ */
+int cominitTpmProtectDataTestTeardown(void **state);
+/**
+ * Writes to the start of the blob partition.
+ * @param test  The state of the test.
+ * @param data  The data to write.
+ * @param len   The length of the data.
+ */
+void cominitTpmProtectDataTestWriteBlob(const cominitTpmProtectDataTest_t *test, const void *data, size_t len);
+/**
+ * Checks that the start of the blob partition still holds the given data.
+ * @param test  The state of the test.
+ * @param data  The data expected.
+ * @param len   The length of the data.
+ */
+void cominitTpmProtectDataTestAssertBlob(const cominitTpmProtectDataTest_t *test, const void *data, size_t len);
+/**
+ * Builds a raw blob as cominit writes it to the blob partition.
+ * @param buf         Buffer of #COMINIT_TPM_BLOB_SIZE_MAX Bytes that receives the raw blob.
+ * @param outPublic   The public part of the sealed object.
+ * @param outPrivate  The private part of the sealed object.
+ * @return  The length of the raw blob
+ */
+size_t cominitTpmProtectDataTestRawBlob(uint8_t *buf, const TPM2B_PUBLIC *outPublic, const TPM2B_PRIVATE *outPrivate);
+
+/**
+ * Unit test for cominitTpmProtectData() sealing on a zeroed blob partition.
+ * @param state
+ */
+void cominitTpmProtectDataTestZeroedSuccess(void **state);
+/**
+ * Unit test for cominitTpmProtectData() sealing on an erased flash blob partition.
+ * @param state
+ */
+void cominitTpmProtectDataTestErasedFlashSuccess(void **state);
+/**
+ * Unit test for cominitTpmProtectData() loading a raw blob into the TPM unchanged.
+ * @param state
+ */
+void cominitTpmProtectDataTestRawBlobSuccess(void **state);
+/**
+ * Unit test that simulates a blob partition with unrecognized content, which must not be overwritten.
+ * @param state
+ */
+void cominitTpmProtectDataTestUnrecognizedFailure(void **state);
+/**
+ * Unit test that simulates a raw blob with a wrong CRC32.
+ * @param state
+ */
+void cominitTpmProtectDataTestBadCrcFailure(void **state);
+/**
+ * Unit test that simulates a raw blob with a length exceeding the blob.
+ * @param state
+ */
+void cominitTpmProtectDataTestBadLengthFailure(void **state);
+/**
+ * Unit test that simulates a legacy ext4 blob partition that cannot be mounted.
+ * @param state
+ */
+void cominitTpmProtectDataTestLegacyMkdirFailure(void **state);
+/**
+ * Unit test that simulates a missing blob partition.
+ * @param state
+ */
+void cominitTpmProtectDataTestNoDeviceFailure(void **state);
+
+#endif /* __UTEST_TPM_PROTECT_DATA_H__ */
@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-uevent-is-block-device-add-failure.c
+ * @brief Implementation of several failure case unit tests for cominitUeventIsBlockDeviceAdd().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+
+#include "common.h"
+#include "unit_test.h"
+#include "utest-uevent-is-block-device-add.h"
+
+void cominitUeventIsBlockDeviceAddTestFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    const char ttyAdd[] = "add@/devices/virtual/tty/tty1\0ACTION=add\0SUBSYSTEM=tty\0DEVNAME=tty1\0";
+    const char blockChange[] = "change@/devices/virtual/block/sda\0ACTION=change\0SUBSYSTEM=block\0DEVNAME=sda\0";
+    const char blockRemove[] = "remove@/devices/virtual/block/sda\0ACTION=remove\0SUBSYSTEM=block\0DEVNAME=sda\0";
+    const char fromUdev[] = "libudev\0ACTION=add\0SUBSYSTEM=block\0DEVNAME=sda\0";
+    const char noEnvironment[] = "add@/devices/virtual/block/sda";
+    const char truncated[] = "add@/devices/virtual/block/sda\0ACTION=add\0SUBSYSTEM=blo";
+
+    assert_false(cominitUeventIsBlockDeviceAdd(ttyAdd, sizeof(ttyAdd)));
+    assert_false(cominitUeventIsBlockDeviceAdd(blockChange, sizeof(blockChange)));
+    assert_false(cominitUeventIsBlockDeviceAdd(blockRemove, sizeof(blockRemove)));
+    assert_false(cominitUeventIsBlockDeviceAdd(fromUdev, sizeof(fromUdev)));
+    assert_false(cominitUeventIsBlockDeviceAdd(noEnvironment, sizeof(noEnvironment)));
+    assert_false(cominitUeventIsBlockDeviceAdd(truncated, sizeof(truncated) - 1));
+    assert_false(cominitUeventIsBlockDeviceAdd(NULL, sizeof(ttyAdd)));
+    assert_false(cominitUeventIsBlockDeviceAdd(ttyAdd, 0));
+}
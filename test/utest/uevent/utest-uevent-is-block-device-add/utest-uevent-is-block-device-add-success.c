@@ -0,0 +1,26 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-uevent-is-block-device-add-success.c
+ * @brief Implementation of a success case unit test for cominitUeventIsBlockDeviceAdd().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+
+#include "common.h"
+#include "unit_test.h"
+#include "utest-uevent-is-block-device-add.h"
+
+void cominitUeventIsBlockDeviceAddTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    const char diskAdd[] =
+        "add@/devices/platform/emmc2bus/fe340000.mmc/mmc_host/mmc0/mmc0:aaaa/block/mmcblk0\0"
+        "ACTION=add\0DEVPATH=/devices/platform/emmc2bus/fe340000.mmc/mmc_host/mmc0/mmc0:aaaa/block/mmcblk0\0"
+        "SUBSYSTEM=block\0MAJOR=179\0MINOR=0\0DEVNAME=mmcblk0\0DEVTYPE=disk\0SEQNUM=1042";
+    const char partitionAdd[] =
+        "add@/devices/pci0000:00/0000:00:1f.2/ata1/host0/target0:0:0/0:0:0:0/block/sda/sda2\0"
+        "ACTION=add\0DEVPATH=/devices/pci0000:00/0000:00:1f.2/ata1/host0/target0:0:0/0:0:0:0/block/sda/sda2\0"
+        "SUBSYSTEM=block\0MAJOR=8\0MINOR=2\0DEVNAME=sda2\0DEVTYPE=partition\0PARTN=2\0SEQNUM=1337\0";
+
+    assert_true(cominitUeventIsBlockDeviceAdd(diskAdd, sizeof(diskAdd) - 1));
+    assert_true(cominitUeventIsBlockDeviceAdd(partitionAdd, sizeof(partitionAdd)));
+}
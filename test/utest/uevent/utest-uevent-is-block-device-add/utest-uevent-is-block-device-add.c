@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-uevent-is-block-device-add.c
+ * @brief Implementation of an cominitUeventIsBlockDeviceAdd() unit test group using cmocka.
+ */
+#include "utest-uevent-is-block-device-add.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitUeventIsBlockDeviceAdd().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitUeventIsBlockDeviceAddTestSuccess),
+        cmocka_unit_test(cominitUeventIsBlockDeviceAddTestFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-uevent-is-block-device-add.h
+ * @brief Header declaring cmocka unit test functions for cominitUeventIsBlockDeviceAdd().
+ */
+#ifndef __UTEST_UEVENT_IS_BLOCK_DEVICE_ADD_H__
+#define __UTEST_UEVENT_IS_BLOCK_DEVICE_ADD_H__
+
+#include "uevent.h"
+
+/**
+ * Unit test for cominitUeventIsBlockDeviceAdd() successful code path.
+ * @param state
+ */
+void cominitUeventIsBlockDeviceAddTestSuccess(void **state);
+
+/**
+ * Unit test that simulates uevents not announcing a new block device and malformed messages.
+ * @param state
+ */
+void cominitUeventIsBlockDeviceAddTestFailure(void **state);
+
+#endif /* __UTEST_UEVENT_IS_BLOCK_DEVICE_ADD_H__ */
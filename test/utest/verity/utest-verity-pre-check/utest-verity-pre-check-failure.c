@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-verity-pre-check-failure.c
+ * @brief Implementation of failure case unit tests for cominitVerityPreCheck().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <string.h>
+
+#include "unit_test.h"
+#include "utest-verity-pre-check.h"
+#include "verity.h"
+
+void cominitVerityPreCheckTestCorruptedDataFailure(void **state) {
+    cominitRfsMetaData_t *meta = *state;
+
+    /* ext4 superblock */
+    cominitVerityPreCheckTestCorrupt(meta, 1024 + 56);
+    assert_int_equal(cominitVerityPreCheck(meta, 0), -1);
+}
+
+void cominitVerityPreCheckTestCorruptedHashFailure(void **state) {
+    cominitRfsMetaData_t *meta = *state;
+
+    /* second hash block of level 0, only reached if level 0 is checked completely */
+    cominitVerityPreCheckTestCorrupt(meta, (UTEST_VERITY_DATA_BLOCKS + 2) * UTEST_VERITY_BLOCK_SIZE + 32);
+    assert_int_equal(cominitVerityPreCheck(meta, 1), 0);
+    assert_int_equal(cominitVerityPreCheck(meta, 2), -1);
+
+    /* top level block */
+    cominitVerityPreCheckTestCorrupt(meta, UTEST_VERITY_DATA_BLOCKS * UTEST_VERITY_BLOCK_SIZE + 64);
+    assert_int_equal(cominitVerityPreCheck(meta, 0), -1);
+}
+
+void cominitVerityPreCheckTestParamFailure(void **state) {
+    cominitRfsMetaData_t *meta = *state;
+    char table[COMINIT_DM_TABLE_SIZE_MAX];
+    char path[COMINIT_ROOTFS_DEV_PATH_MAX];
+
+    assert_int_equal(cominitVerityPreCheck(NULL, 0), -1);
+
+    meta->crypt = COMINIT_CRYPTOPT_INTEGRITY;
+    assert_int_equal(cominitVerityPreCheck(meta, 0), -1);
+    meta->crypt = COMINIT_CRYPTOPT_VERITY;
+
+    strcpy(table, meta->dmTableVerint);
+    *strstr(meta->dmTableVerint, " sha256") = '\0';
+    assert_int_equal(cominitVerityPreCheck(meta, 0), -1);
+
+    strcpy(meta->dmTableVerint, table);
+    *strstr(meta->dmTableVerint, UTEST_VERITY_SALT) = 'x';
+    assert_int_equal(cominitVerityPreCheck(meta, 0), -1);
+
+    strcpy(meta->dmTableVerint, table);
+    *strstr(meta->dmTableVerint, " 512 ") = '\0';
+    strcat(meta->dmTableVerint, " 500 512 40 40 sha256 " UTEST_VERITY_ROOT_DIGEST " " UTEST_VERITY_SALT);
+    assert_int_equal(cominitVerityPreCheck(meta, 0), -1);
+
+    strcpy(meta->dmTableVerint, table);
+    strcpy(path, meta->devicePath);
+    strcpy(meta->devicePath, "/nonexistent/utest-verity");
+    assert_int_equal(cominitVerityPreCheck(meta, 0), -1);
+    strcpy(meta->devicePath, path);
+}
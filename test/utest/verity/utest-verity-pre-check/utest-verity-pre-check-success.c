@@ -0,0 +1,41 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-verity-pre-check-success.c
+ * @brief Implementation of success case unit tests for cominitVerityPreCheck().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <string.h>
+
+#include "unit_test.h"
+#include "utest-verity-pre-check.h"
+#include "verity.h"
+
+void cominitVerityPreCheckTestSuccess(void **state) {
+    cominitRfsMetaData_t *meta = *state;
+
+    assert_int_equal(cominitVerityPreCheck(meta, 0), 0);
+    assert_int_equal(cominitVerityPreCheck(meta, COMINIT_VERITY_CHECK_LEVELS_DEFAULT), 0);
+    assert_int_equal(cominitVerityPreCheck(meta, 100), 0);
+}
+
+void cominitVerityPreCheckTestUncheckedBlockSuccess(void **state) {
+    cominitRfsMetaData_t *meta = *state;
+
+    /* the last data block is neither part of the superblock area nor of a completely checked level */
+    cominitVerityPreCheckTestCorrupt(meta, (UTEST_VERITY_DATA_BLOCKS - 1) * UTEST_VERITY_BLOCK_SIZE);
+    assert_int_equal(cominitVerityPreCheck(meta, 100), 0);
+
+    /* the last hash block of level 0 only holds digests of data blocks after the superblock area */
+    cominitVerityPreCheckTestCorrupt(meta, (UTEST_VERITY_DATA_BLOCKS + 3) * UTEST_VERITY_BLOCK_SIZE);
+    assert_int_equal(cominitVerityPreCheck(meta, 1), 0);
+}
+
+void cominitVerityPreCheckTestUnsupportedAlgSuccess(void **state) {
+    cominitRfsMetaData_t *meta = *state;
+    char *alg = strstr(meta->dmTableVerint, "sha256");
+
+    assert_non_null(alg);
+    memcpy(alg, "sha512", 6);
+    cominitVerityPreCheckTestCorrupt(meta, 0);
+    assert_int_equal(cominitVerityPreCheck(meta, 100), 0);
+}
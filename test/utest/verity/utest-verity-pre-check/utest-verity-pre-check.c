@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-verity-pre-check.c
+ * @brief Implementation of an cominitVerityPreCheck() unit test group using cmocka.
+ */
+#include "utest-verity-pre-check.h"
+
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "sha256.h"
+#include "unit_test.h"
+
+/**
+ * Computes the digest of a block like dm-verity version 1 does.
+ */
+static void cominitVerityPreCheckTestHash(const uint8_t *block, uint8_t *digest) {
+    const uint8_t salt[] = {0x00, 0x11, 0x22, 0x33};
+    cominitSha256Context_t ctx;
+    cominitSha256Init(&ctx);
+    cominitSha256Update(&ctx, salt, sizeof(salt));
+    cominitSha256Update(&ctx, block, UTEST_VERITY_BLOCK_SIZE);
+    cominitSha256Final(&ctx, digest);
+}
+
+int cominitVerityPreCheckTestSetup(void **state) {
+    const size_t perBlock = UTEST_VERITY_BLOCK_SIZE / COMINIT_SHA256_DIGEST_LEN;
+    const size_t level0Blocks = (UTEST_VERITY_DATA_BLOCKS + perBlock - 1) / perBlock;
+    uint8_t data[UTEST_VERITY_DATA_BLOCKS][UTEST_VERITY_BLOCK_SIZE];
+    uint8_t level0[3][UTEST_VERITY_BLOCK_SIZE] = {{0}};
+    uint8_t level1[UTEST_VERITY_BLOCK_SIZE] = {0};
+    uint8_t root[COMINIT_SHA256_DIGEST_LEN];
+    char rootHex[2 * COMINIT_SHA256_DIGEST_LEN + 1];
+    char path[] = "/tmp/utest-verity-XXXXXX";
+
+    assert_int_equal(level0Blocks, 3);
+    for (size_t b = 0; b < UTEST_VERITY_DATA_BLOCKS; b++) {
+        for (size_t i = 0; i < UTEST_VERITY_BLOCK_SIZE; i++) {
+            data[b][i] = (uint8_t)(b * 7 + i);
+        }
+        cominitVerityPreCheckTestHash(data[b], &level0[b / perBlock][(b % perBlock) * COMINIT_SHA256_DIGEST_LEN]);
+    }
+    for (size_t b = 0; b < level0Blocks; b++) {
+        cominitVerityPreCheckTestHash(level0[b], &level1[b * COMINIT_SHA256_DIGEST_LEN]);
+    }
+    cominitVerityPreCheckTestHash(level1, root);
+    for (size_t i = 0; i < sizeof(root); i++) {
+        sprintf(&rootHex[2 * i], "%02x", root[i]);
+    }
+    assert_string_equal(rootHex, UTEST_VERITY_ROOT_DIGEST);
+
+    /* data blocks followed by the hash tree with the top level first */
+    int fd = mkstemp(path);
+    assert_int_not_equal(fd, -1);
+    assert_int_equal(write(fd, data, sizeof(data)), sizeof(data));
+    assert_int_equal(write(fd, level1, sizeof(level1)), sizeof(level1));
+    assert_int_equal(write(fd, level0, sizeof(level0)), sizeof(level0));
+    close(fd);
+
+    cominitRfsMetaData_t *meta = calloc(1, sizeof(*meta));
+    assert_non_null(meta);
+    strcpy(meta->devicePath, path);
+    meta->crypt = COMINIT_CRYPTOPT_VERITY;
+    meta->deviceFd = -1;
+    snprintf(meta->dmTableVerint, sizeof(meta->dmTableVerint), "1 %s %s %d %d %d %d sha256 %s %s", path, path,
+             UTEST_VERITY_BLOCK_SIZE, UTEST_VERITY_BLOCK_SIZE, UTEST_VERITY_DATA_BLOCKS, UTEST_VERITY_DATA_BLOCKS,
+             rootHex, UTEST_VERITY_SALT);
+    *state = meta;
+    return 0;
+}
+
+int cominitVerityPreCheckTestTeardown(void **state) {
+    cominitRfsMetaData_t *meta = *state;
+    unlink(meta->devicePath);
+    free(meta);
+    return 0;
+}
+
+void cominitVerityPreCheckTestCorrupt(const cominitRfsMetaData_t *meta, off_t offset) {
+    uint8_t byte = 0;
+    int fd = open(meta->devicePath, O_RDWR);
+    assert_int_not_equal(fd, -1);
+    assert_int_equal(pread(fd, &byte, 1, offset), 1);
+    byte ^= 0x01;
+    assert_int_equal(pwrite(fd, &byte, 1, offset), 1);
+    close(fd);
+}
+
+/**
+ * Run the unit tests for cominitVerityPreCheck().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(cominitVerityPreCheckTestSuccess, cominitVerityPreCheckTestSetup,
+                                        cominitVerityPreCheckTestTeardown),
+        cmocka_unit_test_setup_teardown(cominitVerityPreCheckTestUncheckedBlockSuccess, cominitVerityPreCheckTestSetup,
+                                        cominitVerityPreCheckTestTeardown),
+        cmocka_unit_test_setup_teardown(cominitVerityPreCheckTestUnsupportedAlgSuccess, cominitVerityPreCheckTestSetup,
+                                        cominitVerityPreCheckTestTeardown),
+        cmocka_unit_test_setup_teardown(cominitVerityPreCheckTestCorruptedDataFailure, cominitVerityPreCheckTestSetup,
+                                        cominitVerityPreCheckTestTeardown),
+        cmocka_unit_test_setup_teardown(cominitVerityPreCheckTestCorruptedHashFailure, cominitVerityPreCheckTestSetup,
+                                        cominitVerityPreCheckTestTeardown),
+        cmocka_unit_test_setup_teardown(cominitVerityPreCheckTestParamFailure, cominitVerityPreCheckTestSetup,
+                                        cominitVerityPreCheckTestTeardown),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-verity-pre-check.h
+ * @brief Header declaring cmocka unit test functions for cominitVerityPreCheck().
+ */
+#ifndef __UTEST_VERITY_PRE_CHECK_H__
+#define __UTEST_VERITY_PRE_CHECK_H__
+
+#include <sys/types.h>
+
+#include "meta.h"
+
+/** Size of the data and hash blocks of the test image. **/
+#define UTEST_VERITY_BLOCK_SIZE 512
+/** Number of data blocks of the test image, giving 3 hash blocks at level 0 and 1 at level 1 of the hash tree. **/
+#define UTEST_VERITY_DATA_BLOCKS 40
+/** Salt used for the test image. **/
+#define UTEST_VERITY_SALT "00112233"
+/** Root digest of the test image, computed independently. **/
+#define UTEST_VERITY_ROOT_DIGEST "7b16b7bcadff2911850953dd9f27bf94c7f26d03a8b276c79cae91c7fcaa2cca"
+
+/**
+ * Creates a temporary image with a dm-verity hash tree appended to the data blocks and the matching metadata.
+ * @param state  Receives a pointer to the cominitRfsMetaData_t of the image.
+ * @return  0 on success
+ */
+int cominitVerityPreCheckTestSetup(void **state);
+/**
+ * Removes the image created by cominitVerityPreCheckTestSetup().
+ * @param state
+ * @return  0 on success
+ */
+int cominitVerityPreCheckTestTeardown(void **state);
+/**
+ * Flips a bit of the image created by cominitVerityPreCheckTestSetup().
+ * @param meta    The metadata of the image.
+ * @param offset  Offset of the Byte to change.
+ */
+void cominitVerityPreCheckTestCorrupt(const cominitRfsMetaData_t *meta, off_t offset);
+
+/**
+ * Unit test for cominitVerityPreCheck() successful code path.
+ * @param state
+ */
+void cominitVerityPreCheckTestSuccess(void **state);
+/**
+ * Unit test for cominitVerityPreCheck() ignoring corrupted blocks outside of the checked parts.
+ * @param state
+ */
+void cominitVerityPreCheckTestUncheckedBlockSuccess(void **state);
+/**
+ * Unit test for cominitVerityPreCheck() skipping hash algorithms other than sha256.
+ * @param state
+ */
+void cominitVerityPreCheckTestUnsupportedAlgSuccess(void **state);
+/**
+ * Unit test for cominitVerityPreCheck() with a corrupted superblock area.
+ * @param state
+ */
+void cominitVerityPreCheckTestCorruptedDataFailure(void **state);
+/**
+ * Unit test for cominitVerityPreCheck() with a corrupted hash block.
+ * @param state
+ */
+void cominitVerityPreCheckTestCorruptedHashFailure(void **state);
+/**
+ * Unit test for cominitVerityPreCheck() with invalid parameters and tables.
+ * @param state
+ */
+void cominitVerityPreCheckTestParamFailure(void **state);
+
+#endif /* __UTEST_VERITY_PRE_CHECK_H__ */